@@ -5,10 +5,19 @@
     #define ERA_NETWORK_TYPE          "Socket"
 #endif
 
+#if !defined(ERA_RUN_SLEEP_MAX_MS)
+    #define ERA_RUN_SLEEP_MAX_MS      1000UL
+#endif
+
 #include <ERa/ERaProtocol.hpp>
 #include <MQTT/ERaMqttLinux.hpp>
 #include <Storage/ERaFlashLinux.hpp>
 
+#if defined(ERA_JOURNAL)
+    #include <Utility/ERaTimeLinux.hpp>
+    #include <Storage/ERaLoggerLinux.hpp>
+#endif
+
 template <class Transport>
 class ERaLinux
     : public ERaProto<Transport, ERaFlashLinux>
@@ -19,6 +28,10 @@ class ERaLinux
 public:
     ERaLinux(Transport& _transp, ERaFlashLinux& _flash)
         : Base(_transp, _flash)
+        , runSleep(false)
+#if defined(ERA_JOURNAL)
+        , journal(journalTime)
+#endif
     {}
     ~ERaLinux()
     {}
@@ -38,6 +51,9 @@ public:
                 const char* username,
                 const char* password) {
         Base::init();
+#if defined(ERA_JOURNAL)
+        this->setERaLogger(this->journal);
+#endif
         this->config(auth, host, port, username, password);
     }
 
@@ -72,6 +88,7 @@ public:
                 break;
             case StateT::STATE_RUNNING:
                 Base::run();
+                this->sleep();
                 break;
             default:
                 ERaState::set(StateT::STATE_CONNECTING_CLOUD);
@@ -79,12 +96,37 @@ public:
         }
     }
 
+    /* Block in run() until the next deadline or incoming data instead of spinning */
+    void setRunSleep(bool enable) {
+        this->runSleep = enable;
+    }
+
 protected:
 private:
+    void sleep() {
+#if !defined(ERA_NO_RTOS)
+        if (!this->runSleep) {
+            return;
+        }
+        if (!ERaState::is(StateT::STATE_RUNNING)) {
+            return;
+        }
+        unsigned long timeout = Base::getNextTimeout(ERA_RUN_SLEEP_MAX_MS);
+        timeout = this->getTransp().getNextTimeout(timeout);
+        this->getTransp().waitEvents(timeout);
+#endif
+    }
+
     void networkInfo() {
         GetNetworkInfo();
         this->getTransp().setSSID(GetSSIDNetwork());
     }
+
+    bool runSleep;
+#if defined(ERA_JOURNAL)
+    ERaTimeLinux journalTime;
+    ERaLoggerLinux journal;
+#endif
 };
 
 template <class Proto, class Flash>
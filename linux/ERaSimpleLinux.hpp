@@ -1,6 +1,9 @@
 #ifndef INC_ERA_SIMPLE_LINUX_HPP_
 #define INC_ERA_SIMPLE_LINUX_HPP_
 
+/* Before ERaApi, it provides ERA_EVENT_NOTIFY */
+#include <Utility/ERaPollLinux.hpp>
+
 #if defined(LINUX) &&        \
     (defined(RASPBERRY) ||   \
     defined(TINKER_BOARD) || \
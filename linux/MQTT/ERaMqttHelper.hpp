@@ -12,7 +12,13 @@ protected:
     };
 
 public:
+    /* Accepted by publishData but never acknowledged by the broker */
+    typedef void (*UndeliveredCallback_t)(void* args, const char* topic,
+                                        const char* payload);
+
     ERaMqttHelper()
+        : undeliveredCb(nullptr)
+        , undeliveredArgs(nullptr)
     {}
     virtual ~ERaMqttHelper()
     {}
@@ -24,7 +30,22 @@ public:
                             bool retained = ERA_MQTT_PUBLISH_RETAINED,
                             QoST qos = (QoST)ERA_MQTT_PUBLISH_QOS) = 0;
 
+    void onUndelivered(UndeliveredCallback_t cb, void* args) {
+        this->undeliveredCb = cb;
+        this->undeliveredArgs = args;
+    }
+
+protected:
+    void undelivered(const char* topic, const char* payload) {
+        if (this->undeliveredCb == nullptr) {
+            return;
+        }
+        this->undeliveredCb(this->undeliveredArgs, topic, payload);
+    }
+
 private:
+    UndeliveredCallback_t undeliveredCb;
+    void* undeliveredArgs;
 };
 
 #endif /* INC_ERA_MQTT_HELPER_HPP_ */
@@ -1,6 +1,7 @@
 #ifndef INC_ERA_MQTT_LINUX_HPP_
 #define INC_ERA_MQTT_LINUX_HPP_
 
+#include <Utility/ERaPollLinux.hpp>
 #include <Utility/ERaUtility.hpp>
 #include <Utility/ERacJSON.hpp>
 #include <ERa/ERaDefine.hpp>
@@ -76,8 +77,6 @@ public:
         , ERaTopic(ERA_MQTT_BASE_TOPIC)
         , ERaAuth(ERA_AUTHENTICATION_TOKEN)
         , ssid(NULL)
-        , ping(0L)
-        , lastPublish(0L)
         , signalQuality(0)
         , askConfig(false)
         , needPubState(false)
@@ -88,6 +87,9 @@ public:
         , disconnectedCb(NULL)
     {
         this->mqtt.setKeepAlive(ERA_MQTT_KEEP_ALIVE);
+        this->mqtt.setInflightWindow(ERA_MQTT_INFLIGHT_WINDOW);
+        this->mqtt.ref = this;
+        this->mqtt.onPublished(ERaMqttLinux::publishHandler);
         memset(this->willTopic, 0, sizeof(this->willTopic));
     }
     ~ERaMqttLinux()
@@ -117,6 +119,8 @@ public:
                     QoST qos = (QoST)ERA_MQTT_PUBLISH_QOS) override;
     bool publishState(bool online);
     bool syncConfig();
+    unsigned long getNextTimeout(unsigned long maxDelay);
+    bool waitEvents(unsigned long timeout);
 
     void setTimeout(uint32_t timeout) {
         this->mqtt.setTimeout(timeout);
@@ -130,6 +134,10 @@ public:
         this->mqtt.setKeepAlive(keepAlive);
     }
 
+    void setInflightWindow(size_t window) {
+        this->mqtt.setInflightWindow(window);
+    }
+
     void setClientID(const char* id) {
         this->clientID = id;
     }
@@ -161,8 +169,9 @@ public:
         return this->ssid;
     }
 
-    MillisTime_t getPing() const {
-        return this->ping;
+    /* Round trip of the last acknowledged publish */
+    MillisTime_t getPing() {
+        return this->mqtt.roundTrip();
     }
 
     void setSignalQuality(int16_t signal) {
@@ -220,6 +229,8 @@ private:
     void onDisconnected();
     void lockMQTT();
     void unlockMQTT();
+    static void publishHandler(MQTT* client, uint16_t packetID, bool success,
+                            const char topic[], const char payload[], int length);
 
     MQTT mqtt;
     const char* host;
@@ -230,8 +241,6 @@ private:
     const char* ERaTopic;
     const char* ERaAuth;
     const char* ssid;
-    MillisTime_t ping;
-    MillisTime_t lastPublish;
     int16_t signalQuality;
     bool askConfig;
     bool needPubState;
@@ -350,6 +359,29 @@ bool ERaMqttLinux<MQTT>::run() {
     return true;
 }
 
+template <class MQTT>
+inline
+unsigned long ERaMqttLinux<MQTT>::getNextTimeout(unsigned long maxDelay) {
+    if (!this->_connected || this->needPubState) {
+        return 0;
+    }
+    return ERaMin(maxDelay, (unsigned long)this->mqtt.getKeepAliveTimeout());
+}
+
+template <class MQTT>
+inline
+bool ERaMqttLinux<MQTT>::waitEvents(unsigned long timeout) {
+    if (!timeout) {
+        return false;
+    }
+    ERaPollLinux& poll = ERaPollLinux::instance();
+    /* The socket changes on reconnect, closed ones leave the set by themselves */
+    if (!poll.watch(this->mqtt.getSocket())) {
+        return false;
+    }
+    return (poll.wait(timeout) > 0);
+}
+
 template <class MQTT>
 inline
 bool ERaMqttLinux<MQTT>::subscribeTopic(const char* baseTopic, const char* topic,
@@ -407,9 +439,7 @@ bool ERaMqttLinux<MQTT>::publishData(const char* topic, const char* payload,
 
     this->lockMQTT();
     if (this->connected()) {
-        this->lastPublish = ERaMillis();
         status = this->mqtt.publish(topic, payload, retained, qos);
-        this->ping = (ERaMillis() - this->lastPublish);
         ERA_MQTT_PUB_LOG(status, this->mqtt.lastError())
     }
     this->unlockMQTT();
@@ -461,9 +491,7 @@ bool ERaMqttLinux<MQTT>::publishLWT(bool sync) {
 
     this->lockMQTT();
     if (this->connected()) {
-        this->lastPublish = ERaMillis();
         status = this->mqtt.publish(topic, payload, LWT_RETAINED, LWT_QOS);
-        this->ping = (ERaMillis() - this->lastPublish);
         ERA_MQTT_PUB_LOG(status, this->mqtt.lastError())
     }
     this->unlockMQTT();
@@ -471,6 +499,24 @@ bool ERaMqttLinux<MQTT>::publishLWT(bool sync) {
     return status;
 }
 
+template <class MQTT>
+inline
+void ERaMqttLinux<MQTT>::publishHandler(MQTT* client, uint16_t packetID, bool success,
+                                        const char topic[], const char payload[], int length) {
+    ERA_FORCE_UNUSED(length);
+    ERaMqttLinux* self = (ERaMqttLinux*)client->ref;
+    if ((self == NULL) || success) {
+        return;
+    }
+
+    ERA_LOG_ERROR(self->TAG, ERA_PSTR("Publish (given up #%d) %s: %s"), packetID, topic, payload);
+    /* A stale online state is not worth replaying */
+    if (ERaStrCmp(topic, self->willTopic)) {
+        return;
+    }
+    self->undelivered(topic, payload);
+}
+
 template <class MQTT>
 inline
 void ERaMqttLinux<MQTT>::onConnected() {
@@ -3,6 +3,11 @@
 #include <stdlib.h>
 #include "MQTTLinux.hpp"
 #include <ERa/ERaDefine.hpp>
+#include <Utility/ERaUtility.hpp>
+
+#if defined(ERA_MQTT_SSL) && defined(ERA_MQTT_TLS_SESSION_FILE)
+  #include <Storage/ERaFlashLinux.hpp>
+#endif
 
 inline char* lwmqtt_strdup(const char* str) {
   if (str == nullptr) {
@@ -91,6 +96,15 @@ MQTTLinuxClient::~MQTTLinuxClient() {
     free((void *)this->hostname);
   }
 
+  // free unacknowledged messages
+  this->clearInflight();
+  free(this->inflight);
+
+  // free kept TLS state
+#if defined(ERA_MQTT_SSL)
+  lwmqtt_unix_tls_network_free(&this->networkTLS);
+#endif
+
   // free buffers
   free(this->readBuf);
   free(this->writeBuf);
@@ -104,6 +118,7 @@ void MQTTLinuxClient::begin() {
 #if defined(ERA_MQTT_SSL)
   if (this->isTLS) {
     lwmqtt_unix_tls_network_init(&this->networkTLS, false, nullptr, 0);
+    this->loadTLSSession();
   }
 #endif
 
@@ -133,6 +148,7 @@ void MQTTLinuxClient::begin() {
 
   // set callback
   lwmqtt_set_callback(&this->client, (void *)&this->callback, MQTTLinuxClientHandler);
+  lwmqtt_set_ack_callback(&this->client, (void *)this, MQTTLinuxClient::ackHandler);
 }
 
 void MQTTLinuxClient::init(int readBufSize, int writeBufSize) {
@@ -278,6 +294,36 @@ void MQTTLinuxClient::setCleanSession(bool _cleanSession) { this->cleanSession =
 
 void MQTTLinuxClient::setTimeout(int _timeout) { this->timeout = _timeout; }
 
+void MQTTLinuxClient::setInflightWindow(size_t window) {
+  pthread_mutex_lock(&this->inflightMutex);
+
+  // keep the window while messages are pending
+  if (this->inflightCount > 0) {
+    pthread_mutex_unlock(&this->inflightMutex);
+    return;
+  }
+
+  free(this->inflight);
+  this->inflight = nullptr;
+  this->inflightWindow = 0;
+
+  if (window > 0) {
+    this->inflight = (MQTTLinuxClientInflight *)ERA_CALLOC(window, sizeof(MQTTLinuxClientInflight));
+    if (this->inflight != nullptr) {
+      this->inflightWindow = window;
+    }
+  }
+
+  pthread_mutex_unlock(&this->inflightMutex);
+}
+
+size_t MQTTLinuxClient::pendingPublishes() {
+  pthread_mutex_lock(&this->inflightMutex);
+  size_t count = this->inflightCount;
+  pthread_mutex_unlock(&this->inflightMutex);
+  return count;
+}
+
 void MQTTLinuxClient::dropOverflow(bool enabled) {
   // configure drop overflow
   lwmqtt_drop_overflow(&this->client, enabled, &this->_droppedMessages);
@@ -308,6 +354,11 @@ bool MQTTLinuxClient::connect(const char clientID[], const char username[], cons
     if (this->_lastError != LWMQTT_SUCCESS) {
       return false;
     }
+#if defined(ERA_MQTT_SSL)
+    if (this->isTLS) {
+      this->saveTLSSession();
+    }
+#endif
   }
 
   // wait for connection
@@ -363,6 +414,9 @@ bool MQTTLinuxClient::connect(const char clientID[], const char username[], cons
   // set flag
   this->_connected = true;
 
+  // send again what was not acknowledged before the connection was lost
+  this->resendInflight();
+
   return true;
 }
 
@@ -402,6 +456,20 @@ bool MQTTLinuxClient::publish(const char topic[], const char payload[], int leng
   message.retained = retained;
   message.qos = lwmqtt_qos_t(qos);
 
+  // hand over to the in-flight window
+  if ((this->inflightWindow > 0) && (message.qos != LWMQTT_QOS0) &&
+      (this->nextDupPacketID == 0)) {
+    // wait for a free slot, returns with the in-flight lock held
+    if (this->waitInflight()) {
+      return this->publishAsync(topic, message);
+    }
+
+    // window is full, send it untracked as before when acks are skipped anyway
+    if (!this->skipACK) {
+      return false;
+    }
+  }
+
   // prepare options
   lwmqtt_publish_options_t options = lwmqtt_default_publish_options;
 
@@ -412,6 +480,7 @@ bool MQTTLinuxClient::publish(const char topic[], const char payload[], int leng
   options.skip_ack = this->skipACK;
 
   // publish message
+  MillisTime_t sentMillis = ERaMillis();
   this->_lastError = lwmqtt_publish(&this->client, &options, lwmqtt_string(topic), message, this->timeout);
   if (this->_lastError != LWMQTT_SUCCESS) {
     // close connection
@@ -420,9 +489,243 @@ bool MQTTLinuxClient::publish(const char topic[], const char payload[], int leng
     return false;
   }
 
+  // the call waited for the ack
+  if ((message.qos != LWMQTT_QOS0) && !options.skip_ack) {
+    this->_roundTrip = (uint32_t)(ERaMillis() - sentMillis);
+  }
+
   return true;
 }
 
+bool MQTTLinuxClient::publishAsync(const char topic[], lwmqtt_message_t message) {
+  // called with the in-flight lock held and a free slot
+  MQTTLinuxClientInflight *item = nullptr;
+  for (size_t i = 0; i < this->inflightWindow; ++i) {
+    if (this->inflight[i].topic == nullptr) {
+      item = &this->inflight[i];
+      break;
+    }
+  }
+
+  // keep a terminated copy to resend after a reconnect or hand back when given up
+  item->topic = lwmqtt_strdup(topic);
+  item->payload = (uint8_t *)ERA_MALLOC(message.payload_len + 1);
+  if ((item->topic == nullptr) || (item->payload == nullptr)) {
+    this->releaseInflight(*item);
+    pthread_mutex_unlock(&this->inflightMutex);
+    this->_lastError = LWMQTT_BUFFER_TOO_SHORT;
+    return false;
+  }
+  if (message.payload_len > 0) {
+    memcpy(item->payload, message.payload, message.payload_len);
+  }
+  item->payload[message.payload_len] = '\0';
+  item->length = message.payload_len;
+  item->retained = message.retained;
+  item->qos = message.qos;
+  item->retries = 0;
+  item->sentMillis = (uint32_t)ERaMillis();
+
+  // let lwmqtt assign the packet id and skip waiting for the ack
+  lwmqtt_publish_options_t options = lwmqtt_default_publish_options;
+  item->packetID = 0;
+  options.dup_id = &item->packetID;
+  options.skip_ack = true;
+
+  // the ack handler blocks on the lock until the slot is recorded
+  this->_lastError = lwmqtt_publish(&this->client, &options, lwmqtt_string(topic), message, this->timeout);
+  if (this->_lastError != LWMQTT_SUCCESS) {
+    this->releaseInflight(*item);
+    pthread_mutex_unlock(&this->inflightMutex);
+
+    // close connection
+    this->close();
+
+    return false;
+  }
+  this->inflightCount++;
+
+  pthread_mutex_unlock(&this->inflightMutex);
+
+  return true;
+}
+
+bool MQTTLinuxClient::waitInflight() {
+  MillisTime_t startMillis = ERaMillis();
+  bool isLoopThread = this->hasLoopThread && pthread_equal(this->loopThread, pthread_self());
+
+  for (;;) {
+    pthread_mutex_lock(&this->inflightMutex);
+    if (this->inflightCount < this->inflightWindow) {
+      return true;
+    }
+    pthread_mutex_unlock(&this->inflightMutex);
+
+    // acks are only read by loop(), the thread running it cannot wait for a slot
+    if (isLoopThread || !ERaRemainingTime(startMillis, this->timeout)) {
+      this->_lastError = LWMQTT_NETWORK_TIMEOUT;
+      return false;
+    }
+    ERaDelay(1);
+  }
+}
+
+void MQTTLinuxClient::resendInflight(bool expired) {
+  pthread_mutex_lock(&this->inflightMutex);
+  for (size_t i = 0; i < this->inflightWindow; ++i) {
+    MQTTLinuxClientInflight &item = this->inflight[i];
+    if (item.topic == nullptr) {
+      continue;
+    }
+
+    // only the ones still waiting for their ack after the timeout
+    if (expired && ((uint32_t)ERaMillis() - item.sentMillis < MQTT_INFLIGHT_ACK_TIMEOUT)) {
+      continue;
+    }
+
+    // give up on a message the broker never acknowledged
+    if (++item.retries > MQTT_INFLIGHT_MAX_RETRY) {
+      MQTTLinuxClientInflight given = item;
+      item = MQTTLinuxClientInflight();
+      this->inflightCount--;
+      pthread_mutex_unlock(&this->inflightMutex);
+      this->completeInflight(given, false);
+      pthread_mutex_lock(&this->inflightMutex);
+      continue;
+    }
+
+    lwmqtt_message_t message = lwmqtt_default_message;
+    message.payload = item.payload;
+    message.payload_len = item.length;
+    message.retained = item.retained;
+    message.qos = item.qos;
+
+    // same packet id with the dup flag
+    lwmqtt_publish_options_t options = lwmqtt_default_publish_options;
+    options.dup_id = &item.packetID;
+    options.skip_ack = true;
+
+    item.sentMillis = (uint32_t)ERaMillis();
+    this->_lastError = lwmqtt_publish(&this->client, &options, lwmqtt_string(item.topic), message, this->timeout);
+    if (this->_lastError != LWMQTT_SUCCESS) {
+      break;
+    }
+  }
+  pthread_mutex_unlock(&this->inflightMutex);
+}
+
+void MQTTLinuxClient::clearInflight() {
+  pthread_mutex_lock(&this->inflightMutex);
+  for (size_t i = 0; i < this->inflightWindow; ++i) {
+    this->releaseInflight(this->inflight[i]);
+  }
+  this->inflightCount = 0;
+  pthread_mutex_unlock(&this->inflightMutex);
+}
+
+#if defined(ERA_MQTT_SSL)
+
+#if defined(ERA_MQTT_TLS_SESSION_FILE)
+static uint32_t MQTTLinuxHash(const uint8_t *buf, size_t len) {
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= buf[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+#endif
+
+void MQTTLinuxClient::loadTLSSession() {
+#if defined(ERA_MQTT_TLS_SESSION_FILE)
+  uint8_t *buf = (uint8_t *)calloc(1, MQTT_TLS_SESSION_SIZE);
+  if (buf == nullptr) {
+    return;
+  }
+
+  // length prefixed, the file is usually shorter than the buffer
+  ERaFlashLinux flash;
+  uint32_t length = 0;
+  flash.readFlash(ERA_MQTT_TLS_SESSION_FILE, buf, MQTT_TLS_SESSION_SIZE);
+  memcpy(&length, buf, sizeof(length));
+  if (length && (length <= (MQTT_TLS_SESSION_SIZE - sizeof(length))) &&
+      lwmqtt_unix_tls_network_load_session(&this->networkTLS, buf + sizeof(length), length)) {
+    this->tlsSessionHash = MQTTLinuxHash(buf, length + sizeof(length));
+  }
+
+  free(buf);
+#endif
+}
+
+void MQTTLinuxClient::saveTLSSession() {
+#if defined(ERA_MQTT_TLS_SESSION_FILE)
+  uint8_t *buf = (uint8_t *)malloc(MQTT_TLS_SESSION_SIZE);
+  if (buf == nullptr) {
+    return;
+  }
+
+  // only write when the handshake gave a new session
+  uint32_t length = (uint32_t)lwmqtt_unix_tls_network_save_session(&this->networkTLS, buf + sizeof(length),
+                                                                    MQTT_TLS_SESSION_SIZE - sizeof(length));
+  memcpy(buf, &length, sizeof(length));
+  uint32_t hash = MQTTLinuxHash(buf, length + sizeof(length));
+  if (length && (hash != this->tlsSessionHash)) {
+    // holds the session master secret, private from the temp file on
+    ERaFlashLinux flash;
+    if (flash.writeFlash(ERA_MQTT_TLS_SESSION_FILE, buf, length + sizeof(length), S_IRUSR | S_IWUSR)) {
+      this->tlsSessionHash = hash;
+    }
+  }
+
+  free(buf);
+#endif
+}
+
+#endif
+
+void MQTTLinuxClient::releaseInflight(MQTTLinuxClientInflight &item) {
+  free(item.topic);
+  free(item.payload);
+  item = MQTTLinuxClientInflight();
+}
+
+void MQTTLinuxClient::completeInflight(MQTTLinuxClientInflight &item, bool success) {
+  // called without the lock, the callback may publish again
+  if (this->publishCallback != nullptr) {
+    this->publishCallback(this, item.packetID, success, item.topic, (const char *)item.payload, (int)item.length);
+  }
+  this->releaseInflight(item);
+}
+
+void MQTTLinuxClient::onAck(uint16_t packetID) {
+  MQTTLinuxClientInflight done;
+  bool found = false;
+
+  pthread_mutex_lock(&this->inflightMutex);
+  for (size_t i = 0; i < this->inflightWindow; ++i) {
+    MQTTLinuxClientInflight &item = this->inflight[i];
+    if ((item.topic != nullptr) && (item.packetID == packetID)) {
+      done = item;
+      item = MQTTLinuxClientInflight();
+      this->inflightCount--;
+      found = true;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&this->inflightMutex);
+
+  if (found) {
+    this->_roundTrip = (uint32_t)ERaMillis() - done.sentMillis;
+    this->completeInflight(done, true);
+  }
+}
+
+void MQTTLinuxClient::ackHandler(lwmqtt_client_t * /*client*/, void *ref, uint16_t packetID) {
+  // qos 2 completes with pubcomp, pubrec is handled by lwmqtt
+  ((MQTTLinuxClient *)ref)->onAck(packetID);
+}
+
 uint16_t MQTTLinuxClient::lastPacketID() {
   // get last packet id from client
   return this->client.last_packet_id;
@@ -513,6 +816,10 @@ bool MQTTLinuxClient::loop() {
     return false;
   }
 
+  // remember the thread that reads acks
+  this->loopThread = pthread_self();
+  this->hasLoopThread = true;
+
   // TODO Block until data is available
   bool isAvailable = false;
 #if defined(ERA_MQTT_SSL)
@@ -564,6 +871,17 @@ bool MQTTLinuxClient::loop() {
     }
   }
 
+  // resend publishes whose ack got lost
+  if (this->inflightCount > 0) {
+    this->resendInflight(true);
+    if (this->_lastError != LWMQTT_SUCCESS) {
+      // close connection
+      this->close();
+
+      return false;
+    }
+  }
+
   // keep the connection alive
   this->_lastError = lwmqtt_keep_alive(&this->client, this->timeout);
   if (this->_lastError != LWMQTT_SUCCESS) {
@@ -576,6 +894,25 @@ bool MQTTLinuxClient::loop() {
   return true;
 }
 
+int MQTTLinuxClient::getSocket() {
+#if defined(ERA_MQTT_SSL)
+  if (this->isTLS) {
+    return this->networkTLS.socket.fd;
+  }
+#endif
+  return this->network.socket;
+}
+
+uint32_t MQTTLinuxClient::getKeepAliveTimeout() {
+  // no keep alive configured
+  if (this->client.keep_alive_interval == 0) {
+    return UINT32_MAX;
+  }
+
+  int32_t remaining = this->client.timer_get(this->client.keep_alive_timer);
+  return (remaining > 0) ? (uint32_t)remaining : 0;
+}
+
 bool MQTTLinuxClient::connected() {
   // a client is connected if the network is connected and
   // the connection has been properly initiated
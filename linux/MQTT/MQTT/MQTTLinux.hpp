@@ -19,6 +19,7 @@
   #define MQTT_HAS_FUNCTIONAL   0
 #endif
 
+#include <pthread.h>
 #include "unix/unix.hpp"
 
 #if defined(ERA_MQTT_SSL)
@@ -39,6 +40,32 @@ typedef std::function<void(MQTTLinuxClient *client, char topic[], char bytes[],
     MQTTLinuxClientCallbackAdvancedFunction;
 #endif
 
+// completion of a windowed publish, success is false when it was given up unacknowledged
+typedef void (*MQTTLinuxClientCallbackPublish)(MQTTLinuxClient *client, uint16_t packetID, bool success,
+                                               const char topic[], const char payload[], int length);
+
+// resends of an unacknowledged publish before it is given up
+#define MQTT_INFLIGHT_MAX_RETRY 3
+
+// time to wait for the ack of a windowed publish before it is resent
+#if !defined(MQTT_INFLIGHT_ACK_TIMEOUT)
+  #define MQTT_INFLIGHT_ACK_TIMEOUT 10000
+#endif
+
+// largest TLS session kept in ERA_MQTT_TLS_SESSION_FILE, it holds the peer certificate
+#define MQTT_TLS_SESSION_SIZE 4096
+
+typedef struct {
+  uint16_t packetID = 0;
+  char *topic = nullptr;
+  uint8_t *payload = nullptr;
+  size_t length = 0;
+  bool retained = false;
+  lwmqtt_qos_t qos = LWMQTT_QOS0;
+  uint8_t retries = 0;
+  uint32_t sentMillis = 0;
+} MQTTLinuxClientInflight;
+
 typedef struct {
   MQTTLinuxClient *client = nullptr;
   MQTTLinuxClientCallbackSimple simple = nullptr;
@@ -75,6 +102,7 @@ class MQTTLinuxClient {
   lwmqtt_unix_tls_network_t networkTLS = {0};
   lwmqtt_unix_tls_timer_t timer1TLS = {0};
   lwmqtt_unix_tls_timer_t timer2TLS = {0};
+  uint32_t tlsSessionHash = 0;
 #endif
   lwmqtt_client_t client = lwmqtt_client_t();
 
@@ -83,6 +111,15 @@ class MQTTLinuxClient {
   lwmqtt_return_code_t _returnCode = (lwmqtt_return_code_t)0;
   lwmqtt_err_t _lastError = (lwmqtt_err_t)0;
   uint32_t _droppedMessages = 0;
+  uint32_t _roundTrip = 0;
+
+  MQTTLinuxClientInflight *inflight = nullptr;
+  size_t inflightWindow = 0;
+  size_t inflightCount = 0;
+  pthread_mutex_t inflightMutex = PTHREAD_MUTEX_INITIALIZER;
+  pthread_t loopThread = pthread_t();
+  bool hasLoopThread = false;
+  MQTTLinuxClientCallbackPublish publishCallback = nullptr;
 
  public:
   void *ref = nullptr;
@@ -134,6 +171,14 @@ class MQTTLinuxClient {
     this->setTimeout(_timeout);
   }
 
+  // publish QoS1/2 without waiting, up to window unacknowledged packets (0 to wait for each ack)
+  void setInflightWindow(size_t window);
+  size_t pendingPublishes();
+  void onPublished(MQTTLinuxClientCallbackPublish cb) { this->publishCallback = cb; }
+
+  // milliseconds from sending the last acknowledged publish to its ack
+  uint32_t roundTrip() { return this->_roundTrip; }
+
   void dropOverflow(bool enabled);
   uint32_t droppedMessages() { return this->_droppedMessages; }
 
@@ -185,6 +230,10 @@ class MQTTLinuxClient {
   bool connected();
   bool sessionPresent() { return this->_sessionPresent; }
 
+  // socket to wait on and milliseconds until the next ping, for an idle main loop
+  int getSocket();
+  uint32_t getKeepAliveTimeout();
+
   lwmqtt_err_t lastError() { return this->_lastError; }
   lwmqtt_return_code_t returnCode() { return this->_returnCode; }
 
@@ -192,6 +241,19 @@ class MQTTLinuxClient {
 
  private:
   void close();
+
+  bool publishAsync(const char topic[], lwmqtt_message_t message);
+  bool waitInflight();
+  void resendInflight(bool expired = false);
+  void clearInflight();
+  void releaseInflight(MQTTLinuxClientInflight &item);
+  void completeInflight(MQTTLinuxClientInflight &item, bool success);
+  void onAck(uint16_t packetID);
+  static void ackHandler(lwmqtt_client_t *client, void *ref, uint16_t packetID);
+#if defined(ERA_MQTT_SSL)
+  void loadTLSSession();
+  void saveTLSSession();
+#endif
 };
 
 typedef MQTTLinuxClient MQTTClient;
@@ -47,52 +47,50 @@ void lwmqtt_unix_tls_network_init(lwmqtt_unix_tls_network_t *network, bool verif
     return;
   }
 
+  // drop the kept config if the trust settings change
+  if (network->ready && ((network->verify != verify) || (network->ca_buf != ca_buf) || (network->ca_len != ca_len))) {
+    lwmqtt_unix_tls_network_free(network);
+  }
+
   network->verify = verify;
   network->ca_buf = (uint8_t*)ca_buf;
   network->ca_len = ca_len;
 }
 
-lwmqtt_err_t lwmqtt_unix_tls_network_connect(lwmqtt_unix_tls_network_t *network, char *host, int port) {
-  // close any open socket
-  lwmqtt_unix_tls_network_disconnect(network);
-
-  static char port_string[10] {0};
-  memset(port_string, 0, sizeof(port_string));
-  snprintf(port_string, sizeof(port_string), "%d", port);
+static int lwmqtt_unix_tls_network_setup(lwmqtt_unix_tls_network_t *network) {
+  if (network->ready) {
+    return 0;
+  }
 
   // initialize support structures
-  mbedtls_net_init(&network->socket);
-  mbedtls_ssl_init(&network->ssl);
   mbedtls_ssl_config_init(&network->conf);
   mbedtls_x509_crt_init(&network->cacert);
   mbedtls_ctr_drbg_init(&network->ctr_drbg);
   mbedtls_entropy_init(&network->entropy);
+  network->ready = true;
 
   // setup entropy source
   int ret = mbedtls_ctr_drbg_seed(&network->ctr_drbg, mbedtls_entropy_func, &network->entropy, NULL, 0);
   if (ret != 0) {
-    return LWMQTT_NETWORK_FAILED_CONNECT;
+    lwmqtt_unix_tls_network_free(network);
+    return ret;
   }
 
   // parse ca certificate
   if (network->ca_buf) {
     ret = mbedtls_x509_crt_parse(&network->cacert, network->ca_buf, network->ca_len);
     if (ret != 0) {
-      return LWMQTT_NETWORK_FAILED_CONNECT;
+      lwmqtt_unix_tls_network_free(network);
+      return ret;
     }
   }
 
-  // connect socket
-  ret = mbedtls_net_connect(&network->socket, host, port_string, MBEDTLS_NET_PROTO_TCP);
-  if (ret != 0) {
-    return LWMQTT_NETWORK_FAILED_CONNECT;
-  }
-
   // load defaults
   ret = mbedtls_ssl_config_defaults(&network->conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
                                     MBEDTLS_SSL_PRESET_DEFAULT);
   if (ret != 0) {
-    return LWMQTT_NETWORK_FAILED_CONNECT;
+    lwmqtt_unix_tls_network_free(network);
+    return ret;
   }
 
   // set ca certificate
@@ -106,6 +104,93 @@ lwmqtt_err_t lwmqtt_unix_tls_network_connect(lwmqtt_unix_tls_network_t *network,
   // set rng callback
   mbedtls_ssl_conf_rng(&network->conf, mbedtls_ctr_drbg_random, &network->ctr_drbg);
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+  // ask for a session ticket, session ids are used otherwise
+  mbedtls_ssl_conf_session_tickets(&network->conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+  return 0;
+}
+
+static void lwmqtt_unix_tls_network_forget(lwmqtt_unix_tls_network_t *network) {
+  mbedtls_ssl_session_free(&network->session);
+  mbedtls_ssl_session_init(&network->session);
+  network->session_valid = false;
+}
+
+void lwmqtt_unix_tls_network_free(lwmqtt_unix_tls_network_t *network) {
+  if (!network) {
+    return;
+  }
+
+  lwmqtt_unix_tls_network_forget(network);
+  if (!network->ready) {
+    return;
+  }
+
+  lwmqtt_unix_tls_network_disconnect(network);
+  mbedtls_x509_crt_free(&network->cacert);
+  mbedtls_entropy_free(&network->entropy);
+  mbedtls_ssl_config_free(&network->conf);
+  mbedtls_ctr_drbg_free(&network->ctr_drbg);
+
+  network->ready = false;
+}
+
+size_t lwmqtt_unix_tls_network_save_session(lwmqtt_unix_tls_network_t *network, uint8_t *buf, size_t len) {
+  if (!network || !network->session_valid) {
+    return 0;
+  }
+
+  size_t olen = 0;
+  int ret = mbedtls_ssl_session_save(&network->session, buf, len, &olen);
+  if (ret != 0) {
+    return 0;
+  }
+
+  return olen;
+}
+
+bool lwmqtt_unix_tls_network_load_session(lwmqtt_unix_tls_network_t *network, const uint8_t *buf, size_t len) {
+  if (!network || !buf || !len) {
+    return false;
+  }
+
+  lwmqtt_unix_tls_network_forget(network);
+  int ret = mbedtls_ssl_session_load(&network->session, buf, len);
+  if (ret != 0) {
+    lwmqtt_unix_tls_network_forget(network);
+    return false;
+  }
+
+  network->session_valid = true;
+  return true;
+}
+
+lwmqtt_err_t lwmqtt_unix_tls_network_connect(lwmqtt_unix_tls_network_t *network, char *host, int port) {
+  // close any open socket
+  lwmqtt_unix_tls_network_disconnect(network);
+
+  static char port_string[10] {0};
+  memset(port_string, 0, sizeof(port_string));
+  snprintf(port_string, sizeof(port_string), "%d", port);
+
+  // seed the DRBG and parse the CA chain once
+  int ret = lwmqtt_unix_tls_network_setup(network);
+  if (ret != 0) {
+    return LWMQTT_NETWORK_FAILED_CONNECT;
+  }
+
+  // initialize connection structures
+  mbedtls_net_init(&network->socket);
+  mbedtls_ssl_init(&network->ssl);
+
+  // connect socket
+  ret = mbedtls_net_connect(&network->socket, host, port_string, MBEDTLS_NET_PROTO_TCP);
+  if (ret != 0) {
+    return LWMQTT_NETWORK_FAILED_CONNECT;
+  }
+
   // setup ssl context
   ret = mbedtls_ssl_setup(&network->ssl, &network->conf);
   if (ret != 0) {
@@ -118,6 +203,11 @@ lwmqtt_err_t lwmqtt_unix_tls_network_connect(lwmqtt_unix_tls_network_t *network,
     return LWMQTT_NETWORK_FAILED_CONNECT;
   }
 
+  // offer the last session, the server may still ask for a full handshake
+  if (network->session_valid) {
+    mbedtls_ssl_set_session(&network->ssl, &network->session);
+  }
+
   // set bio callbacks
   mbedtls_ssl_set_bio(&network->ssl, &network->socket, mbedtls_net_send, mbedtls_net_recv, NULL);
 
@@ -133,9 +223,14 @@ lwmqtt_err_t lwmqtt_unix_tls_network_connect(lwmqtt_unix_tls_network_t *network,
   // perform handshake
   ret = mbedtls_ssl_handshake(&network->ssl);
   if (ret != 0) {
+    lwmqtt_unix_tls_network_forget(network);
     return LWMQTT_NETWORK_FAILED_CONNECT;
   }
 
+  // keep the session for the next reconnect
+  lwmqtt_unix_tls_network_forget(network);
+  network->session_valid = (mbedtls_ssl_get_session(&network->ssl, &network->session) == 0);
+
   return LWMQTT_SUCCESS;
 }
 
@@ -182,10 +277,6 @@ void lwmqtt_unix_tls_network_disconnect(lwmqtt_unix_tls_network_t *network) {
     ret = mbedtls_ssl_close_notify(&network->ssl);
   } while (ret == MBEDTLS_ERR_SSL_WANT_WRITE);
 
-  mbedtls_x509_crt_free(&network->cacert);
-  mbedtls_entropy_free(&network->entropy);
-  mbedtls_ssl_config_free(&network->conf);
-  mbedtls_ctr_drbg_free(&network->ctr_drbg);
   mbedtls_ssl_free(&network->ssl);
   mbedtls_net_free(&network->socket);
 
@@ -36,6 +36,9 @@ int32_t lwmqtt_unix_tls_timer_get(void *ref);
 
 /**
  * The UNIX network object.
+ *
+ * The entropy, DRBG, CA chain and SSL config are set up on the first connect and kept until
+ * lwmqtt_unix_tls_network_free(). The last session is offered for resumption on reconnect.
  */
 typedef struct {
   mbedtls_entropy_context entropy;
@@ -44,9 +47,12 @@ typedef struct {
   mbedtls_ssl_config conf;
   mbedtls_x509_crt cacert;
   mbedtls_net_context socket;
+  mbedtls_ssl_session session;
   uint8_t *ca_buf;
   size_t ca_len;
   bool verify;
+  bool ready;
+  bool session_valid;
 } lwmqtt_unix_tls_network_t;
 
 /**
@@ -59,6 +65,33 @@ typedef struct {
  */
 void lwmqtt_unix_tls_network_init(lwmqtt_unix_tls_network_t *network, bool verify, const uint8_t *ca_buf, size_t ca_len);
 
+/**
+ * Function to release the state kept across connections.
+ *
+ * @param network - The network object.
+ */
+void lwmqtt_unix_tls_network_free(lwmqtt_unix_tls_network_t *network);
+
+/**
+ * Function to serialize the cached session.
+ *
+ * @param network - The network object.
+ * @param buf - The output buffer.
+ * @param len - The size of the output buffer.
+ * @return The length written, 0 if no session is cached or it does not fit.
+ */
+size_t lwmqtt_unix_tls_network_save_session(lwmqtt_unix_tls_network_t *network, uint8_t *buf, size_t len);
+
+/**
+ * Function to restore a session serialized by lwmqtt_unix_tls_network_save_session().
+ *
+ * @param network - The network object.
+ * @param buf - The serialized session.
+ * @param len - The length of the serialized session.
+ * @return Whether the session was restored.
+ */
+bool lwmqtt_unix_tls_network_load_session(lwmqtt_unix_tls_network_t *network, const uint8_t *buf, size_t len);
+
 /**
  * Function to establish a UNIX network connection.
  *
@@ -0,0 +1,411 @@
+#ifndef INC_ERA_MODBUS_BUS_LINUX_HPP_
+#define INC_ERA_MODBUS_BUS_LINUX_HPP_
+
+#include <pthread.h>
+#include <Modbus/ERaModbusTransp.hpp>
+#include <Modbus/ERaModbusPlanner.hpp>
+#include <Utility/ERaSerialLinux.hpp>
+#include <Network/ERaSocketLinux.hpp>
+
+/* Bus 0 is the default ERaModbus stream */
+#define ERA_MODBUS_BUS_DEFAULT          0
+
+#if !defined(ERA_MODBUS_MAX_BUS)
+    #define ERA_MODBUS_MAX_BUS          8
+#endif
+
+typedef struct __ModbusBusJob_t {
+    ModbusBlock_t* target;
+    ModbusBlock_t block;
+} ModbusBusJob_t;
+
+/* Extra RS485 port or TCP endpoint, read by its own worker thread */
+class ERaModbusBus
+{
+public:
+    ERaModbusBus(uint8_t _id, const char* _device, int _baudrate)
+        : id(_id)
+        , transp(ModbusTransportT::MODBUS_TRANSPORT_RTU)
+        , device(_device)
+        , baudrate(_baudrate)
+        , port(0)
+        , timeout(DEFAULT_TIMEOUT_MODBUS)
+        , busy(false)
+        , running(false)
+    {
+        this->init();
+    }
+    ERaModbusBus(uint8_t _id, IPAddress _ip, uint16_t _port)
+        : id(_id)
+        , transp(ModbusTransportT::MODBUS_TRANSPORT_TCP)
+        , device(NULL)
+        , baudrate(0)
+        , ip(_ip)
+        , port(_port)
+        , timeout(DEFAULT_TIMEOUT_MODBUS)
+        , busy(false)
+        , running(false)
+    {
+        this->init();
+    }
+    ~ERaModbusBus()
+    {
+        this->end();
+        pthread_cond_destroy(&this->cond);
+        pthread_mutex_destroy(&this->jobMutex);
+        pthread_mutex_destroy(&this->mutex);
+    }
+
+    uint8_t getId() const {
+        return this->id;
+    }
+
+    uint8_t getTransport() const {
+        return this->transp;
+    }
+
+    /* TCP bus of the gateway an entry's ipSlave points to, port 0 is any */
+    bool isGateway(const IPSlave_t& ipSlave) const {
+        if (this->isRTU()) {
+            return false;
+        }
+        return ((this->ip == IPAddress(ipSlave.ip.dword)) &&
+                (!ipSlave.port || (ipSlave.port == this->port)));
+    }
+
+    void setTimeout(uint32_t _timeout) {
+        this->timeout = _timeout;
+    }
+
+    void begin();
+    void end();
+    void post(ModbusBlock_t* block);
+    void dispatch();
+    void wait();
+    void clearJobs();
+
+    const ERaList<ModbusBusJob_t*>& getJobs() const {
+        return this->jobs;
+    }
+
+    /* Held around every transaction, also by writes from the main task */
+    void lock() {
+        pthread_mutex_lock(&this->mutex);
+    }
+
+    void unlock() {
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+    void send(const uint8_t* data, size_t size);
+    bool receive(ERaModbusResponse* response);
+
+private:
+    void init() {
+        pthread_mutex_init(&this->mutex, NULL);
+        pthread_mutex_init(&this->jobMutex, NULL);
+        pthread_cond_init(&this->cond, NULL);
+    }
+
+    bool isRTU() const {
+        return (this->transp == ModbusTransportT::MODBUS_TRANSPORT_RTU);
+    }
+
+    bool connect();
+    bool receiveRTU(ERaModbusResponse* response);
+    bool receiveTCP(ERaModbusResponse* response);
+    void process(ModbusBusJob_t* job);
+    void processJobs();
+    static void* task(void* args);
+
+    uint8_t id;
+    uint8_t transp;
+    const char* device;
+    int baudrate;
+    IPAddress ip;
+    uint16_t port;
+    uint32_t timeout;
+    ERaSerialLinux serial;
+    ERaSocketLinux client;
+    ERaList<ModbusBusJob_t*> jobs;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_mutex_t jobMutex;
+    pthread_cond_t cond;
+    bool busy;
+    bool running;
+};
+
+inline
+void ERaModbusBus::begin() {
+    this->connect();
+#if !defined(ERA_NO_RTOS)
+    if (this->running) {
+        return;
+    }
+    this->running = true;
+    if (pthread_create(&this->thread, NULL, ERaModbusBus::task, this)) {
+        this->running = false;
+    }
+#endif
+}
+
+inline
+void ERaModbusBus::end() {
+#if !defined(ERA_NO_RTOS)
+    if (this->running) {
+        pthread_mutex_lock(&this->jobMutex);
+        this->running = false;
+        pthread_cond_broadcast(&this->cond);
+        pthread_mutex_unlock(&this->jobMutex);
+        pthread_join(this->thread, NULL);
+    }
+#endif
+    this->clearJobs();
+    if (this->isRTU()) {
+        this->serial.end();
+    }
+    else {
+        this->client.stop();
+    }
+}
+
+inline
+void ERaModbusBus::post(ModbusBlock_t* block) {
+    if (block == nullptr) {
+        return;
+    }
+    ModbusBusJob_t* job = new_modbus ModbusBusJob_t();
+    if (job == nullptr) {
+        return;
+    }
+    job->target = block;
+    job->block = (*block);
+    this->jobs.put(job);
+}
+
+inline
+void ERaModbusBus::dispatch() {
+#if !defined(ERA_NO_RTOS)
+    if (this->running) {
+        pthread_mutex_lock(&this->jobMutex);
+        this->busy = true;
+        pthread_cond_broadcast(&this->cond);
+        pthread_mutex_unlock(&this->jobMutex);
+        return;
+    }
+#endif
+    this->processJobs();
+}
+
+inline
+void ERaModbusBus::wait() {
+    pthread_mutex_lock(&this->jobMutex);
+    while (this->busy) {
+        pthread_cond_wait(&this->cond, &this->jobMutex);
+    }
+    pthread_mutex_unlock(&this->jobMutex);
+}
+
+inline
+void ERaModbusBus::send(const uint8_t* data, size_t size) {
+    if (data == nullptr) {
+        return;
+    }
+
+    ERaLogHex("MB >>", data, size);
+    if (this->isRTU()) {
+        this->serial.flushInput();
+        this->serial.write(data, size);
+        this->serial.drain();
+        return;
+    }
+
+    if (!this->connect()) {
+        return;
+    }
+    while (this->client.available()) {
+        this->client.read();
+    }
+    this->client.write(data, size);
+    this->client.flush();
+}
+
+inline
+bool ERaModbusBus::receive(ERaModbusResponse* response) {
+    if (response == nullptr) {
+        return false;
+    }
+    if (this->isRTU()) {
+        return this->receiveRTU(response);
+    }
+    return this->receiveTCP(response);
+}
+
+inline
+bool ERaModbusBus::connect() {
+    if (this->isRTU()) {
+        /* ERaSerialLinux reopens the device by itself once begun */
+        if ((int)this->serial < 0) {
+            this->serial.begin(this->device, this->baudrate);
+        }
+        return ((int)this->serial >= 0);
+    }
+
+    if (this->client.connected()) {
+        return true;
+    }
+    return this->client.connect(this->ip, this->port);
+}
+
+inline
+bool ERaModbusBus::receiveRTU(ERaModbusResponse* response) {
+    MillisTime_t startMillis = ERaMillis();
+    MillisTime_t lastMillis = startMillis;
+    const MillisTime_t frameGap = ERaModbusFrameGap(this->baudrate);
+
+    do {
+        MillisTime_t waitMs = ERaRemainingTime(startMillis, this->timeout);
+        if (response->getPosition()) {
+            waitMs = ERaRemainingTime(lastMillis, frameGap);
+        }
+        waitMs = ERaMin(waitMs, (MillisTime_t)ERA_MODBUS_POLL_MS);
+
+        if (!this->serial.waitReadable(waitMs)) {
+            if (ModbusState::is(ModbusStateT::STATE_MB_PARSE)) {
+                break;
+            }
+            if (response->getPosition() &&
+                !ERaRemainingTime(lastMillis, frameGap)) {
+                ERaLogHex("MB <<", response->getMessage(), response->getPosition());
+                return false;
+            }
+            continue;
+        }
+
+        int length = this->serial.read(response->getNext(), response->getRemaining());
+        if (length <= 0) {
+            if (!response->getRemaining()) {
+                break;
+            }
+            continue;
+        }
+        response->advance(length);
+        lastMillis = ERaMillis();
+
+        if (response->isComplete()) {
+            ERaLogHex("MB <<", response->getMessage(), response->getPosition());
+            return response->isSuccess();
+        }
+    } while (ERaRemainingTime(startMillis, this->timeout));
+    return false;
+}
+
+inline
+bool ERaModbusBus::receiveTCP(ERaModbusResponse* response) {
+    MillisTime_t startMillis = ERaMillis();
+
+    do {
+        if (!this->client.available()) {
+            if (!this->client.connected()) {
+                break;
+            }
+            ERA_MODBUS_YIELD();
+            continue;
+        }
+
+        do {
+            int c = this->client.read();
+            if (c < 0) {
+                continue;
+            }
+            response->add((uint8_t)c);
+        } while (this->client.available());
+
+        if (response->isComplete()) {
+            ERaLogHex("MB <<", response->getMessage(), response->getPosition());
+            return response->isSuccess();
+        }
+    } while (ERaRemainingTime(startMillis, this->timeout));
+    return false;
+}
+
+inline
+void ERaModbusBus::process(ModbusBusJob_t* job) {
+    ModbusBlock_t& block = job->block;
+    block.status = false;
+    block.statusCode = ModbusStatusT::MODBUS_STATUS_OK;
+    block.bytes = 0;
+
+    ERaModbusRequest* request = ERaModbusReadRequest(this->transp, block.param);
+    ERA_ASSERT_NULL(request, )
+    ERaModbusResponse* response = new_modbus ERaModbusResponse(request, request->responseLength());
+    if (response == nullptr) {
+        delete request;
+        return;
+    }
+
+    this->lock();
+    uint32_t prevTimeout = this->timeout;
+    if (block.probe) {
+        this->timeout = ERaMin(prevTimeout, (uint32_t)ERA_MODBUS_PROBE_TIMEOUT_MS);
+    }
+    this->send(request->getMessage(), request->getSize());
+    block.status = this->receive(response);
+    this->timeout = prevTimeout;
+    this->unlock();
+
+    if (block.status) {
+        block.bytes = ERaMin(response->getBytes(), (uint8_t)sizeof(block.data));
+        memcpy(block.data, response->getData(), block.bytes);
+    }
+    else {
+        block.statusCode = response->getStatusCode();
+    }
+
+    delete request;
+    delete response;
+}
+
+inline
+void ERaModbusBus::processJobs() {
+    const ERaList<ModbusBusJob_t*>::iterator* e = this->jobs.end();
+    for (ERaList<ModbusBusJob_t*>::iterator* it = this->jobs.begin(); it != e; it = it->getNext()) {
+        this->process(it->get());
+        ERaDelay(ERA_MODBUS_DELAYS_MS);
+    }
+}
+
+inline
+void ERaModbusBus::clearJobs() {
+    const ERaList<ModbusBusJob_t*>::iterator* e = this->jobs.end();
+    for (ERaList<ModbusBusJob_t*>::iterator* it = this->jobs.begin(); it != e; it = it->getNext()) {
+        delete it->get();
+    }
+    this->jobs.clear();
+}
+
+inline
+void* ERaModbusBus::task(void* args) {
+    ERaModbusBus* bus = (ERaModbusBus*)args;
+    pthread_mutex_lock(&bus->jobMutex);
+    for (;;) {
+        while (bus->running && !bus->busy) {
+            pthread_cond_wait(&bus->cond, &bus->jobMutex);
+        }
+        if (!bus->running) {
+            break;
+        }
+        pthread_mutex_unlock(&bus->jobMutex);
+        bus->processJobs();
+        pthread_mutex_lock(&bus->jobMutex);
+        bus->busy = false;
+        pthread_cond_broadcast(&bus->cond);
+    }
+    bus->busy = false;
+    pthread_cond_broadcast(&bus->cond);
+    pthread_mutex_unlock(&bus->jobMutex);
+    return NULL;
+}
+
+#endif /* INC_ERA_MODBUS_BUS_LINUX_HPP_ */
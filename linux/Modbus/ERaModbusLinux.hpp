@@ -22,6 +22,29 @@
     #define SerialMB                SerialModBus<ERaSerialLinux>::serial()
 #endif
 
+/* Minimum line silence that ends an RTU frame, on top of the 3.5 char gap.
+   USB-RS485 adapters deliver bytes in bursts (FTDI latency timer 16 ms). */
+#if !defined(ERA_MODBUS_MIN_FRAME_GAP_MS)
+    #define ERA_MODBUS_MIN_FRAME_GAP_MS 20UL
+#endif
+
+/* Upper bound of a single poll() so parse state changes are still seen */
+#if !defined(ERA_MODBUS_POLL_MS)
+    #define ERA_MODBUS_POLL_MS          100UL
+#endif
+
+static inline
+MillisTime_t ERaModbusFrameGap(int baudrate) {
+    /* t3.5 = 3.5 chars * 11 bits, fixed at 1750 us above 19200 baud */
+    MillisTime_t gap {2};
+    if ((baudrate > 0) && (baudrate <= 19200)) {
+        gap = ((38500UL + baudrate - 1) / baudrate) + 1;
+    }
+    return ERaMax(gap, (MillisTime_t)ERA_MODBUS_MIN_FRAME_GAP_MS);
+}
+
+#include <Modbus/ERaModbusBusLinux.hpp>
+
 template <class Api>
 void ERaModbus<Api>::configModbus() {
     if (this->streamRTU != NULL) {
@@ -58,12 +81,21 @@ bool ERaModbus<Api>::waitResponse(ERaModbusResponse* response) {
     if (response == nullptr) {
         return false;
     }
+    if (this->activeBus != nullptr) {
+        this->updateTotalTransmit();
+        return this->activeBus->receive(response);
+    }
     if (this->stream == NULL) {
         return false;
     }
 
     this->updateTotalTransmit();
 
+    if ((this->stream == this->streamRTU) &&
+        this->streamDefault()) {
+        return this->waitResponseRTU(response);
+    }
+
     MillisTime_t startMillis = ERaMillis();
 
     do {
@@ -98,20 +130,336 @@ bool ERaModbus<Api>::waitResponse(ERaModbusResponse* response) {
     return false;
 }
 
+template <class Api>
+bool ERaModbus<Api>::waitResponseRTU(ERaModbusResponse* response) {
+    MillisTime_t startMillis = ERaMillis();
+    MillisTime_t lastMillis = startMillis;
+    const MillisTime_t frameGap = ERaModbusFrameGap(SerialMB.getBaudRate());
+
+    do {
+        MillisTime_t waitMs = ERaRemainingTime(startMillis, this->timeout);
+        if (response->getPosition()) {
+            waitMs = ERaRemainingTime(lastMillis, frameGap);
+        }
+#if defined(ERA_NO_RTOS)
+        waitMs = ERaMin(waitMs, (MillisTime_t)ERA_MODBUS_YIELD_MS);
+#else
+        waitMs = ERaMin(waitMs, (MillisTime_t)ERA_MODBUS_POLL_MS);
+#endif
+
+        if (!SerialMB.waitReadable(waitMs)) {
+#if defined(ERA_NO_RTOS)
+            if (this->runApiResponse) {
+                this->thisApi().run();
+                this->thisApi().runZigbee();
+            }
+#endif
+            if (ModbusState::is(ModbusStateT::STATE_MB_PARSE)) {
+                break;
+            }
+            if (response->getPosition() &&
+                !ERaRemainingTime(lastMillis, frameGap)) {
+                /* Inter-frame gap: the slave is done, frame is short or corrupt */
+                ERaLogHex("MB <<", response->getMessage(), response->getPosition());
+                return false;
+            }
+            continue;
+        }
+
+        int length = SerialMB.read(response->getNext(), response->getRemaining());
+        if (length <= 0) {
+            if (!response->getRemaining()) {
+                break;
+            }
+            continue;
+        }
+        response->advance(length);
+        lastMillis = ERaMillis();
+
+        if (response->isComplete()) {
+            ERaLogHex("MB <<", response->getMessage(), response->getPosition());
+            return response->isSuccess();
+        }
+    } while (ERaRemainingTime(startMillis, this->timeout));
+    return false;
+}
+
 template <class Api>
 void ERaModbus<Api>::sendCommand(uint8_t* data, size_t size) {
     if (data == nullptr) {
         return;
     }
+    if (this->activeBus != nullptr) {
+        this->activeBus->send(data, size);
+        return;
+    }
     if (this->stream == NULL) {
         return;
     }
 
     ERaLogHex("MB >>", data, size);
+    if ((this->stream == this->streamRTU) &&
+        this->streamDefault()) {
+        /* Drop stale bytes, then wait for the frame to leave the UART before releasing DE */
+        SerialMB.flushInput();
+        this->switchToTransmit();
+        SerialMB.write(data, size);
+        SerialMB.drain();
+        this->switchToReceive();
+        return;
+    }
+
     this->switchToTransmit();
     this->stream->write(data, size);
     this->stream->flush();
     this->switchToReceive();
 }
 
+template <class Api>
+uint8_t ERaModbus<Api>::addModbusBus(const char* device, int baudrate) {
+    if (device == nullptr) {
+        return ERA_MODBUS_BUS_DEFAULT;
+    }
+    if (this->buses.size() >= ERA_MODBUS_MAX_BUS) {
+        return ERA_MODBUS_BUS_DEFAULT;
+    }
+    ERaModbusBus* bus = new_modbus ERaModbusBus(this->buses.size() + 1, device, baudrate);
+    if (bus == nullptr) {
+        return ERA_MODBUS_BUS_DEFAULT;
+    }
+    bus->begin();
+    this->buses.put(bus);
+    return bus->getId();
+}
+
+template <class Api>
+uint8_t ERaModbus<Api>::addModbusBus(IPAddress _ip, uint16_t _port) {
+    if (this->buses.size() >= ERA_MODBUS_MAX_BUS) {
+        return ERA_MODBUS_BUS_DEFAULT;
+    }
+    ERaModbusBus* bus = new_modbus ERaModbusBus(this->buses.size() + 1, _ip, _port);
+    if (bus == nullptr) {
+        return ERA_MODBUS_BUS_DEFAULT;
+    }
+    bus->begin();
+    ERaGuardLock(this->mutex);
+    this->buses.put(bus);
+    /* Entries of this gateway move to the new bus */
+    this->readPlan.invalidate();
+    ERaGuardUnlock(this->mutex);
+    return bus->getId();
+}
+
+/* Serial entries of this unit id, entries with an ipSlave
+   follow the TCP bus of their gateway instead */
+template <class Api>
+void ERaModbus<Api>::setModbusSlaveBus(uint8_t slave, uint8_t bus) {
+    this->setBusRoute(false, slave, bus);
+}
+
+/* One config entry, for units that exist on more than one bus */
+template <class Api>
+void ERaModbus<Api>::setModbusConfigBus(int id, uint8_t bus) {
+    this->setBusRoute(true, id, bus);
+}
+
+template <class Api>
+void ERaModbus<Api>::setBusRoute(bool entry, int id, uint8_t bus) {
+    if ((bus != ERA_MODBUS_BUS_DEFAULT) &&
+        (this->getBus(bus) == nullptr)) {
+        return;
+    }
+    ERaGuardLock(this->mutex);
+    ModbusBusRoute_t* route = nullptr;
+    const ERaList<ModbusBusRoute_t*>::iterator* e = this->busRoutes.end();
+    for (ERaList<ModbusBusRoute_t*>::iterator* it = this->busRoutes.begin(); it != e; it = it->getNext()) {
+        if ((it->get()->entry == entry) &&
+            (it->get()->id == id)) {
+            route = it->get();
+            break;
+        }
+    }
+    if (route == nullptr) {
+        route = new_modbus ModbusBusRoute_t {entry, id, bus};
+        if (route != nullptr) {
+            this->busRoutes.put(route);
+        }
+    }
+    if (route != nullptr) {
+        route->bus = bus;
+        this->readPlan.invalidate();
+    }
+    ERaGuardUnlock(this->mutex);
+}
+
+/* Entry route first, then the gateway address, then the serial unit id */
+template <class Api>
+bool ERaModbus<Api>::findBus(const ModbusConfig_t& param, uint8_t& bus) {
+    const ERaList<ModbusBusRoute_t*>::iterator* e = this->busRoutes.end();
+    for (ERaList<ModbusBusRoute_t*>::iterator* it = this->busRoutes.begin(); it != e; it = it->getNext()) {
+        const ModbusBusRoute_t* route = it->get();
+        if (route->entry && (route->id == param.id)) {
+            bus = route->bus;
+            return true;
+        }
+    }
+    if (param.ipSlave.ip.dword) {
+        const ERaList<ERaModbusBus*>::iterator* eb = this->buses.end();
+        for (ERaList<ERaModbusBus*>::iterator* ib = this->buses.begin(); ib != eb; ib = ib->getNext()) {
+            if (ib->get()->isGateway(param.ipSlave)) {
+                bus = ib->get()->getId();
+                return true;
+            }
+        }
+        bus = ERA_MODBUS_BUS_DEFAULT;
+        return true;
+    }
+    for (ERaList<ModbusBusRoute_t*>::iterator* it = this->busRoutes.begin(); it != e; it = it->getNext()) {
+        const ModbusBusRoute_t* route = it->get();
+        if (!route->entry && (route->id == param.addr)) {
+            bus = route->bus;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Api>
+ERaModbusBus* ERaModbus<Api>::getBus(uint8_t id) {
+    if (id == ERA_MODBUS_BUS_DEFAULT) {
+        return nullptr;
+    }
+    const ERaList<ERaModbusBus*>::iterator* e = this->buses.end();
+    for (ERaList<ERaModbusBus*>::iterator* it = this->buses.begin(); it != e; it = it->getNext()) {
+        ERaModbusBus* bus = it->get();
+        if (bus->getId() == id) {
+            return bus;
+        }
+    }
+    return nullptr;
+}
+
+template <class Api>
+void ERaModbus<Api>::routeBus() {
+    const ERaList<ModbusConfig_t*>::iterator* e = this->modbusConfig->modbusConfigParam.end();
+    for (ERaList<ModbusConfig_t*>::iterator* it = this->modbusConfig->modbusConfigParam.begin(); it != e; it = it->getNext()) {
+        ModbusConfig_t* param = it->get();
+        if (param == nullptr) {
+            continue;
+        }
+        /* Without a route the bus the entry already has is kept */
+        this->findBus(*param, param->bus);
+    }
+}
+
+template <class Api>
+void ERaModbus<Api>::dispatchBus() {
+    if (this->buses.isEmpty()) {
+        return;
+    }
+
+    /* Previous cycle may have been cut short by a parse */
+    const ERaList<ERaModbusBus*>::iterator* e = this->buses.end();
+    for (ERaList<ERaModbusBus*>::iterator* it = this->buses.begin(); it != e; it = it->getNext()) {
+        it->get()->wait();
+    }
+
+    ERaGuardLock(this->mutex);
+    for (ERaList<ERaModbusBus*>::iterator* it = this->buses.begin(); it != e; it = it->getNext()) {
+        ERaModbusBus* bus = it->get();
+        bus->clearJobs();
+        bus->setTimeout(this->timeout);
+        const ERaList<ModbusBlock_t*>::iterator* eb = this->readPlan.getBlocks().end();
+        for (ERaList<ModbusBlock_t*>::iterator* ib = this->readPlan.getBlocks().begin(); ib != eb; ib = ib->getNext()) {
+            ModbusBlock_t* block = ib->get();
+            if ((block->param.bus == bus->getId()) &&
+                !ERaModbusPlanner::isSkipped(block)) {
+                bus->post(block);
+            }
+        }
+        if (!bus->getJobs().isEmpty()) {
+            bus->dispatch();
+        }
+    }
+    ERaGuardUnlock(this->mutex);
+}
+
+template <class Api>
+void ERaModbus<Api>::collectBus(uint32_t generation) {
+    if (this->buses.isEmpty()) {
+        return;
+    }
+
+    const ERaList<ERaModbusBus*>::iterator* e = this->buses.end();
+    for (ERaList<ERaModbusBus*>::iterator* it = this->buses.begin(); it != e; it = it->getNext()) {
+        it->get()->wait();
+    }
+
+    ERaGuardLock(this->mutex);
+    if (generation != this->readPlan.getGeneration()) {
+        /* Config changed while the buses were reading, blocks are gone */
+        ERaGuardUnlock(this->mutex);
+        return;
+    }
+    for (ERaList<ERaModbusBus*>::iterator* it = this->buses.begin(); it != e; it = it->getNext()) {
+        const ERaList<ModbusBusJob_t*>::iterator* ej = it->get()->getJobs().end();
+        for (ERaList<ModbusBusJob_t*>::iterator* ij = it->get()->getJobs().begin(); ij != ej; ij = ij->getNext()) {
+            ModbusBusJob_t* job = ij->get();
+            ModbusBlock_t* block = job->target;
+            block->status = job->block.status;
+            block->statusCode = job->block.statusCode;
+            block->bytes = job->block.bytes;
+            memcpy(block->data, job->block.data, job->block.bytes);
+            this->updateTotalTransmit();
+            if (block->status) {
+                block->param.totalFail = 0;
+            }
+            else {
+                this->failRead++;
+                block->param.totalFail++;
+                if (block->statusCode != ModbusStatusT::MODBUS_STATUS_OK) {
+                    this->readPlan.split(block);
+                }
+            }
+            this->readPlan.schedule(block, ERaMillis());
+        }
+    }
+    ERaGuardUnlock(this->mutex);
+}
+
+template <class Api>
+void ERaModbus<Api>::nextBus(const ModbusConfig_t& param) {
+    uint8_t bus {param.bus};
+    this->findBus(param, bus);
+    this->activeBus = this->getBus(bus);
+    if (this->activeBus == nullptr) {
+        return;
+    }
+    this->activeBus->lock();
+    this->transp = this->activeBus->getTransport();
+}
+
+template <class Api>
+void ERaModbus<Api>::releaseBus() {
+    if (this->activeBus == nullptr) {
+        return;
+    }
+    this->activeBus->unlock();
+    this->activeBus = nullptr;
+}
+
+template <class Api>
+void ERaModbus<Api>::endBus() {
+    const ERaList<ERaModbusBus*>::iterator* e = this->buses.end();
+    for (ERaList<ERaModbusBus*>::iterator* it = this->buses.begin(); it != e; it = it->getNext()) {
+        delete it->get();
+    }
+    this->buses.clear();
+    const ERaList<ModbusBusRoute_t*>::iterator* er = this->busRoutes.end();
+    for (ERaList<ModbusBusRoute_t*>::iterator* it = this->busRoutes.begin(); it != er; it = it->getNext()) {
+        delete it->get();
+    }
+    this->busRoutes.clear();
+}
+
 #endif /* INC_ERA_MODBUS_LINUX_HPP_ */
@@ -167,6 +167,10 @@ public:
     }
 
     int selectRead(unsigned long _timeout) {
+        if (this->fd < 0) {
+            return -1;
+        }
+
         // prepare set
         fd_set set;
         fd_set ex_set;
@@ -262,11 +266,12 @@ public:
     }
 
     int read(uint8_t* buf, size_t size) override {
-        if (!this->available()) {
+        if (!this->_connected ||
+            (this->fd < 0)) {
             return 0;
         }
 
-        // TODO Block until data is available
+        // readable with nothing to read is the peer closing
         int rc = this->selectRead(0L);
         if (rc < 0) {
             this->stop();
@@ -19,9 +19,12 @@ class ERaSocketSecureLinux
         mbedtls_ssl_config conf;
         mbedtls_x509_crt cacert;
         mbedtls_net_context socket;
+        mbedtls_ssl_session session;
         uint8_t* ca_buf;
         size_t ca_len;
         bool verify;
+        bool ready;
+        bool sessionValid;
     } TLSNetwork_t;
 
 public:
@@ -35,9 +38,16 @@ public:
     ~ERaSocketSecureLinux()
     {
         this->disconnect();
+        this->release();
     }
 
     void begin(bool verify, const uint8_t* caBuf, size_t caLen) {
+        if (this->network.ready &&
+            ((this->network.verify != verify) || (this->network.ca_buf != caBuf) ||
+            (this->network.ca_len != caLen))) {
+            this->disconnect();
+            this->release();
+        }
         this->network.verify = verify;
         this->network.ca_buf = (uint8_t*)caBuf;
         this->network.ca_len = caLen;
@@ -57,27 +67,15 @@ public:
         memset(port_string, 0, sizeof(port_string));
         snprintf(port_string, sizeof(port_string), "%d", port);
 
-        // initialize support structures
-        mbedtls_net_init(&this->network.socket);
-        mbedtls_ssl_init(&this->network.ssl);
-        mbedtls_ssl_config_init(&this->network.conf);
-        mbedtls_x509_crt_init(&this->network.cacert);
-        mbedtls_ctr_drbg_init(&this->network.ctr_drbg);
-        mbedtls_entropy_init(&this->network.entropy);
-
-        // setup entropy source
-        int ret = mbedtls_ctr_drbg_seed(&this->network.ctr_drbg, mbedtls_entropy_func, &this->network.entropy, NULL, 0);
+        // seed the DRBG and parse the CA chain once
+        int ret = this->setup();
         if (ret != 0) {
             return 0;
         }
 
-        // parse ca certificate
-        if (this->network.ca_buf) {
-            ret = mbedtls_x509_crt_parse(&this->network.cacert, this->network.ca_buf, this->network.ca_len);
-            if (ret != 0) {
-                return 0;
-            }
-        }
+        // initialize connection structures
+        mbedtls_net_init(&this->network.socket);
+        mbedtls_ssl_init(&this->network.ssl);
 
         // connect socket
         ret = mbedtls_net_connect(&this->network.socket, host, port_string, MBEDTLS_NET_PROTO_TCP);
@@ -85,24 +83,6 @@ public:
             return 0;
         }
 
-        // load defaults
-        ret = mbedtls_ssl_config_defaults(&this->network.conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
-                                            MBEDTLS_SSL_PRESET_DEFAULT);
-        if (ret != 0) {
-            return 0;
-        }
-
-        // set ca certificate
-        if (this->network.ca_buf) {
-            mbedtls_ssl_conf_ca_chain(&this->network.conf, &this->network.cacert, NULL);
-        }
-
-        // set auth mode
-        mbedtls_ssl_conf_authmode(&this->network.conf, (this->network.verify) ? MBEDTLS_SSL_VERIFY_REQUIRED : MBEDTLS_SSL_VERIFY_NONE);
-
-        // set rng callback
-        mbedtls_ssl_conf_rng(&this->network.conf, mbedtls_ctr_drbg_random, &this->network.ctr_drbg);
-
         // setup ssl context
         ret = mbedtls_ssl_setup(&this->network.ssl, &this->network.conf);
         if (ret != 0) {
@@ -115,6 +95,11 @@ public:
             return 0;
         }
 
+        // offer the last session, the server may still ask for a full handshake
+        if (this->network.sessionValid) {
+            mbedtls_ssl_set_session(&this->network.ssl, &this->network.session);
+        }
+
         // set bio callbacks
         mbedtls_ssl_set_bio(&this->network.ssl, &this->network.socket, mbedtls_net_send, mbedtls_net_recv, NULL);
 
@@ -130,9 +115,14 @@ public:
         // perform handshake
         ret = mbedtls_ssl_handshake(&this->network.ssl);
         if (ret != 0) {
+            this->forgetSession();
             return 0;
         }
 
+        // keep the session for the next reconnect
+        this->forgetSession();
+        this->network.sessionValid = (mbedtls_ssl_get_session(&this->network.ssl, &this->network.session) == 0);
+
         int rc = this->networkWait(this->timeout);
         if (rc <= 0) {
             return 0;
@@ -179,6 +169,34 @@ public:
         return result;
     }
 
+    int selectRead(unsigned long _timeout) {
+        if (!this->_connected || (this->network.socket.fd < 0)) {
+            return -1;
+        }
+
+        // decrypted bytes already buffered count as readable
+        if (mbedtls_ssl_get_bytes_avail(&this->network.ssl)) {
+            return 1;
+        }
+
+        // prepare set
+        fd_set set;
+        fd_set ex_set;
+        FD_ZERO(&set);
+        FD_ZERO(&ex_set);
+        FD_SET(this->network.socket.fd, &set);
+        FD_SET(this->network.socket.fd, &ex_set);
+
+        // wait for data
+        struct timeval t = {.tv_sec = _timeout / 1000, .tv_usec = (_timeout % 1000) * 1000};
+        int result = select(this->network.socket.fd + 1, &set, NULL, &ex_set, &t);
+        if ((result < 0) || FD_ISSET(this->network.socket.fd, &ex_set)) {
+            return -1;
+        }
+
+        return result;
+    }
+
     size_t write(uint8_t value) override {
         return this->write(&value, 1);
     }
@@ -224,6 +242,12 @@ public:
             return 0;
         }
 
+        // decrypted bytes are already buffered
+        size_t buffered = mbedtls_ssl_get_bytes_avail(&this->network.ssl);
+        if (buffered) {
+            return (int)buffered;
+        }
+
         // prepare set
         fd_set set;
         fd_set ex_set;
@@ -337,10 +361,6 @@ public:
             ret = mbedtls_ssl_close_notify(&this->network.ssl);
         } while (ret == MBEDTLS_ERR_SSL_WANT_WRITE);
 
-        mbedtls_x509_crt_free(&this->network.cacert);
-        mbedtls_entropy_free(&this->network.entropy);
-        mbedtls_ssl_config_free(&this->network.conf);
-        mbedtls_ctr_drbg_free(&this->network.ctr_drbg);
         mbedtls_ssl_free(&this->network.ssl);
         mbedtls_net_free(&this->network.socket);
 
@@ -360,6 +380,82 @@ public:
     }
 
 private:
+    int setup() {
+        if (this->network.ready) {
+            return 0;
+        }
+
+        // initialize support structures
+        mbedtls_ssl_config_init(&this->network.conf);
+        mbedtls_x509_crt_init(&this->network.cacert);
+        mbedtls_ctr_drbg_init(&this->network.ctr_drbg);
+        mbedtls_entropy_init(&this->network.entropy);
+        this->network.ready = true;
+
+        // setup entropy source
+        int ret = mbedtls_ctr_drbg_seed(&this->network.ctr_drbg, mbedtls_entropy_func, &this->network.entropy, NULL, 0);
+        if (ret != 0) {
+            this->release();
+            return ret;
+        }
+
+        // parse ca certificate
+        if (this->network.ca_buf) {
+            ret = mbedtls_x509_crt_parse(&this->network.cacert, this->network.ca_buf, this->network.ca_len);
+            if (ret != 0) {
+                this->release();
+                return ret;
+            }
+        }
+
+        // load defaults
+        ret = mbedtls_ssl_config_defaults(&this->network.conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                            MBEDTLS_SSL_PRESET_DEFAULT);
+        if (ret != 0) {
+            this->release();
+            return ret;
+        }
+
+        // set ca certificate
+        if (this->network.ca_buf) {
+            mbedtls_ssl_conf_ca_chain(&this->network.conf, &this->network.cacert, NULL);
+        }
+
+        // set auth mode
+        mbedtls_ssl_conf_authmode(&this->network.conf, (this->network.verify) ? MBEDTLS_SSL_VERIFY_REQUIRED : MBEDTLS_SSL_VERIFY_NONE);
+
+        // set rng callback
+        mbedtls_ssl_conf_rng(&this->network.conf, mbedtls_ctr_drbg_random, &this->network.ctr_drbg);
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+        // ask for a session ticket, session ids are used otherwise
+        mbedtls_ssl_conf_session_tickets(&this->network.conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+        return 0;
+    }
+
+    /* Connection must be stopped first */
+    void release() {
+        this->forgetSession();
+        if (!this->network.ready) {
+            return;
+        }
+
+        mbedtls_x509_crt_free(&this->network.cacert);
+        mbedtls_entropy_free(&this->network.entropy);
+        mbedtls_ssl_config_free(&this->network.conf);
+        mbedtls_ctr_drbg_free(&this->network.ctr_drbg);
+
+        this->network.ready = false;
+    }
+
+    void forgetSession() {
+        mbedtls_ssl_session_free(&this->network.session);
+        mbedtls_ssl_session_init(&this->network.session);
+        this->network.sessionValid = false;
+    }
+
     TLSNetwork_t network;
 
     unsigned long timeout;
@@ -1,7 +1,15 @@
 #ifndef INC_ERA_OTA_LINUX_HPP_
 #define INC_ERA_OTA_LINUX_HPP_
 
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <Utility/MD5.hpp>
+#include <Utility/SHA256.hpp>
+#include <Utility/CRC32.hpp>
 #include <Utility/ERaUtility.hpp>
 #include <OTA/ERaOTAHelper.hpp>
 #include <OTA/ERaOTAHandler.hpp>
@@ -14,11 +22,79 @@
     #define ERA_OTA_BUFFER_SIZE     256
 #endif
 
+/* Receive buffer of the image download */
+#if !defined(ERA_OTA_LINUX_BUFFER_SIZE)
+    #define ERA_OTA_LINUX_BUFFER_SIZE   (16 * 1024)
+#endif
+
+/* Reconnects, resuming with a Range request, before giving up */
+#if !defined(ERA_OTA_MAX_RETRIES)
+    #define ERA_OTA_MAX_RETRIES     5
+#endif
+
+/* Bytes between two resume checkpoints */
+#if !defined(ERA_OTA_SYNC_SIZE)
+    #define ERA_OTA_SYNC_SIZE       (256 * 1024)
+#endif
+
 #if !defined(OTA_DOWNLOAD_TIMEOUT)
     #define OTA_DOWNLOAD_TIMEOUT    (5 * 60000)
 #endif
 
 #define OTA_RESPONSE_TIMEOUT        10000UL
+#define OTA_HEADER_MAX_SIZE         2048
+#define OTA_IMAGE_PATH              "era.bin"
+#define OTA_PART_PATH               "era.part"
+#define OTA_PART_MAGIC              0x5452414FUL
+
+/* SHA-256 when the expected hash has 64 hex digits, MD5 otherwise */
+class ERaOTADigest
+{
+public:
+    ERaOTADigest()
+        : md5()
+        , sha256()
+        , useSHA256(false)
+    {}
+
+    void select(const char* hash) {
+        this->useSHA256 = ((hash != nullptr) && (strlen(hash) == 64));
+    }
+
+    void begin() {
+        if (this->useSHA256) {
+            this->sha256.begin();
+        }
+        else {
+            this->md5.begin();
+        }
+    }
+
+    void update(const void* data, size_t size) {
+        if (this->useSHA256) {
+            this->sha256.update(data, size);
+        }
+        else {
+            this->md5.update(data, size);
+        }
+    }
+
+    const char* finalize() {
+        if (this->useSHA256) {
+            return this->sha256.finalize();
+        }
+        return this->md5.finalize();
+    }
+
+    const char* name() const {
+        return (this->useSHA256 ? "SHA-256" : "MD5");
+    }
+
+private:
+    MD5 md5;
+    SHA256 sha256;
+    bool useSHA256;
+};
 
 template <class Proto, class Flash>
 class ERaOTA
@@ -26,6 +102,22 @@ class ERaOTA
 {
     const char* TAG = "OTA";
 
+    /* How much of era.bin is on disk, and for which image */
+    typedef struct __OTAPart_t {
+        uint32_t magic;
+        uint32_t key;
+        uint32_t total;
+        uint32_t offset;
+        uint32_t crc;
+    } OTAPart_t;
+
+    typedef struct __OTAResponse_t {
+        int status;
+        uint32_t length;
+        uint32_t start;
+        uint32_t total;
+    } OTAResponse_t;
+
 public:
     ERaOTA(Flash& _flash)
         : flash(_flash)
@@ -55,177 +147,386 @@ protected:
         this->thisProto().getTransp().disconnect();
         ERA_LOG(TAG, ERA_PSTR("Firmware update URL: %s"), url);
 
-        int contentLength {0};
-        Client* client = nullptr;
+        bool status {false};
         if (this->getPort(url) == ERA_DEFAULT_PORT) {
-            client = new ERaSocket();
+            status = this->download<ERaSocket>(url, hash, type, downSize);
         }
         else {
 #if defined(ERA_OTA_SSL)
-            client = new ERaSocketSecure();
+            status = this->download<ERaSocketSecure>(url, hash, type, downSize);
 #else
             return;
 #endif
         }
-        if (client == nullptr) {
+        if (!status) {
             return;
         }
 
-        client->connect(this->getDomain(url).c_str(), this->getPort(url));
+        ::remove("era");
+        if (::rename(OTA_IMAGE_PATH, "era")) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Update failed"));
+            return;
+        }
 
-        client->print("GET ");
-        this->printURL(client, url);
-        client->print(" HTTP/1.1\r\n");
-        client->print("Host: ");
-        client->print(this->getDomain(url).c_str());
-        client->print("\r\n");
-        client->print("Connection: keep-alive\r\n\r\n");
+        ERA_LOG(TAG, ERA_PSTR("Update successfully. Rebooting!"));
+        ERaDelay(1000);
+        ERaRestart(true);
+        ERA_FORCE_UNUSED(root);
+    }
 
-        MillisTime_t timeout = ERaMillis();
-        while (client->connected() && !client->available()) {
-            ERaDelay(10);
-            if (!ERaRemainingTime(timeout, OTA_RESPONSE_TIMEOUT)) {
-                client->stop();
-                delete client;
-                ERA_LOG_ERROR(TAG, ERA_PSTR("Response timeout"));
-                return;
-            }
+private:
+    /* Download into era.bin, resuming after a dropped connection or a
+     * restart. True once the whole image is on disk and matches hash.
+     */
+    template <class Socket>
+    bool download(const char* url, const char* hash,
+                const char* type, size_t downSize) {
+        uint8_t* buf = (uint8_t*)ERA_MALLOC(ERA_OTA_LINUX_BUFFER_SIZE);
+        if (buf == nullptr) {
+            return false;
         }
+        Socket* client = new Socket();
+        if (client == nullptr) {
+            free(buf);
+            return false;
+        }
+
+        ERaOTADigest digest;
+        digest.select(hash);
+        OTAPart_t part {};
+        int fd {-1};
+        if (this->pHandler == nullptr) {
+            fd = this->openImage(url, hash, true, part, digest, buf);
+        }
+        bool status = ((fd >= 0) && part.total && (part.offset == part.total));
+
+        MillisTime_t startMillis = ERaMillis();
+        for (int retry = 0; !status && (retry <= ERA_OTA_MAX_RETRIES); ++retry) {
+            if ((this->pHandler == nullptr) && (fd < 0)) {
+                break;
+            }
+            if (!ERaRemainingTime(startMillis, OTA_DOWNLOAD_TIMEOUT)) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Download timeout"));
+                break;
+            }
+            if (part.offset) {
+                ERA_LOG(TAG, ERA_PSTR("Resume at %u/%u bytes"), (unsigned int)part.offset,
+                                                                (unsigned int)part.total);
+            }
 
-        while (client->available()) {
-            size_t pos {0};
-            char line[ERA_OTA_BUFFER_SIZE] {0};
+            OTAResponse_t rsp {};
+            if (!this->request(client, url, part.offset, rsp)) {
+                client->stop();
+                continue;
+            }
 
-            do {
-                char c = client->read();
-                if (c < 0) {
-                    continue;
+            if (fd < 0) {
+                if ((rsp.status == 200) && rsp.length &&
+                    this->pHandler->begin(client, rsp.length, hash, type, downSize)) {
+                    break;
                 }
-                else if ((c == '\n') ||
-                        (pos == sizeof(line))) {
+                fd = this->openImage(url, hash, false, part, digest, buf);
+                if (fd < 0) {
                     break;
                 }
-                line[pos++] = c;
-            } while (client->available());
+            }
 
-            char* pData = ERaFindStr(line, "Content-Length:");
-            if (pData != nullptr) {
-                pData += 15;
-                contentLength = atoi(pData);
+            if (rsp.status == 200) {
+                /* The server ignored the range, start over */
+                if (part.offset) {
+                    ERA_LOG_WARNING(TAG, ERA_PSTR("Range not supported, restart"));
+                    part.offset = 0;
+                    digest.begin();
+                    if (ftruncate(fd, 0)) {
+                        break;
+                    }
+                }
+                part.total = rsp.length;
             }
-            else if (!strlen(line) || (pos == 1)) {
+            else if ((rsp.status == 206) && (rsp.start == part.offset)) {
+                part.total = (rsp.total ? rsp.total : (part.offset + rsp.length));
+            }
+            else {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Unexpected response %d"), rsp.status);
                 break;
             }
-            ERaDelay(10);
-        }
+            if (!part.total) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Content-Length not defined"));
+                break;
+            }
+            if (!retry && (hash != nullptr)) {
+                ERA_LOG(TAG, ERA_PSTR("Expected %s: %s"), digest.name(), hash);
+            }
 
-        if (contentLength <= 0) {
+            status = this->receive(client, fd, part, digest, buf, startMillis);
             client->stop();
-            delete client;
-            ERA_LOG_ERROR(TAG, ERA_PSTR("Content-Length not defined"));
-            return;
+            this->saveProgress(fd, part);
         }
 
-        if ((this->pHandler != nullptr) &&
-            this->pHandler->begin(client, contentLength, hash, type, downSize)) {
-            client->stop();
-            delete client;
-            return;
+        client->stop();
+        delete client;
+        client = nullptr;
+        free(buf);
+        buf = nullptr;
+
+        /* No image when the handler took the download */
+        if (fd < 0) {
+            return false;
+        }
+        fdatasync(fd);
+        ::close(fd);
+        if (!status) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("OTA written %u/%u bytes"), (unsigned int)part.offset,
+                                                                    (unsigned int)part.total);
+            return false;
         }
 
+        /* Verify the hash, a mismatch is not worth resuming */
+        const char* hashLocal = digest.finalize();
+        ::remove(OTA_PART_PATH);
         if (hash != nullptr) {
-            ERA_LOG(TAG, ERA_PSTR("Expected MD5: %s"), hash);
+            if (!strcmp(hashLocal, hash)) {
+                ERA_LOG(TAG, ERA_PSTR("Verify match: %s"), hash);
+            }
+            else {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("No %s match: Local = %s, Target = %s"), digest.name(), hashLocal, hash);
+                ::remove(OTA_IMAGE_PATH);
+                return false;
+            }
         }
+        return true;
+    }
 
-        const char path[] = "era.bin";
-        int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0755);
-        if (fd < 0) {
-            client->stop();
-            delete client;
-            return;
+    /* Send the GET and read the response headers */
+    template <class Socket>
+    bool request(Socket* client, const char* url,
+                uint32_t offset, OTAResponse_t& rsp) {
+        if (!client->connect(this->getDomain(url).c_str(), this->getPort(url))) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Connect failed"));
+            return false;
         }
-        ::close(fd);
-        FILE* file = fopen(path, "wb");
-        if (file == nullptr) {
-            client->stop();
-            delete client;
-            return;
+
+        client->print("GET ");
+        this->printURL(client, url);
+        client->print(" HTTP/1.1\r\n");
+        client->print("Host: ");
+        client->print(this->getDomain(url).c_str());
+        client->print("\r\n");
+        if (offset) {
+            char range[40] {0};
+            snprintf(range, sizeof(range), "Range: bytes=%u-\r\n", (unsigned int)offset);
+            client->print(range);
         }
+        client->print("Connection: keep-alive\r\n\r\n");
 
-        MD5 md5;
-        md5.begin();
+        return this->readHeaders(client, rsp);
+    }
 
-        int written {0};
-        int prevPercentage {0};
-        uint8_t buf[ERA_OTA_BUFFER_SIZE] {0};
-        MillisTime_t startMillis = ERaMillis();
-        while (client->connected() && (written < contentLength)) {
-            ERaDelay(10);
-            timeout = ERaMillis();
-            while (client->connected() && !client->available()) {
-                ERaDelay(1);
-                if (!ERaRemainingTime(timeout, OTA_RESPONSE_TIMEOUT)) {
-                    ERA_LOG_ERROR(TAG, ERA_PSTR("Response timeout"));
-                    break;
+    /* Reads never go past the blank line, so the body stays in the socket
+     * for the handler. While m bytes of "\r\n\r\n" are matched, 4 - m bytes
+     * can be read safely.
+     */
+    template <class Socket>
+    bool readHeaders(Socket* client, OTAResponse_t& rsp) {
+        static const char terminator[] = "\r\n\r\n";
+        char header[OTA_HEADER_MAX_SIZE] {0};
+        size_t pos {0};
+        size_t matched {0};
+        MillisTime_t timeout = ERaMillis();
+        while (matched < 4) {
+            if (pos >= (sizeof(header) - 1)) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Response header too large"));
+                return false;
+            }
+            if ((client->selectRead(OTA_RESPONSE_TIMEOUT) <= 0) ||
+                !ERaRemainingTime(timeout, OTA_RESPONSE_TIMEOUT)) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Response timeout"));
+                return false;
+            }
+            size_t toRead = ERaMin((size_t)(4 - matched), (sizeof(header) - 1 - pos));
+            int len = client->read((uint8_t*)header + pos, toRead);
+            if (len < 0) {
+                return false;
+            }
+            for (int i = 0; i < len; ++i) {
+                char c = header[pos++];
+                if (c == terminator[matched]) {
+                    matched++;
                 }
+                else {
+                    matched = ((c == '\r') ? 1 : 0);
+                }
+            }
+        }
+        header[pos] = 0;
+
+        if (sscanf(header, "HTTP/%*d.%*d %d", &rsp.status) != 1) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Invalid response"));
+            return false;
+        }
+        char* pData = strcasestr(header, "Content-Length:");
+        if (pData != nullptr) {
+            rsp.length = (uint32_t)strtoul(pData + 15, nullptr, 10);
+        }
+        pData = strcasestr(header, "Content-Range:");
+        if (pData != nullptr) {
+            unsigned long start {0};
+            unsigned long end {0};
+            unsigned long total {0};
+            if (sscanf(pData + 14, " bytes %lu-%lu/%lu", &start, &end, &total) >= 2) {
+                rsp.start = (uint32_t)start;
+                rsp.total = (uint32_t)total;
             }
+        }
+        return true;
+    }
+
+    /* Wait for data instead of sleeping, hash it and write it straight
+     * from the receive buffer.
+     */
+    template <class Socket>
+    bool receive(Socket* client, int fd, OTAPart_t& part, ERaOTADigest& digest,
+                uint8_t* buf, MillisTime_t startMillis) {
+        uint32_t synced = part.offset;
+        int prevPercentage = (int)(((uint64_t)part.offset * 100) / part.total);
+        MillisTime_t timeout = ERaMillis();
+        while (part.offset < part.total) {
             if (!ERaRemainingTime(startMillis, OTA_DOWNLOAD_TIMEOUT)) {
                 ERA_LOG_ERROR(TAG, ERA_PSTR("Download timeout"));
-                break;
+                return false;
+            }
+            int rc = client->selectRead(OTA_RESPONSE_TIMEOUT);
+            if (rc < 0) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Connection lost"));
+                return false;
+            }
+            if (!rc || !ERaRemainingTime(timeout, OTA_RESPONSE_TIMEOUT)) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Response timeout"));
+                return false;
             }
 
-            int len = client->read(buf, sizeof(buf));
-            if (len <= 0) {
+            size_t toRead = ERaMin((size_t)(part.total - part.offset),
+                                    (size_t)ERA_OTA_LINUX_BUFFER_SIZE);
+            int len = client->read(buf, toRead);
+            if (len < 0) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Connection lost"));
+                return false;
+            }
+            if (!len) {
                 continue;
             }
+            timeout = ERaMillis();
 
-            md5.update(buf, len);
-            fwrite(buf, 1, len, file);
-            written += len;
+            if (!ERaOTA::writeAll(fd, buf, (size_t)len, part.offset)) {
+                ERA_LOG_ERROR(TAG, ERA_PSTR("Write failed (%d)"), errno);
+                return false;
+            }
+            digest.update(buf, len);
+            part.offset += (uint32_t)len;
 
-            const int percentage = (written * 100) / contentLength;
+            if ((part.offset - synced) >= ERA_OTA_SYNC_SIZE) {
+                this->saveProgress(fd, part);
+                synced = part.offset;
+            }
+
+            const int percentage = (int)(((uint64_t)part.offset * 100) / part.total);
             if ((percentage == 100) ||
                 (percentage - prevPercentage >= 10)) {
                 prevPercentage = percentage;
                 ERA_LOG(TAG, ERA_PSTR("Updating %d%%"), percentage);
             }
         }
+        return true;
+    }
 
-        fclose(file);
-        client->stop();
-        delete client;
-        client = nullptr;
+    /* Open era.bin, keeping what a previous try left of the same image.
+     * The digest state is not persisted, so the kept part is hashed again.
+     */
+    int openImage(const char* url, const char* hash, bool resume,
+                OTAPart_t& part, ERaOTADigest& digest, uint8_t* buf) {
+        int fd = ::open(OTA_IMAGE_PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0755);
+        if (fd < 0) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Open %s failed"), OTA_IMAGE_PATH);
+            return -1;
+        }
+
+        memset(&part, 0, sizeof(part));
+        part.magic = OTA_PART_MAGIC;
+        part.key = ERaOTA::imageKey(url, hash);
+        digest.begin();
+
+        OTAPart_t saved {};
+        struct stat st {};
+        if (resume &&
+            (this->flash.readFlash(OTA_PART_PATH, &saved, sizeof(saved)) == sizeof(saved)) &&
+            (saved.magic == part.magic) && (saved.key == part.key) &&
+            (saved.crc == CRC32::calculate((const uint8_t*)&saved, offsetof(OTAPart_t, crc))) &&
+            (saved.offset <= saved.total) &&
+            !fstat(fd, &st) && ((uint32_t)st.st_size >= saved.offset)) {
+            part = saved;
+        }
+        if (part.offset && !ERaOTA::hashImage(fd, part.offset, digest, buf)) {
+            part.offset = 0;
+            digest.begin();
+        }
+        if (ftruncate(fd, part.offset)) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
 
-        if (written != contentLength) {
-            ERA_LOG_ERROR(TAG, ERA_PSTR("OTA written %d/%d bytes"), written, contentLength);
+    /* Data first, then the offset that vouches for it */
+    void saveProgress(int fd, OTAPart_t& part) {
+        if ((fd < 0) || !part.total) {
             return;
         }
+        fdatasync(fd);
+        part.crc = CRC32::calculate((const uint8_t*)&part, offsetof(OTAPart_t, crc));
+        this->flash.writeFlash(OTA_PART_PATH, &part, sizeof(part));
+    }
 
-        /* Verify md5 */
-        const char* md5Local = md5.finalize();
-        if (hash != nullptr) {
-            if (!strcmp(md5Local, hash)) {
-                ERA_LOG(TAG, ERA_PSTR("Verify match: %s"), hash);
+    static bool hashImage(int fd, uint32_t size, ERaOTADigest& digest, uint8_t* buf) {
+        uint32_t offset {0};
+        while (offset < size) {
+            size_t toRead = ERaMin((size_t)(size - offset), (size_t)ERA_OTA_LINUX_BUFFER_SIZE);
+            ssize_t len = pread(fd, buf, toRead, offset);
+            if ((len < 0) && (errno == EINTR)) {
+                continue;
             }
-            else {
-                ERA_LOG_ERROR(TAG, ERA_PSTR("No MD5 match: Local = %s, Target = %s"), md5Local, hash);
-                return;
+            if (len <= 0) {
+                return false;
             }
+            digest.update(buf, (size_t)len);
+            offset += (uint32_t)len;
         }
+        return true;
+    }
 
-        ::remove("era");
-        if (::rename(path, "era")) {
-            ERA_LOG_ERROR(TAG, ERA_PSTR("Update failed"));
-            return;
+    static bool writeAll(int fd, const uint8_t* buf, size_t size, uint32_t offset) {
+        size_t pos {0};
+        while (pos < size) {
+            ssize_t ret = pwrite(fd, buf + pos, size - pos, offset + pos);
+            if ((ret < 0) && (errno == EINTR)) {
+                continue;
+            }
+            if (ret <= 0) {
+                return false;
+            }
+            pos += (size_t)ret;
         }
+        return true;
+    }
 
-        ERA_LOG(TAG, ERA_PSTR("Update successfully. Rebooting!"));
-        ERaDelay(1000);
-        ERaRestart(true);
-        ERA_FORCE_UNUSED(root);
+    static uint32_t imageKey(const char* url, const char* hash) {
+        CRC32 crc;
+        crc.update(url, strlen(url));
+        if (hash != nullptr) {
+            crc.update(hash, strlen(hash));
+        }
+        return crc.finalize();
     }
 
-private:
     void printURL(Client* client, const char* url) {
         size_t sent {0};
         size_t toSend {0};
@@ -1,23 +1,56 @@
 #ifndef INC_ERA_FLASH_LINUX_HPP_
 #define INC_ERA_FLASH_LINUX_HPP_
 
+#include <stdio.h>
 #include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
+#if !defined(ERA_FLASH_BATCH_MAX)
+    #define ERA_FLASH_BATCH_MAX     8
+#endif
+
+#define ERA_FLASH_PATH_MAX          256
+#define ERA_FLASH_TEMP_SUFFIX       ".tmp"
+#define ERA_FLASH_FILE_MODE         0644
+
+/* Files are replaced atomically: the data goes to "<name>.tmp", is synced,
+ * renamed over the old file and the directory entry is synced.
+ * Between beginBatch() and commitBatch() the renames are deferred, so all
+ * new data is on disk before any file of the batch is replaced.
+ * Reads map the file, readLine(length) and mapFlash() return views into it.
+ */
 class ERaFlashLinux
 {
     const char* TAG = "Flash";
 public:
     ERaFlashLinux()
         : file(nullptr)
+        , map(nullptr)
+        , mapSize(0)
+        , mapPos(0)
+        , writeName {0}
+        , pending {}
+        , numPending(0)
+        , batch(0)
     {}
     ~ERaFlashLinux()
-    {}
+    {
+        this->endRead();
+        this->endWrite();
+        this->batch = 0;
+        this->commitPending();
+    }
 
     void begin();
     void end();
     void beginRead(const char* filename);
     char* readLine();
+    const char* readLine(size_t& length);
     void endRead();
     void beginWrite(const char* filename);
     void writeLine(const char* buf);
@@ -25,13 +58,35 @@ public:
     char* readFlash(const char* filename);
     size_t readFlash(const char* key, void* buf, size_t maxLen);
     void writeFlash(const char *filename, const char* buf);
-    size_t writeFlash(const char* key, const void* value, size_t len);
+    size_t writeFlash(const char* key, const void* value, size_t len,
+                    mode_t mode = ERA_FLASH_FILE_MODE);
+    const char* mapFlash(const char* filename, size_t& size);
+    void unmapFlash(const char* data, size_t size);
+    void beginBatch();
+    bool commitBatch();
 
 protected:
 private:
+    ERaFlashLinux(const ERaFlashLinux&);
+    ERaFlashLinux& operator = (const ERaFlashLinux&);
+
+    bool writeFile(const char* filename, const void* data, size_t len,
+                mode_t mode = ERA_FLASH_FILE_MODE);
+    bool replaceFile(const char* filename);
+    bool commitPending();
     void mkdir(const char* path);
 
+    static bool tempName(char* temp, size_t size, const char* filename);
+    static void syncDir(const char* filename);
+
     FILE* file;
+    char* map;
+    size_t mapSize;
+    size_t mapPos;
+    char writeName[ERA_FLASH_PATH_MAX];
+    char pending[ERA_FLASH_BATCH_MAX][ERA_FLASH_PATH_MAX];
+    size_t numPending;
+    uint8_t batch;
 };
 
 inline
@@ -45,61 +100,67 @@ void ERaFlashLinux::end() {
 inline
 void ERaFlashLinux::beginRead(const char* filename) {
     this->endRead();
-    this->file = fopen(filename, "r");
+    this->map = (char*)this->mapFlash(filename, this->mapSize);
+    this->mapPos = 0;
 }
 
+/* Caller frees the line */
 inline
 char* ERaFlashLinux::readLine() {
-    if (this->file == nullptr) {
+    size_t length {0};
+    const char* line = this->readLine(length);
+    if (line == nullptr) {
         return nullptr;
     }
-    int c {0};
-    size_t pos {0};
-    size_t size = 1024;
-    char* buffer = (char*)ERA_MALLOC(size);
+    char* buffer = (char*)ERA_MALLOC(length + 1);
     if (buffer == nullptr) {
         return nullptr;
     }
-    do {
-        c = fgetc(this->file);
-        if ((c != EOF) && (c != '\n')) {
-            buffer[pos++] = (char)c;
-        }
-        if (pos >= size - 1) {
-            size += size;
-            char* copy = (char*)ERA_REALLOC(buffer, size);
-            if (copy == nullptr) {
-                free(buffer);
-                buffer = nullptr;
-                return nullptr;
-            }
-            buffer = copy;
-        }
-    } while ((c != EOF) && (c != '\n'));
-    buffer[pos] = 0;
-    if (!pos) {
-        free(buffer);
-        buffer = nullptr;
-    }
+    memcpy(buffer, line, length);
+    buffer[length] = 0;
     return buffer;
 }
 
+/* View of the next line without '\n', valid until endRead() */
 inline
-void ERaFlashLinux::endRead() {
-    if (this->file == nullptr) {
-        return;
+const char* ERaFlashLinux::readLine(size_t& length) {
+    length = 0;
+    if ((this->map == nullptr) || (this->mapPos >= this->mapSize)) {
+        return nullptr;
     }
-    fclose(this->file);
-    this->file = nullptr;
+    const char* start = this->map + this->mapPos;
+    size_t remain = this->mapSize - this->mapPos;
+    const char* end = (const char*)memchr(start, '\n', remain);
+    length = ((end != nullptr) ? (size_t)(end - start) : remain);
+    this->mapPos += length + ((end != nullptr) ? 1 : 0);
+    if (!length) {
+        return nullptr;
+    }
+    return start;
+}
+
+inline
+void ERaFlashLinux::endRead() {
+    this->unmapFlash(this->map, this->mapSize);
+    this->map = nullptr;
+    this->mapSize = 0;
+    this->mapPos = 0;
 }
 
 inline
 void ERaFlashLinux::beginWrite(const char* filename) {
     this->endWrite();
-    this->file = fopen(filename, "w");
+    char temp[ERA_FLASH_PATH_MAX] {0};
+    if (!ERaFlashLinux::tempName(temp, sizeof(temp), filename)) {
+        return;
+    }
+    this->file = fopen(temp, "w");
     if (this->file == nullptr) {
         this->mkdir(filename);
-        this->file = fopen(filename, "w");
+        this->file = fopen(temp, "w");
+    }
+    if (this->file != nullptr) {
+        snprintf(this->writeName, sizeof(this->writeName), "%s", filename);
     }
 }
 
@@ -111,7 +172,8 @@ void ERaFlashLinux::writeLine(const char* buf) {
     if (this->file == nullptr) {
         return;
     }
-    fprintf(this->file, "%s\n", buf);
+    fputs(buf, this->file);
+    fputc('\n', this->file);
 }
 
 inline
@@ -119,31 +181,35 @@ void ERaFlashLinux::endWrite() {
     if (this->file == nullptr) {
         return;
     }
-    fclose(this->file);
+    bool status = !fflush(this->file);
+    status = (!fsync(fileno(this->file)) && status);
+    status = (!fclose(this->file) && status);
     this->file = nullptr;
+    if (status) {
+        this->replaceFile(this->writeName);
+    }
+    else {
+        ERA_LOG_ERROR(TAG, ERA_PSTR("Write %s failed"), this->writeName);
+    }
+    this->writeName[0] = 0;
 }
 
 inline
 char* ERaFlashLinux::readFlash(const char* filename) {
-    FILE* _file = fopen(filename, "r");
-    if (_file == nullptr) {
+    size_t size {0};
+    const char* data = this->mapFlash(filename, size);
+    if (data == nullptr) {
         return nullptr;
     }
-    fseek(_file, 0L, SEEK_END);
-    size_t size = ftell(_file);
-    fseek(_file, 0L, SEEK_SET);
-    if (!size) {
-        fclose(_file);
-        return nullptr;
-    }
-    char* buf = (char*)ERA_MALLOC(size + 1);
-    if (buf == nullptr) {
-        fclose(_file);
-        return nullptr;
+    /* Only the first line, newline included, as fgets returned it */
+    const char* eol = (const char*)memchr(data, '\n', size);
+    size_t length = ((eol != nullptr) ? (size_t)(eol - data + 1) : size);
+    char* buf = (char*)ERA_MALLOC(length + 1);
+    if (buf != nullptr) {
+        memcpy(buf, data, length);
+        buf[length] = '\0';
     }
-    buf[size] = '\0';
-    fgets(buf, size + 1, _file);
-    fclose(_file);
+    this->unmapFlash(data, size);
     return buf;
 }
 
@@ -152,13 +218,23 @@ size_t ERaFlashLinux::readFlash(const char* key, void* buf, size_t maxLen) {
     if (buf == nullptr) {
         return 0;
     }
-    FILE* _file = fopen(key, "rb");
-    if (_file == nullptr) {
+    int fd = open(key, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
         return 0;
     }
-    fread(buf, maxLen, 1, _file);
-    fclose(_file);
-    return maxLen;
+    size_t pos {0};
+    while (pos < maxLen) {
+        ssize_t ret = read(fd, (uint8_t*)buf + pos, maxLen - pos);
+        if ((ret < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        pos += (size_t)ret;
+    }
+    close(fd);
+    return pos;
 }
 
 inline
@@ -166,34 +242,169 @@ void ERaFlashLinux::writeFlash(const char *filename, const char* buf) {
     if (buf == nullptr) {
         return;
     }
-    FILE* _file = fopen(filename, "w");
-    if (_file == nullptr) {
+    this->writeFile(filename, buf, strlen(buf));
+}
+
+/* mode applies from the temp file on, secrets are never readable by others */
+inline
+size_t ERaFlashLinux::writeFlash(const char* key, const void* value, size_t len,
+                                mode_t mode) {
+    if (value == nullptr) {
+        return 0;
+    }
+    return (this->writeFile(key, value, len, mode) ? len : 0);
+}
+
+/* Read-only view of the whole file, nullptr if missing or empty.
+ * Release with unmapFlash().
+ */
+inline
+const char* ERaFlashLinux::mapFlash(const char* filename, size_t& size) {
+    size = 0;
+    if (filename == nullptr) {
+        return nullptr;
+    }
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) || (st.st_size <= 0)) {
+        close(fd);
+        return nullptr;
+    }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    size = (size_t)st.st_size;
+    return (const char*)data;
+}
+
+inline
+void ERaFlashLinux::unmapFlash(const char* data, size_t size) {
+    if ((data == nullptr) || !size) {
+        return;
+    }
+    munmap((void*)data, size);
+}
+
+/* Batches nest, the outermost commitBatch() replaces the files */
+inline
+void ERaFlashLinux::beginBatch() {
+    this->batch++;
+}
+
+inline
+bool ERaFlashLinux::commitBatch() {
+    if (!this->batch) {
+        return false;
+    }
+    if (--this->batch) {
+        return true;
+    }
+    return this->commitPending();
+}
+
+inline
+bool ERaFlashLinux::writeFile(const char* filename, const void* data, size_t len,
+                            mode_t mode) {
+    char temp[ERA_FLASH_PATH_MAX] {0};
+    if (!ERaFlashLinux::tempName(temp, sizeof(temp), filename)) {
+        return false;
+    }
+    int fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+    if ((fd < 0) && (errno == ENOENT)) {
         this->mkdir(filename);
-        _file = fopen(filename, "w");
-        if (_file == nullptr) {
-            return;
+        fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+    }
+    if (fd < 0) {
+        ERA_LOG_ERROR(TAG, ERA_PSTR("Open %s failed"), temp);
+        return false;
+    }
+    /* A temp file left by an earlier run keeps its old mode */
+    if (fchmod(fd, mode)) {
+        ERA_LOG_ERROR(TAG, ERA_PSTR("Chmod %s failed"), temp);
+        close(fd);
+        unlink(temp);
+        return false;
+    }
+    size_t pos {0};
+    while (pos < len) {
+        ssize_t ret = write(fd, (const uint8_t*)data + pos, len - pos);
+        if ((ret < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
         }
+        pos += (size_t)ret;
     }
-    fprintf(_file, "%s", buf);
-    fclose(_file);
+    bool status = ((pos == len) && !fsync(fd));
+    status = (!close(fd) && status);
+    if (!status) {
+        ERA_LOG_ERROR(TAG, ERA_PSTR("Write %s failed"), filename);
+        unlink(temp);
+        return false;
+    }
+    return this->replaceFile(filename);
 }
 
+/* Rename the synced temp file over filename, or defer it in a batch */
 inline
-size_t ERaFlashLinux::writeFlash(const char* key, const void* value, size_t len) {
-    if (value == nullptr) {
-        return 0;
+bool ERaFlashLinux::replaceFile(const char* filename) {
+    if (this->batch) {
+        for (size_t i = 0; i < this->numPending; ++i) {
+            if (!strcmp(this->pending[i], filename)) {
+                return true;
+            }
+        }
+        if (this->numPending >= ERA_FLASH_BATCH_MAX) {
+            this->commitPending();
+        }
+        snprintf(this->pending[this->numPending++], ERA_FLASH_PATH_MAX, "%s", filename);
+        return true;
+    }
+    char temp[ERA_FLASH_PATH_MAX] {0};
+    ERaFlashLinux::tempName(temp, sizeof(temp), filename);
+    if (rename(temp, filename)) {
+        ERA_LOG_ERROR(TAG, ERA_PSTR("Rename %s failed"), filename);
+        unlink(temp);
+        return false;
     }
-    FILE* _file = fopen(key, "wb");
-    if (_file == nullptr) {
-        this->mkdir(key);
-        _file = fopen(key, "wb");
-        if (_file == nullptr) {
-            return 0;
+    ERaFlashLinux::syncDir(filename);
+    return true;
+}
+
+inline
+bool ERaFlashLinux::commitPending() {
+    bool status {true};
+    char temp[ERA_FLASH_PATH_MAX] {0};
+    for (size_t i = 0; i < this->numPending; ++i) {
+        ERaFlashLinux::tempName(temp, sizeof(temp), this->pending[i]);
+        if (rename(temp, this->pending[i])) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Rename %s failed"), this->pending[i]);
+            unlink(temp);
+            status = false;
+        }
+    }
+    /* One sync per directory */
+    for (size_t i = 0; i < this->numPending; ++i) {
+        const char* dir = strrchr(this->pending[i], '/');
+        size_t len = ((dir != nullptr) ? (size_t)(dir - this->pending[i]) : 0);
+        bool synced {false};
+        for (size_t j = 0; (j < i) && !synced; ++j) {
+            const char* other = strrchr(this->pending[j], '/');
+            size_t otherLen = ((other != nullptr) ? (size_t)(other - this->pending[j]) : 0);
+            synced = ((len == otherLen) && !strncmp(this->pending[i], this->pending[j], len));
+        }
+        if (!synced) {
+            ERaFlashLinux::syncDir(this->pending[i]);
         }
     }
-    fwrite(value, 1, len, _file);
-    fclose(_file);
-    return len;
+    this->numPending = 0;
+    return status;
 }
 
 inline
@@ -222,6 +433,37 @@ void ERaFlashLinux::mkdir(const char* path) {
     }
 }
 
+inline
+bool ERaFlashLinux::tempName(char* temp, size_t size, const char* filename) {
+    if (filename == nullptr) {
+        return false;
+    }
+    int len = snprintf(temp, size, "%s" ERA_FLASH_TEMP_SUFFIX, filename);
+    return ((len > 0) && ((size_t)len < size));
+}
+
+/* Make a rename durable */
+inline
+void ERaFlashLinux::syncDir(const char* filename) {
+    char dir[ERA_FLASH_PATH_MAX] {0};
+    const char* slash = strrchr(filename, '/');
+    if (slash == nullptr) {
+        snprintf(dir, sizeof(dir), ".");
+    }
+    else if (slash == filename) {
+        snprintf(dir, sizeof(dir), "/");
+    }
+    else {
+        snprintf(dir, sizeof(dir), "%.*s", (int)(slash - filename), filename);
+    }
+    int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    fsync(fd);
+    close(fd);
+}
+
 typedef ERaFlashLinux ERaFlash;
 
 #endif /* INC_ERA_FLASH_LINUX_HPP_ */
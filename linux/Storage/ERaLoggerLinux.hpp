@@ -0,0 +1,580 @@
+#ifndef INC_ERA_LOGGER_LINUX_HPP_
+#define INC_ERA_LOGGER_LINUX_HPP_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <ERa/ERaLogger.hpp>
+#include <Utility/CRC32.hpp>
+#include <Utility/ERaUtility.hpp>
+#include <Storage/ERaFlashLinux.hpp>
+
+#if !defined(ERA_JOURNAL_SEGMENT_SIZE)
+    #define ERA_JOURNAL_SEGMENT_SIZE        (64UL * 1024UL)
+#endif
+
+/* Disk quota, the oldest segments are dropped beyond it */
+#if !defined(ERA_JOURNAL_MAX_SIZE)
+    #define ERA_JOURNAL_MAX_SIZE            (1024UL * 1024UL)
+#endif
+
+#if !defined(ERA_JOURNAL_MAX_RECORD)
+    #define ERA_JOURNAL_MAX_RECORD          (16UL * 1024UL)
+#endif
+
+/* Replay pace: records per interval */
+#if !defined(ERA_JOURNAL_REPLAY_BURST)
+    #define ERA_JOURNAL_REPLAY_BURST        10
+#endif
+
+#if !defined(ERA_JOURNAL_REPLAY_INTERVAL)
+    #define ERA_JOURNAL_REPLAY_INTERVAL     1000UL
+#endif
+
+#if !defined(ERA_JOURNAL_SYNC_INTERVAL)
+    #define ERA_JOURNAL_SYNC_INTERVAL       1000UL
+#endif
+
+#define ERA_JOURNAL_MAGIC                   0x4C4E524BUL
+
+/* Store-and-forward journal of readings that failed to publish.
+ * Records (header with the capture time, "subPath\0id\0data\0") are
+ * appended to numbered segment files and checked with a CRC, a torn tail
+ * is cut at begin(). run() replays them in order through the replay
+ * callback, the cursor is kept in "journal.pos" and replayed segments
+ * are deleted.
+ * Delivery is at least once.
+ */
+class ERaLoggerLinux
+    : public ERaLogger
+{
+    const char* TAG = "Journal";
+
+    typedef struct __Header_t {
+        uint32_t magic;
+        uint32_t crc;
+        uint32_t time;
+        uint16_t subLen;
+        uint16_t idLen;
+        uint32_t dataLen;
+    } Header_t;
+
+    typedef struct __Cursor_t {
+        uint32_t segment;
+        uint32_t offset;
+        uint32_t crc;
+    } Cursor_t;
+
+public:
+    ERaLoggerLinux(ERaTime& _time)
+        : ERaLogger(_time)
+        , initialized(false)
+        , fd(-1)
+        , firstSeg(0)
+        , lastSeg(0)
+        , lastSize(0)
+        , totalSize(0)
+        , readSeg(0)
+        , readOff(0)
+        , dirty(false)
+        , prevSync(0)
+        , prevReplay(0)
+        , mutex(NULL)
+    {}
+    ~ERaLoggerLinux()
+    {
+        this->sync();
+        this->closeSegment();
+    }
+
+    void begin() override {
+        ERaGuardLock(this->mutex);
+        if (!this->initialized) {
+            this->initialized = this->open();
+        }
+        /* Replay right after a reconnect */
+        this->prevReplay = ERaMillis() - ERA_JOURNAL_REPLAY_INTERVAL;
+        ERaGuardUnlock(this->mutex);
+    }
+
+    void run() override {
+        if (!this->initialized) {
+            return;
+        }
+        ERaGuardLock(this->mutex);
+        if (this->dirty && !ERaRemainingTime(this->prevSync, ERA_JOURNAL_SYNC_INTERVAL)) {
+            this->sync();
+        }
+        ERaGuardUnlock(this->mutex);
+        if (ERaRemainingTime(this->prevReplay, ERA_JOURNAL_REPLAY_INTERVAL)) {
+            return;
+        }
+        this->prevReplay = ERaMillis();
+        size_t count {0};
+        while ((count < ERA_JOURNAL_REPLAY_BURST) && this->replayNext()) {
+            count++;
+        }
+        if (!count) {
+            return;
+        }
+        /* Once per burst, a crash resends at most one burst */
+        ERaGuardLock(this->mutex);
+        while (this->firstSeg < this->readSeg) {
+            this->removeFirst();
+        }
+        this->saveCursor();
+        ERaGuardUnlock(this->mutex);
+    }
+
+    /* Only readings that failed to publish are kept */
+    void put(const char* subPath, const char* id,
+            const char* data, bool status, bool force = false) override {
+        ERA_FORCE_UNUSED(force);
+        if (status || (data == nullptr)) {
+            return;
+        }
+        ERaGuardLock(this->mutex);
+        if (!this->initialized) {
+            this->initialized = this->open();
+        }
+        if (this->initialized) {
+            this->append(subPath, id, data);
+        }
+        ERaGuardUnlock(this->mutex);
+    }
+
+    /* Latest unsent data of subPath/id, caller frees it */
+    char* get(const char* subPath, const char* id) override {
+        char* found = nullptr;
+        ERaGuardLock(this->mutex);
+        uint32_t segment = this->readSeg;
+        uint32_t offset = this->readOff;
+        char* record = nullptr;
+        const char* sub = nullptr;
+        const char* rid = nullptr;
+        const char* data = nullptr;
+        while (this->initialized &&
+               this->readRecord(segment, offset, record, sub, rid, data)) {
+            if (ERaStrCmp(sub, (subPath != nullptr) ? subPath : "") &&
+                ERaStrCmp(rid, (id != nullptr) ? id : "")) {
+                free(found);
+                found = ERaStrdup(data);
+            }
+            free(record);
+            record = nullptr;
+        }
+        ERaGuardUnlock(this->mutex);
+        return found;
+    }
+
+    /* Bytes held on disk */
+    size_t pending() const {
+        return this->totalSize;
+    }
+
+protected:
+private:
+    bool open() {
+        this->makePath(this->path, sizeof(this->path), "journal.pos");
+        if (!this->scan()) {
+            return false;
+        }
+        this->loadCursor();
+        this->recover();
+        if (!this->openSegment()) {
+            return false;
+        }
+        this->enforceQuota();
+        ERA_LOG(TAG, ERA_PSTR("Journal %u-%u, %u bytes"),
+                (unsigned int)this->firstSeg, (unsigned int)this->lastSeg,
+                (unsigned int)this->totalSize);
+        return true;
+    }
+
+    /* Find the segment range and its size */
+    bool scan() {
+        ERaLoggerLinux::makeDir(this->dirLogger);
+        DIR* dir = opendir(this->dirLogger);
+        if (dir == nullptr) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Open %s failed"), this->dirLogger);
+            return false;
+        }
+        bool found {false};
+        struct dirent* entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr) {
+            unsigned long segment {0};
+            char tail {0};
+            if (sscanf(entry->d_name, "journal-%lu.lo%c", &segment, &tail) != 2) {
+                continue;
+            }
+            if (!found || (segment < this->firstSeg)) {
+                this->firstSeg = (uint32_t)segment;
+            }
+            if (!found || (segment > this->lastSeg)) {
+                this->lastSeg = (uint32_t)segment;
+            }
+            found = true;
+        }
+        closedir(dir);
+        this->totalSize = 0;
+        for (uint32_t i = this->firstSeg; found && (i <= this->lastSeg); ++i) {
+            this->totalSize += this->segmentSize(i);
+        }
+        this->readSeg = this->firstSeg;
+        this->readOff = 0;
+        return true;
+    }
+
+    void loadCursor() {
+        Cursor_t cursor {};
+        if (this->flash.readFlash(this->path, &cursor, sizeof(cursor)) != sizeof(cursor)) {
+            return;
+        }
+        if (cursor.crc != CRC32::calculate((const uint8_t*)&cursor, offsetof(Cursor_t, crc))) {
+            return;
+        }
+        if ((cursor.segment < this->firstSeg) || (cursor.segment > this->lastSeg)) {
+            return;
+        }
+        this->readSeg = cursor.segment;
+        this->readOff = cursor.offset;
+    }
+
+    void saveCursor() {
+        Cursor_t cursor {};
+        cursor.segment = this->readSeg;
+        cursor.offset = this->readOff;
+        cursor.crc = CRC32::calculate((const uint8_t*)&cursor, offsetof(Cursor_t, crc));
+        this->flash.writeFlash(this->path, &cursor, sizeof(cursor));
+    }
+
+    /* Cut the last segment after its last valid record */
+    void recover() {
+        uint32_t offset {0};
+        uint32_t size = this->segmentSize(this->lastSeg);
+        char* record = nullptr;
+        const char* sub = nullptr;
+        const char* id = nullptr;
+        const char* data = nullptr;
+        uint32_t segment = this->lastSeg;
+        while ((segment == this->lastSeg) &&
+               this->readRecord(segment, offset, record, sub, id, data)) {
+            free(record);
+            record = nullptr;
+        }
+        if ((segment == this->lastSeg) && (offset < size)) {
+            char name[LOGGER_MAX_PATH_LENGTH] {0};
+            this->segmentName(name, sizeof(name), this->lastSeg);
+            if (!truncate(name, offset)) {
+                this->totalSize -= (size - offset);
+            }
+            ERA_LOG_WARNING(TAG, ERA_PSTR("Dropped %u torn bytes"), (unsigned int)(size - offset));
+        }
+        if ((this->readSeg == this->lastSeg) && (this->readOff > offset)) {
+            this->readOff = offset;
+        }
+    }
+
+    bool openSegment() {
+        char name[LOGGER_MAX_PATH_LENGTH] {0};
+        this->segmentName(name, sizeof(name), this->lastSeg);
+        this->fd = ::open(name, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (this->fd < 0) {
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Open %s failed"), name);
+            return false;
+        }
+        struct stat st {};
+        this->lastSize = (!fstat(this->fd, &st) ? (uint32_t)st.st_size : 0);
+        return true;
+    }
+
+    void closeSegment() {
+        if (this->fd < 0) {
+            return;
+        }
+        ::close(this->fd);
+        this->fd = -1;
+    }
+
+    bool rotate() {
+        this->sync();
+        this->closeSegment();
+        this->lastSeg++;
+        return this->openSegment();
+    }
+
+    void sync() {
+        if (!this->dirty || (this->fd < 0)) {
+            return;
+        }
+        fdatasync(this->fd);
+        this->dirty = false;
+        this->prevSync = ERaMillis();
+    }
+
+    void append(const char* subPath, const char* id, const char* data) {
+        if (subPath == nullptr) {
+            subPath = "";
+        }
+        if (id == nullptr) {
+            id = "";
+        }
+        Header_t header {};
+        header.magic = ERA_JOURNAL_MAGIC;
+        header.time = (uint32_t)this->time.now();
+        header.subLen = (uint16_t)strlen(subPath);
+        header.idLen = (uint16_t)strlen(id);
+        header.dataLen = (uint32_t)strlen(data);
+        size_t length = ERaLoggerLinux::payloadSize(header);
+        if (length > ERA_JOURNAL_MAX_RECORD) {
+            ERA_LOG_WARNING(TAG, ERA_PSTR("Record too large (%u)"), (unsigned int)length);
+            return;
+        }
+        struct iovec iov[4] {};
+        iov[0].iov_base = (void*)&header;
+        iov[0].iov_len = sizeof(header);
+        iov[1].iov_base = (void*)subPath;
+        iov[1].iov_len = header.subLen + 1;
+        iov[2].iov_base = (void*)id;
+        iov[2].iov_len = header.idLen + 1;
+        iov[3].iov_base = (void*)data;
+        iov[3].iov_len = header.dataLen + 1;
+        header.crc = ERaLoggerLinux::checksum(header, iov + 1, 3);
+        length += sizeof(header);
+        if (this->lastSize && ((this->lastSize + length) > ERA_JOURNAL_SEGMENT_SIZE)) {
+            if (!this->rotate()) {
+                return;
+            }
+        }
+        ssize_t ret = writev(this->fd, iov, 4);
+        if (ret != (ssize_t)length) {
+            /* Drop a partial record so the next one starts clean */
+            if (ret > 0) {
+                ftruncate(this->fd, this->lastSize);
+            }
+            ERA_LOG_ERROR(TAG, ERA_PSTR("Append failed (%d)"), errno);
+            return;
+        }
+        this->lastSize += length;
+        this->totalSize += length;
+        this->dirty = true;
+        this->enforceQuota();
+    }
+
+    /* Drop the oldest segments, unsent or not, to stay within quota */
+    void enforceQuota() {
+        while ((this->totalSize > ERA_JOURNAL_MAX_SIZE) && (this->firstSeg < this->lastSeg)) {
+            if (this->readSeg == this->firstSeg) {
+                ERA_LOG_WARNING(TAG, ERA_PSTR("Quota reached, dropped segment %u"),
+                                (unsigned int)this->firstSeg);
+            }
+            this->removeFirst();
+        }
+    }
+
+    void removeFirst() {
+        char name[LOGGER_MAX_PATH_LENGTH] {0};
+        this->segmentName(name, sizeof(name), this->firstSeg);
+        uint32_t size = this->segmentSize(this->firstSeg);
+        unlink(name);
+        this->totalSize -= ERaMin((size_t)size, this->totalSize);
+        if (this->readSeg == this->firstSeg) {
+            this->readSeg++;
+            this->readOff = 0;
+        }
+        this->firstSeg++;
+    }
+
+    /* Publish one record, false when there is nothing to send or it failed */
+    bool replayNext() {
+        char* record = nullptr;
+        const char* sub = nullptr;
+        const char* id = nullptr;
+        const char* data = nullptr;
+        ERaGuardLock(this->mutex);
+        uint32_t segment = this->readSeg;
+        uint32_t offset = this->readOff;
+        bool found = this->readRecord(segment, offset, record, sub, id, data);
+        if (!found) {
+            this->compact();
+        }
+        ERaGuardUnlock(this->mutex);
+        if (!found) {
+            return false;
+        }
+        bool status = this->replay(sub, id, data, ((const Header_t*)record)->time);
+        free(record);
+        record = nullptr;
+        if (!status) {
+            return false;
+        }
+        ERaGuardLock(this->mutex);
+        /* Quota may have moved the cursor meanwhile */
+        if (this->readSeg <= segment) {
+            this->readSeg = segment;
+            this->readOff = offset;
+        }
+        ERaGuardUnlock(this->mutex);
+        return true;
+    }
+
+    /* Everything sent: delete the replayed segments and restart empty */
+    void compact() {
+        if ((this->readSeg != this->lastSeg) ||
+            (this->readOff < this->lastSize) ||
+            !this->lastSize) {
+            return;
+        }
+        while (this->firstSeg < this->lastSeg) {
+            this->removeFirst();
+        }
+        if (ftruncate(this->fd, 0)) {
+            return;
+        }
+        this->totalSize = 0;
+        this->lastSize = 0;
+        this->readSeg = this->lastSeg;
+        this->readOff = 0;
+        this->saveCursor();
+    }
+
+    /* Read the record at segment/offset and advance past it.
+     * Moves on to the next segment at the end of one or on a bad record.
+     */
+    bool readRecord(uint32_t& segment, uint32_t& offset, char*& record,
+                    const char*& sub, const char*& id, const char*& data) {
+        for (; segment <= this->lastSeg; ++segment, offset = 0) {
+            char name[LOGGER_MAX_PATH_LENGTH] {0};
+            this->segmentName(name, sizeof(name), segment);
+            int rfd = ::open(name, O_RDONLY | O_CLOEXEC);
+            if (rfd < 0) {
+                if (segment == this->lastSeg) {
+                    return false;
+                }
+                continue;
+            }
+            bool found = this->readRecord(rfd, offset, record);
+            ::close(rfd);
+            if (found) {
+                Header_t* header = (Header_t*)record;
+                sub = record + sizeof(Header_t);
+                id = sub + header->subLen + 1;
+                data = id + header->idLen + 1;
+                return true;
+            }
+            if (segment == this->lastSeg) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    bool readRecord(int rfd, uint32_t& offset, char*& record) {
+        Header_t header {};
+        if (pread(rfd, &header, sizeof(header), offset) != (ssize_t)sizeof(header)) {
+            return false;
+        }
+        size_t length = ERaLoggerLinux::payloadSize(header);
+        if ((header.magic != ERA_JOURNAL_MAGIC) || (length > ERA_JOURNAL_MAX_RECORD)) {
+            return false;
+        }
+        record = (char*)ERA_MALLOC(sizeof(header) + length);
+        if (record == nullptr) {
+            return false;
+        }
+        char* payload = record + sizeof(header);
+        if (pread(rfd, payload, length, offset + sizeof(header)) != (ssize_t)length) {
+            free(record);
+            record = nullptr;
+            return false;
+        }
+        struct iovec iov {};
+        iov.iov_base = payload;
+        iov.iov_len = length;
+        char* sub = payload;
+        char* id = sub + header.subLen + 1;
+        char* data = id + header.idLen + 1;
+        if ((header.crc != ERaLoggerLinux::checksum(header, &iov, 1)) ||
+            sub[header.subLen] || id[header.idLen] || data[header.dataLen]) {
+            free(record);
+            record = nullptr;
+            return false;
+        }
+        memcpy(record, &header, sizeof(header));
+        offset += (uint32_t)(sizeof(header) + length);
+        return true;
+    }
+
+    uint32_t segmentSize(uint32_t segment) {
+        char name[LOGGER_MAX_PATH_LENGTH] {0};
+        this->segmentName(name, sizeof(name), segment);
+        struct stat st {};
+        if (stat(name, &st)) {
+            return 0;
+        }
+        return (uint32_t)st.st_size;
+    }
+
+    void segmentName(char* name, size_t size, uint32_t segment) {
+        char file[32] {0};
+        snprintf(file, sizeof(file), "journal-%08u.log", (unsigned int)segment);
+        this->makePath(name, size, file);
+    }
+
+    static void makeDir(const char* path) {
+        char dir[LOGGER_MAX_PATH_LENGTH] {0};
+        snprintf(dir, sizeof(dir), "%s", path);
+        for (char* p = dir + 1; *p; ++p) {
+            if (*p == '/') {
+                *p = 0;
+                ::mkdir(dir, 0755);
+                *p = '/';
+            }
+        }
+        ::mkdir(dir, 0755);
+    }
+
+    void makePath(char* name, size_t size, const char* file) {
+        snprintf(name, size, "%s/%s", this->dirLogger, file);
+    }
+
+    static size_t payloadSize(const Header_t& header) {
+        return ((size_t)header.subLen + header.idLen + header.dataLen + 3);
+    }
+
+    static uint32_t checksum(const Header_t& header, const struct iovec* iov, size_t count) {
+        CRC32 crc;
+        crc.update(header.time);
+        crc.update(header.subLen);
+        crc.update(header.idLen);
+        crc.update(header.dataLen);
+        for (size_t i = 0; i < count; ++i) {
+            crc.update((const uint8_t*)iov[i].iov_base, iov[i].iov_len);
+        }
+        return crc.finalize();
+    }
+
+    bool initialized;
+    int fd;
+    uint32_t firstSeg;
+    uint32_t lastSeg;
+    uint32_t lastSize;
+    size_t totalSize;
+    uint32_t readSeg;
+    uint32_t readOff;
+    bool dirty;
+    MillisTime_t prevSync;
+    MillisTime_t prevReplay;
+    char path[LOGGER_MAX_PATH_LENGTH];
+    ERaFlashLinux flash;
+    ERaMutex_t mutex;
+};
+
+#endif /* INC_ERA_LOGGER_LINUX_HPP_ */
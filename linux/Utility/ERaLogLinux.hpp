@@ -0,0 +1,680 @@
+#ifndef INC_ERA_LOG_LINUX_HPP_
+#define INC_ERA_LOG_LINUX_HPP_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <pthread.h>
+#include <time.h>
+#include <atomic>
+#include <type_traits>
+
+/* Bytes of the ring each logging thread writes into */
+#if !defined(ERA_LOG_RING_SIZE)
+    #define ERA_LOG_RING_SIZE           (64 * 1024)
+#endif
+
+#if !defined(ERA_LOG_FLUSH_INTERVAL)
+    #define ERA_LOG_FLUSH_INTERVAL      50
+#endif
+
+/* Messages per second and call site, 0 for no limit */
+#if !defined(ERA_LOG_RATE_LIMIT)
+    #define ERA_LOG_RATE_LIMIT          20
+#endif
+
+#if !defined(ERA_LOG_MAX_STRING)
+    #define ERA_LOG_MAX_STRING          1024
+#endif
+
+#if !defined(ERA_LOG_MAX_TAGS)
+    #define ERA_LOG_MAX_TAGS            32
+#endif
+
+#define ERA_LOG_LINE_SIZE               (8 * 1024)
+#define ERA_LOG_TAG_SIZE                16
+
+enum ERaLogLevelT {
+    ERA_LOG_LEVEL_NONE = 0,
+    ERA_LOG_LEVEL_ERROR = 1,
+    ERA_LOG_LEVEL_WARNING = 2,
+    ERA_LOG_LEVEL_INFO = 3
+};
+
+#if !defined(ERA_LOG_LEVEL_DEFAULT)
+    #define ERA_LOG_LEVEL_DEFAULT       ERA_LOG_LEVEL_INFO
+#endif
+
+/* One per ERA_LOG call site: a per-second message budget */
+class ERaLogSite
+{
+public:
+    ERaLogSite()
+        : window(0)
+        , count(0)
+        , suppressed(0)
+    {}
+
+    bool allow(unsigned long now, uint32_t limit) {
+        if (!limit) {
+            return true;
+        }
+        uint32_t second = (uint32_t)(now / 1000UL);
+        if (this->window.load(std::memory_order_relaxed) != second) {
+            this->window.store(second, std::memory_order_relaxed);
+            this->count.store(0, std::memory_order_relaxed);
+        }
+        if (this->count.fetch_add(1, std::memory_order_relaxed) < limit) {
+            return true;
+        }
+        this->suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t takeSuppressed() {
+        if (!this->suppressed.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        return this->suppressed.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> window;
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> suppressed;
+};
+
+/* Asynchronous ERA_LOG sink.
+ * Each thread appends records to its own single-producer ring without
+ * locks, and the arguments are stored raw, not formatted. A writer
+ * thread drains the rings every ERA_LOG_FLUSH_INTERVAL ms, formats
+ * and writes to stdout, a file or syslog. A full ring drops the record
+ * and counts it, the caller never blocks.
+ */
+class ERaLogLinux
+{
+    enum RecordTypeT {
+        RECORD_WRAP = 0,
+        RECORD_FORMAT = 1,
+        RECORD_HEX = 2
+    };
+
+    enum ArgTypeT {
+        ARG_SIGNED = 0,
+        ARG_UNSIGNED = 1,
+        ARG_DOUBLE = 2,
+        ARG_POINTER = 3,
+        ARG_STRING = 4
+    };
+
+    typedef struct __Arg_t {
+        uint32_t type;
+        uint32_t length;
+        union {
+            long long i;
+            unsigned long long u;
+            double d;
+            const void* p;
+        };
+    } Arg_t;
+
+    /* Strings follow the args, records are 8-byte aligned */
+    typedef struct __Record_t {
+        uint32_t size;
+        uint8_t type;
+        uint8_t level;
+        uint16_t count;
+        uint32_t line;
+        uint32_t suppressed;
+        unsigned long millis;
+        const char* format;
+        const char* file;
+        const char* function;
+        char tag[ERA_LOG_TAG_SIZE];
+    } Record_t;
+
+    typedef struct __Ring_t {
+        uint8_t data[ERA_LOG_RING_SIZE];
+        std::atomic<size_t> head;
+        std::atomic<size_t> tail;
+        std::atomic<uint32_t> dropped;
+        __Ring_t* next;
+    } Ring_t;
+
+    typedef struct __TagLevel_t {
+        char tag[ERA_LOG_TAG_SIZE];
+        std::atomic<uint8_t> level;
+    } TagLevel_t;
+
+public:
+    static ERaLogLinux& instance() {
+        static ERaLogLinux _instance;
+        return _instance;
+    }
+
+    /* Runtime threshold of one tag, nullptr sets the default */
+    void setLevel(const char* tag, uint8_t level) {
+        if (tag == nullptr) {
+            this->defaultLevel.store(level, std::memory_order_relaxed);
+            return;
+        }
+        pthread_mutex_lock(&this->mutex);
+        size_t count = this->numTags.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            if (!strncmp(this->tags[i].tag, tag, ERA_LOG_TAG_SIZE - 1)) {
+                this->tags[i].level.store(level, std::memory_order_relaxed);
+                pthread_mutex_unlock(&this->mutex);
+                return;
+            }
+        }
+        if (count < ERA_LOG_MAX_TAGS) {
+            snprintf(this->tags[count].tag, ERA_LOG_TAG_SIZE, "%s", tag);
+            this->tags[count].level.store(level, std::memory_order_relaxed);
+            this->numTags.store(count + 1, std::memory_order_release);
+        }
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+    void setRateLimit(uint32_t limit) {
+        this->rateLimit.store(limit, std::memory_order_relaxed);
+    }
+
+    /* Append to a file instead of ERA_SERIAL */
+    bool setFile(const char* path) {
+        FILE* file = fopen(path, "a");
+        if (file == nullptr) {
+            return false;
+        }
+        pthread_mutex_lock(&this->mutex);
+        if ((this->output != nullptr) && this->ownOutput) {
+            fclose(this->output);
+        }
+        this->output = file;
+        this->ownOutput = true;
+        this->useSyslog = false;
+        pthread_mutex_unlock(&this->mutex);
+        return true;
+    }
+
+    void setSyslog(const char* ident) {
+        pthread_mutex_lock(&this->mutex);
+        openlog(ident, LOG_PID, LOG_USER);
+        this->useSyslog = true;
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+    bool isEnabled(const char* tag, uint8_t level) {
+        return (level <= this->getLevel(tag));
+    }
+
+    template <typename... Args>
+    void log(ERaLogSite& site, uint8_t level, const char* tag, const char* file,
+            unsigned int line, const char* function, const char* format, const Args&... args) {
+        if ((format == nullptr) || !this->isEnabled(tag, level)) {
+            return;
+        }
+        unsigned long now = ERaMillis();
+        if (!site.allow(now, this->rateLimit.load(std::memory_order_relaxed))) {
+            return;
+        }
+
+        const size_t count = sizeof...(Args);
+        size_t strings {0};
+        int sizes[] = { 0, (strings += ERaLogLinux::stringSize(args), 0)... };
+        (void)sizes;
+
+        Ring_t* ring = this->threadRing();
+        size_t size = ERaLogLinux::align(sizeof(Record_t) + (count * sizeof(Arg_t)) + strings);
+        Record_t* record = (Record_t*)this->reserve(ring, size);
+        if (record == nullptr) {
+            return;
+        }
+        this->fillHeader(record, size, RECORD_FORMAT, level, tag, file, line, function, format, now);
+        record->count = (uint16_t)count;
+        record->suppressed = site.takeSuppressed();
+
+        Arg_t* argv = (Arg_t*)(record + 1);
+        ERaLogLinux::packArgs(argv, (char*)(argv + count), args...);
+
+        this->commit(ring, size);
+    }
+
+    /* Frame dump, hex formatting happens on the writer thread */
+    void hex(const char* title, const uint8_t* buf, size_t len,
+            const char* file, unsigned int line, const char* function) {
+        if ((title == nullptr) || (buf == nullptr) ||
+            !this->isEnabled("Hex", ERA_LOG_LEVEL_INFO)) {
+            return;
+        }
+        len = ERaMin(len, (size_t)ERA_LOG_MAX_STRING);
+        Ring_t* ring = this->threadRing();
+        size_t size = ERaLogLinux::align(sizeof(Record_t) + len);
+        Record_t* record = (Record_t*)this->reserve(ring, size);
+        if (record == nullptr) {
+            return;
+        }
+        this->fillHeader(record, size, RECORD_HEX, ERA_LOG_LEVEL_INFO, "Hex", file,
+                        line, function, title, ERaMillis());
+        record->count = (uint16_t)len;
+        memcpy(record + 1, buf, len);
+        this->commit(ring, size);
+    }
+
+    /* Write out everything queued so far */
+    void flush() {
+        pthread_mutex_lock(&this->mutex);
+        this->drain();
+        pthread_mutex_unlock(&this->mutex);
+    }
+
+private:
+    ERaLogLinux()
+        : rings(nullptr)
+        , numTags(0)
+        , defaultLevel(ERA_LOG_LEVEL_DEFAULT)
+        , rateLimit(ERA_LOG_RATE_LIMIT)
+        , running(true)
+        , output(ERA_SERIAL)
+        , ownOutput(false)
+        , useSyslog(false)
+        , thread()
+        , mutex(PTHREAD_MUTEX_INITIALIZER)
+    {
+#if defined(ERA_LOG_FILE)
+        this->setFile(ERA_LOG_FILE);
+#endif
+#if defined(ERA_LOG_SYSLOG)
+        this->setSyslog("era");
+#endif
+        pthread_create(&this->thread, NULL, ERaLogLinux::writerTask, this);
+    }
+    ~ERaLogLinux()
+    {
+        this->running.store(false, std::memory_order_release);
+        pthread_join(this->thread, NULL);
+        this->flush();
+        if ((this->output != nullptr) && this->ownOutput) {
+            fclose(this->output);
+        }
+    }
+
+    ERaLogLinux(const ERaLogLinux&) = delete;
+    ERaLogLinux& operator = (const ERaLogLinux&) = delete;
+
+    static void* writerTask(void* args) {
+        ERaLogLinux* logger = (ERaLogLinux*)args;
+        struct timespec interval {};
+        interval.tv_sec = (ERA_LOG_FLUSH_INTERVAL / 1000);
+        interval.tv_nsec = ((ERA_LOG_FLUSH_INTERVAL % 1000) * 1000000L);
+        while (logger->running.load(std::memory_order_acquire)) {
+            nanosleep(&interval, NULL);
+            logger->flush();
+        }
+        return NULL;
+    }
+
+    uint8_t getLevel(const char* tag) {
+        size_t count = this->numTags.load(std::memory_order_acquire);
+        for (size_t i = 0; (tag != nullptr) && (i < count); ++i) {
+            if (!strncmp(this->tags[i].tag, tag, ERA_LOG_TAG_SIZE - 1)) {
+                return this->tags[i].level.load(std::memory_order_relaxed);
+            }
+        }
+        return this->defaultLevel.load(std::memory_order_relaxed);
+    }
+
+    /* Rings live as long as the process, threads here rarely exit */
+    Ring_t* threadRing() {
+        static thread_local Ring_t* ring = nullptr;
+        if (ring != nullptr) {
+            return ring;
+        }
+        ring = new Ring_t;
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+        ring->dropped.store(0, std::memory_order_relaxed);
+        ring->next = this->rings.load(std::memory_order_relaxed);
+        while (!this->rings.compare_exchange_weak(ring->next, ring,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+        }
+        return ring;
+    }
+
+    void* reserve(Ring_t* ring, size_t size) {
+        if (size > (ERA_LOG_RING_SIZE / 2)) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        size_t head = ring->head.load(std::memory_order_relaxed);
+        size_t tail = ring->tail.load(std::memory_order_acquire);
+        size_t pos = (head % ERA_LOG_RING_SIZE);
+        size_t skip = (((pos + size) > ERA_LOG_RING_SIZE) ? (ERA_LOG_RING_SIZE - pos) : 0);
+        if ((head - tail + skip + size) > ERA_LOG_RING_SIZE) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (skip) {
+            Record_t* wrap = (Record_t*)(ring->data + pos);
+            wrap->size = (uint32_t)skip;
+            wrap->type = RECORD_WRAP;
+            ring->head.store(head + skip, std::memory_order_release);
+            pos = 0;
+        }
+        return (ring->data + pos);
+    }
+
+    void commit(Ring_t* ring, size_t size) {
+        ring->head.store(ring->head.load(std::memory_order_relaxed) + size,
+                        std::memory_order_release);
+    }
+
+    void fillHeader(Record_t* record, size_t size, uint8_t type, uint8_t level, const char* tag,
+                    const char* file, unsigned int line, const char* function,
+                    const char* format, unsigned long now) {
+        record->size = (uint32_t)size;
+        record->type = type;
+        record->level = level;
+        record->count = 0;
+        record->line = line;
+        record->suppressed = 0;
+        record->millis = now;
+        record->format = format;
+        record->file = file;
+        record->function = function;
+        snprintf(record->tag, sizeof(record->tag), "%s", (tag != nullptr) ? tag : "");
+    }
+
+    void drain() {
+        for (Ring_t* ring = this->rings.load(std::memory_order_acquire);
+            ring != nullptr; ring = ring->next) {
+            size_t tail = ring->tail.load(std::memory_order_relaxed);
+            size_t head = ring->head.load(std::memory_order_acquire);
+            while (tail != head) {
+                Record_t* record = (Record_t*)(ring->data + (tail % ERA_LOG_RING_SIZE));
+                if (record->type == RECORD_FORMAT) {
+                    this->writeFormat(record);
+                }
+                else if (record->type == RECORD_HEX) {
+                    this->writeHex(record);
+                }
+                tail += record->size;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+            uint32_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+            if (dropped) {
+                snprintf(this->lineBuf, sizeof(this->lineBuf), "[Log] %u messages dropped", (unsigned int)dropped);
+                this->writeLine(ERA_LOG_LEVEL_WARNING, this->lineBuf);
+            }
+        }
+        if (!this->useSyslog && (this->output != nullptr)) {
+            fflush(this->output);
+        }
+    }
+
+    size_t writePrefix(const Record_t* record) {
+        if (this->useSyslog) {
+            return (size_t)snprintf(this->lineBuf, sizeof(this->lineBuf), "[%s:%u] %s(): [%s] ",
+                                    ERaFileName(record->file), (unsigned int)record->line,
+                                    record->function, record->tag);
+        }
+        const char* color = "" ERA_LOG_GREEN;
+        if (record->level == ERA_LOG_LEVEL_ERROR) {
+            color = "" ERA_LOG_RED;
+        }
+        else if (record->level == ERA_LOG_LEVEL_WARNING) {
+            color = "" ERA_LOG_YELLOW;
+        }
+        return (size_t)snprintf(this->lineBuf, sizeof(this->lineBuf), "[%lu][%s:%u] %s(): [%s] %s",
+                                record->millis, ERaFileName(record->file), (unsigned int)record->line,
+                                record->function, record->tag, color);
+    }
+
+    void writeFormat(const Record_t* record) {
+        const Arg_t* argv = (const Arg_t*)(record + 1);
+        size_t pos = ERaMin(this->writePrefix(record), sizeof(this->lineBuf) - 1);
+        size_t index {0};
+        for (const char* p = record->format; *p && (pos < (sizeof(this->lineBuf) - 1)); ++p) {
+            if (*p != '%') {
+                this->lineBuf[pos++] = *p;
+                continue;
+            }
+            pos += this->formatSpec(p, argv, record->count, index,
+                                    this->lineBuf + pos, sizeof(this->lineBuf) - pos);
+            pos = ERaMin(pos, sizeof(this->lineBuf) - 1);
+        }
+        this->lineBuf[pos] = 0;
+        if (record->suppressed) {
+            snprintf(this->lineBuf + pos, sizeof(this->lineBuf) - pos, " (%u suppressed)",
+                    (unsigned int)record->suppressed);
+        }
+        this->finish(record->level);
+    }
+
+    void writeHex(const Record_t* record) {
+        const uint8_t* data = (const uint8_t*)(record + 1);
+        size_t pos = ERaMin(this->writePrefix(record), sizeof(this->lineBuf) - 1);
+        pos += snprintf(this->lineBuf + pos, sizeof(this->lineBuf) - pos, "%s (%3u): ",
+                        record->format, (unsigned int)record->count);
+        static const char hexits[17] = "0123456789ABCDEF";
+        for (size_t i = 0; (i < record->count) && ((pos + 4) < sizeof(this->lineBuf)); ++i) {
+            this->lineBuf[pos++] = hexits[data[i] >> 4];
+            this->lineBuf[pos++] = hexits[data[i] & 0x0F];
+            this->lineBuf[pos++] = ' ';
+        }
+        this->lineBuf[ERaMin(pos, sizeof(this->lineBuf) - 1)] = 0;
+        this->finish(record->level);
+    }
+
+    void finish(uint8_t level) {
+        if (!this->useSyslog) {
+            size_t pos = strlen(this->lineBuf);
+            snprintf(this->lineBuf + pos, sizeof(this->lineBuf) - pos, "%s", "" ERA_LOG_RESET);
+        }
+        this->writeLine(level, this->lineBuf);
+    }
+
+    void writeLine(uint8_t level, const char* text) {
+        if (this->useSyslog) {
+            int priority = LOG_INFO;
+            if (level == ERA_LOG_LEVEL_ERROR) {
+                priority = LOG_ERR;
+            }
+            else if (level == ERA_LOG_LEVEL_WARNING) {
+                priority = LOG_WARNING;
+            }
+            syslog(priority, "%s", text);
+            return;
+        }
+        if (this->output != nullptr) {
+            fputs(text, this->output);
+            fputs(ERA_NEWLINE, this->output);
+        }
+    }
+
+    /* Format one conversion at *p with the stored argument, the length
+     * modifier is rewritten to the width the argument was stored with.
+     */
+    size_t formatSpec(const char*& p, const Arg_t* argv, size_t count, size_t& index,
+                    char* out, size_t size) {
+        char spec[32] {0};
+        size_t len {0};
+        spec[len++] = *p++;
+        while (*p && strchr("-+ #0123456789.*", *p) && (len < (sizeof(spec) - 4))) {
+            if ((*p == '*') && (index < count)) {
+                len += snprintf(spec + len, sizeof(spec) - len, "%lld", argv[index++].i);
+                p++;
+                continue;
+            }
+            spec[len++] = *p++;
+        }
+        while (*p && strchr("hlLqjzt", *p)) {
+            p++;
+        }
+        const char conv = *p;
+        if (conv == '%') {
+            return (size_t)snprintf(out, size, "%%");
+        }
+        if (!conv || (index >= count)) {
+            if (!conv) {
+                p--;
+            }
+            return 0;
+        }
+        const Arg_t& arg = argv[index++];
+        int ret {0};
+        switch (conv) {
+            case 'd':
+            case 'i':
+                memcpy(spec + len, "ll", 2);
+                spec[len + 2] = conv;
+                ret = snprintf(out, size, spec, ((arg.type == ARG_UNSIGNED) ? (long long)arg.u : arg.i));
+                break;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                memcpy(spec + len, "ll", 2);
+                spec[len + 2] = conv;
+                ret = snprintf(out, size, spec, ((arg.type == ARG_SIGNED) ? (unsigned long long)arg.i : arg.u));
+                break;
+            case 'c':
+                spec[len] = conv;
+                ret = snprintf(out, size, spec, (int)arg.i);
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                spec[len] = conv;
+                ret = snprintf(out, size, spec, ((arg.type == ARG_DOUBLE) ? arg.d : (double)arg.i));
+                break;
+            case 's':
+                spec[len] = conv;
+                ret = snprintf(out, size, spec, ((arg.type == ARG_STRING) ? ((const char*)&arg + arg.i) : "(null)"));
+                break;
+            case 'p':
+                spec[len] = conv;
+                ret = snprintf(out, size, spec, arg.p);
+                break;
+            default:
+                break;
+        }
+        return ((ret > 0) ? (size_t)ret : 0);
+    }
+
+    static size_t align(size_t size) {
+        return ((size + 7) & ~(size_t)7);
+    }
+
+    static size_t stringSize(const char* value) {
+        return ((value != nullptr) ? (ERaLogLinux::stringLength(value) + 1) : 0);
+    }
+
+    static size_t stringLength(const char* value) {
+        return ERaMin(strlen(value), (size_t)ERA_LOG_MAX_STRING);
+    }
+
+    static size_t stringSize(char* value) {
+        return ERaLogLinux::stringSize((const char*)value);
+    }
+
+    template <typename T>
+    static size_t stringSize(const T&) {
+        return 0;
+    }
+
+    static void packArgs(Arg_t*, char*) {
+    }
+
+    template <typename T, typename... Rest>
+    static void packArgs(Arg_t* argv, char* text, const T& value, const Rest&... rest) {
+        ERaLogLinux::pack(*argv, text, value);
+        ERaLogLinux::packArgs(argv + 1, text, rest...);
+    }
+
+    static void pack(Arg_t& arg, char*& text, const char* value) {
+        arg.type = ARG_STRING;
+        if (value == nullptr) {
+            arg.type = ARG_POINTER;
+            arg.p = nullptr;
+            return;
+        }
+        size_t len = ERaLogLinux::stringLength(value);
+        memcpy(text, value, len);
+        text[len] = 0;
+        arg.length = (uint32_t)len;
+        arg.i = ERaLogLinux::textOffset(arg, text);
+        text += (len + 1);
+    }
+
+    static void pack(Arg_t& arg, char*& text, char* value) {
+        ERaLogLinux::pack(arg, text, (const char*)value);
+    }
+
+    static void pack(Arg_t& arg, char*&, bool value) {
+        arg.type = ARG_SIGNED;
+        arg.i = value;
+    }
+
+    static void pack(Arg_t& arg, char*&, double value) {
+        arg.type = ARG_DOUBLE;
+        arg.d = value;
+    }
+
+    static void pack(Arg_t& arg, char*&, float value) {
+        arg.type = ARG_DOUBLE;
+        arg.d = value;
+    }
+
+    static void pack(Arg_t& arg, char*&, long double value) {
+        arg.type = ARG_DOUBLE;
+        arg.d = (double)value;
+    }
+
+    template <typename T>
+    static void pack(Arg_t& arg, char*&, T* value) {
+        arg.type = ARG_POINTER;
+        arg.p = (const void*)value;
+    }
+
+    /* Integers and enums */
+    template <typename T>
+    static void pack(Arg_t& arg, char*&, const T& value) {
+        if (std::is_signed<T>::value || std::is_enum<T>::value) {
+            arg.type = ARG_SIGNED;
+            arg.i = (long long)value;
+        }
+        else {
+            arg.type = ARG_UNSIGNED;
+            arg.u = (unsigned long long)value;
+        }
+    }
+
+    /* Strings are addressed from the first argument of the record */
+    static long long textOffset(const Arg_t& arg, const char* text) {
+        return (long long)(text - (const char*)&arg);
+    }
+
+    std::atomic<Ring_t*> rings;
+    TagLevel_t tags[ERA_LOG_MAX_TAGS];
+    std::atomic<size_t> numTags;
+    std::atomic<uint8_t> defaultLevel;
+    std::atomic<uint32_t> rateLimit;
+    std::atomic<bool> running;
+    FILE* output;
+    bool ownOutput;
+    bool useSyslog;
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    char lineBuf[ERA_LOG_LINE_SIZE];
+};
+
+#endif /* INC_ERA_LOG_LINUX_HPP_ */
@@ -0,0 +1,112 @@
+#ifndef INC_ERA_POLL_LINUX_HPP_
+#define INC_ERA_POLL_LINUX_HPP_
+
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define ERA_POLL_MAX_EVENTS     8
+
+/* Single epoll set the main loop sleeps on, woken by watched fds or wakeup() */
+class ERaPollLinux
+{
+public:
+    static ERaPollLinux& instance() {
+        static ERaPollLinux _instance;
+        return _instance;
+    }
+
+    bool isValid() const {
+        return ((this->epollFd >= 0) && (this->eventFd >= 0));
+    }
+
+    bool watch(int fd) {
+        if ((fd < 0) || (this->epollFd < 0)) {
+            return false;
+        }
+        struct epoll_event ev {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(this->epollFd, EPOLL_CTL_ADD, fd, &ev) == 0) {
+            return true;
+        }
+        return (errno == EEXIST);
+    }
+
+    void unwatch(int fd) {
+        if ((fd < 0) || (this->epollFd < 0)) {
+            return;
+        }
+        epoll_ctl(this->epollFd, EPOLL_CTL_DEL, fd, NULL);
+    }
+
+    /* Safe from any thread, a wakeup before wait() is not lost */
+    void wakeup() {
+        if (this->eventFd < 0) {
+            return;
+        }
+        uint64_t value {1};
+        ssize_t ret = ::write(this->eventFd, &value, sizeof(value));
+        (void)ret;
+    }
+
+    /* Returns the number of ready fds, 0 on timeout or wakeup */
+    int wait(unsigned long timeout) {
+        if (!this->isValid()) {
+            return 0;
+        }
+        if (timeout > INT32_MAX) {
+            timeout = INT32_MAX;
+        }
+
+        struct epoll_event events[ERA_POLL_MAX_EVENTS];
+        int count = epoll_wait(this->epollFd, events, ERA_POLL_MAX_EVENTS, (int)timeout);
+        if (count <= 0) {
+            return 0;
+        }
+
+        int ready {0};
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.fd == this->eventFd) {
+                uint64_t value {0};
+                ssize_t ret = ::read(this->eventFd, &value, sizeof(value));
+                (void)ret;
+                continue;
+            }
+            ready++;
+        }
+        return ready;
+    }
+
+protected:
+private:
+    ERaPollLinux()
+        : epollFd(epoll_create1(EPOLL_CLOEXEC))
+        , eventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        this->watch(this->eventFd);
+    }
+    ~ERaPollLinux()
+    {
+        if (this->eventFd >= 0) {
+            ::close(this->eventFd);
+        }
+        if (this->epollFd >= 0) {
+            ::close(this->epollFd);
+        }
+    }
+
+    ERaPollLinux(const ERaPollLinux&);
+    ERaPollLinux& operator = (const ERaPollLinux&);
+
+    int epollFd;
+    int eventFd;
+};
+
+#if !defined(ERA_EVENT_NOTIFY)
+    #define ERA_EVENT_NOTIFY()      { ERaPollLinux::instance().wakeup(); }
+#endif
+
+#endif /* INC_ERA_POLL_LINUX_HPP_ */
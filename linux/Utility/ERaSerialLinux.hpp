@@ -10,6 +10,11 @@
     #include "Compat/SerialLinux.hpp"
 #endif
 
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+#include <termios.h>
+
 #define DTR_PIN TIOCM_DTR
 #define RTS_PIN TIOCM_RTS
 
@@ -89,6 +94,79 @@ public:
         return serialGetchar(this->fd);
     }
 
+    int read(uint8_t* buffer, size_t size) {
+        if (!this->connected()) {
+            return -1;
+        }
+        if ((buffer == NULL) || !size) {
+            return 0;
+        }
+        size_t count {0};
+        if (this->hasPeek) {
+            this->hasPeek = false;
+            buffer[count++] = this->peekByte;
+        }
+        if (count < size) {
+            ssize_t ret = ::read(this->fd, buffer + count, size - count);
+            if (ret > 0) {
+                count += ret;
+            }
+            else if (!count && (ret < 0) &&
+                    (errno != EAGAIN) && (errno != EINTR)) {
+                return -1;
+            }
+        }
+        return count;
+    }
+
+    using Stream::readBytes;
+
+    /* Bulk read, waits up to the stream timeout for the rest */
+    size_t readBytes(uint8_t* buffer, size_t size) override {
+        if (buffer == NULL) {
+            return 0;
+        }
+        size_t count {0};
+        unsigned long startMs = this->unix_millis();
+        while (count < size) {
+            int ret = this->read(buffer + count, size - count);
+            if (ret < 0) {
+                break;
+            }
+            count += ret;
+            if (count >= size) {
+                break;
+            }
+            unsigned long elapsed = (this->unix_millis() - startMs);
+            if (elapsed >= this->timeout) {
+                break;
+            }
+            this->waitReadable(this->timeout - elapsed);
+        }
+        return count;
+    }
+
+    bool waitReadable(unsigned long ms) {
+        if (!this->connected()) {
+            return false;
+        }
+        if (this->hasPeek) {
+            return true;
+        }
+        struct pollfd pfd {};
+        pfd.fd = this->fd;
+        pfd.events = POLLIN;
+        int ret = ::poll(&pfd, 1, (int)ms);
+        if (ret <= 0) {
+            return false;
+        }
+        if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            this->connect();
+            return false;
+        }
+        return (pfd.revents & POLLIN);
+    }
+
     int peek() override {
         if (!this->available()) {
             return -1;
@@ -117,10 +195,20 @@ public:
         if (!this->connected()) {
             return 0;
         }
-        for (size_t i = 0; i < size; ++i) {
-            serialPutchar(this->fd, buffer[i]);
+        size_t written {0};
+        while (written < size) {
+            ssize_t ret = ::write(this->fd, buffer + written, size - written);
+            if (ret > 0) {
+                written += ret;
+            }
+            else if ((ret < 0) && (errno == EINTR)) {
+                continue;
+            }
+            else {
+                break;
+            }
         }
-        return size;
+        return written;
     }
 
     void flush() override {
@@ -130,6 +218,25 @@ public:
         serialFlush(this->fd);
     }
 
+    void drain() {
+        if (!this->connected()) {
+            return;
+        }
+        ::tcdrain(this->fd);
+    }
+
+    void flushInput() {
+        if (!this->connected()) {
+            return;
+        }
+        this->hasPeek = false;
+        ::tcflush(this->fd, TCIFLUSH);
+    }
+
+    int getBaudRate() const {
+        return this->baudrate;
+    }
+
     operator int() const override {
         return this->fd;
     }
@@ -0,0 +1,26 @@
+#ifndef INC_ERA_TIME_LINUX_HPP_
+#define INC_ERA_TIME_LINUX_HPP_
+
+#include <time.h>
+#include <ERa/ERaTimeLib.hpp>
+
+/* System clock, kept in sync by the OS */
+class ERaTimeLinux
+    : public ERaTime
+{
+public:
+    ERaTimeLinux()
+    {}
+    ~ERaTimeLinux()
+    {}
+
+    void begin() override {
+        this->run();
+    }
+
+    void run() override {
+        this->setTime((ERaTime::time_t)::time(NULL));
+    }
+};
+
+#endif /* INC_ERA_TIME_LINUX_HPP_ */
@@ -33,52 +33,37 @@ void ERaZigbee<Api>::serialEnd() {
     this->initialized = false;
 }
 
+template <class Api>
+bool ERaZigbee<Api>::readZigbeeFrame(uint8_t(&frame)[ZNP_FRAME_MAX_LENGTH]) {
+    size_t length {0};
+    const uint8_t* view {nullptr};
+    ERaGuardLock(this->mutexData);
+    bool found = this->rxRing.next(view, length);
+    if (!found && this->rxRing.fill(*this->stream)) {
+        found = this->rxRing.next(view, length);
+    }
+    if (found) {
+        /* Handlers may send and wait, so the frame leaves the shared buffer */
+        memcpy(frame, view, length);
+    }
+    ERaGuardUnlock(this->mutexData);
+    return found;
+}
+
 template <class Api>
 void ERaZigbee<Api>::handleZigbeeData() {
     if (this->stream == NULL) {
         return;
     }
 
-    if (!this->stream->available()) {
-        return;
-    }
-    int remain {0};
-    uint8_t index {0};
-    uint8_t payload[256] {0};
+    uint8_t frame[ZNP_FRAME_MAX_LENGTH] {0};
     MillisTime_t startMillis = ERaMillis();
-    do {
-        if (!this->stream->available()) {
-            ERA_ZIGBEE_YIELD();
-            continue;
-        }
-        int position {0};
-        int length = this->stream->available();
-        uint8_t receive[(length < 256) ? 256 : length] {0};
-        ERaGuardLock(this->mutexData);
-        do {
-            receive[position] = this->stream->read();
-            if (index && !position) {
-                length = remain;
-            }
-            else if (!index && (position == this->PositionDataLength)) {
-                if (receive[this->PositionSOF] == this->SOF) {
-                    length = receive[this->PositionDataLength] + this->MinMessageLength;
-                }
-                else {
-                    length = 0;
-                }
-            }
-        } while ((++position < length) && ERaRemainingTime(startMillis, DEFAULT_TIMEOUT));
-        ERaGuardUnlock(this->mutexData);
-        this->processZigbee(receive, length, 256, payload, index, (!index ? 0 : payload[this->PositionDataLength]));
-        if (index) {
-            if (!length) {
-                index = 0;
-            }
-            remain = length - index;
-            ERA_ZIGBEE_YIELD();
+    while (this->readZigbeeFrame(frame)) {
+        this->processZigbeeFrame(frame);
+        if (!ERaRemainingTime(startMillis, DEFAULT_TIMEOUT)) {
+            break;
         }
-    } while (index && ERaRemainingTime(startMillis, DEFAULT_TIMEOUT));
+    }
 }
 
 template <class Zigbee>
@@ -91,6 +76,7 @@ ResultT ERaToZigbee<Zigbee>::waitResponse(Response_t rspWait, void* value) {
         rspWait.timeout = MAX_TIMEOUT;
     }
     uint8_t cmdStatus = ZnpCommandStatusT::INVALID_PARAM;
+    uint8_t frame[ZNP_FRAME_MAX_LENGTH] {0};
 
     MillisTime_t startMillis = ERaMillis();
 
@@ -110,50 +96,13 @@ ResultT ERaToZigbee<Zigbee>::waitResponse(Response_t rspWait, void* value) {
                 }
             }
         }
-        if (!this->thisZigbee().stream->available()) {
+        if (!this->thisZigbee().readZigbeeFrame(frame)) {
             ERA_ZIGBEE_YIELD();
             continue;
         }
-        int remain {0};
-        uint8_t index {0};
-        uint8_t payload[256] {0};
-        do {
-            if (!this->thisZigbee().stream->available()) {
-                ERA_ZIGBEE_YIELD();
-                continue;
-            }
-            int position = 0;
-            int length = this->thisZigbee().stream->available();
-            uint8_t receive[(length < 256) ? 256 : length] {0};
-            ERaGuardLock(this->thisZigbee().mutexData);
-            do {
-                receive[position] = this->thisZigbee().stream->read();
-                if (index && !position) {
-                    length = remain;
-                }
-                else if (!index && (position == this->thisZigbee().PositionDataLength)) {
-                    if (receive[this->thisZigbee().PositionSOF] == this->thisZigbee().SOF) {
-                        length = receive[this->thisZigbee().PositionDataLength] + this->thisZigbee().MinMessageLength;
-                    }
-                    else {
-                        length = 0;
-                    }
-                }
-            } while ((++position < length) && ERaRemainingTime(startMillis, rspWait.timeout));
-            ERaGuardUnlock(this->thisZigbee().mutexData);
-            if (this->thisZigbee().processZigbee(receive, length, 256, payload, index,
-                (!index ? 0 : payload[this->thisZigbee().PositionDataLength]), &cmdStatus, &rspWait, value)) {
-                return ((cmdStatus != ZnpCommandStatusT::INVALID_PARAM) ? static_cast<ResultT>(cmdStatus) : ResultT::RESULT_SUCCESSFUL);
-            }
-            if (index) {
-                if (!length) {
-                    index = 0;
-                }
-                remain = length - index;
-                ERA_ZIGBEE_YIELD();
-            }
-        } while (index && ERaRemainingTime(startMillis, rspWait.timeout));
-        ERA_ZIGBEE_YIELD();
+        if (this->thisZigbee().processZigbeeFrame(frame, &cmdStatus, &rspWait, value)) {
+            return ((cmdStatus != ZnpCommandStatusT::INVALID_PARAM) ? static_cast<ResultT>(cmdStatus) : ResultT::RESULT_SUCCESSFUL);
+        }
     } while (ERaRemainingTime(startMillis, rspWait.timeout));
     return ((cmdStatus != ZnpCommandStatusT::INVALID_PARAM) ? static_cast<ResultT>(cmdStatus) : ResultT::RESULT_TIMEOUT);
 }
@@ -171,14 +120,14 @@ void ERaToZigbee<Zigbee>::sendByte(uint8_t byte) {
 }
 
 template <class Zigbee>
-void ERaToZigbee<Zigbee>::sendCommand(const vector<uint8_t>& data) {
+void ERaToZigbee<Zigbee>::sendCommand(const uint8_t* data, size_t size) {
     if (this->thisZigbee().stream == NULL) {
         return;
     }
 
     ERaGuardLock(this->mutex);
-    ERaLogHex("ZB >>", data.data(), data.size());
-    this->thisZigbee().stream->write(data.data(), data.size());
+    ERaLogHex("ZB >>", data, size);
+    this->thisZigbee().stream->write(data, size);
     ERaGuardUnlock(this->mutex);
 }
 
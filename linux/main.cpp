@@ -40,6 +40,7 @@ ERA_DISCONNECTED() {
 
 void setup() {
     ERa.setAppLoop(false);
+    ERa.setRunSleep(true);
     ERa.setBoardID(boardID);
     ERa.begin(auth, host, port, user, pass);
     ERa.addInterval(1000L, []() {
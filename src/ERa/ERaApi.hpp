@@ -8,11 +8,13 @@
 #include <ERa/ERaParam.hpp>
 #include <ERa/ERaHooks.hpp>
 #include <ERa/ERaProperty.hpp>
+#include <ERa/ERaVirtualHandler.hpp>
 #include <ERa/ERaHelper.hpp>
 #include <ERa/ERaTransp.hpp>
 #include <ERa/ERaTimer.hpp>
 #include <ERa/ERaApiHandler.hpp>
 #include <Utility/ERaQueue.hpp>
+#include <Utility/ERaEventQueue.hpp>
 #include <Modbus/ERaModbusSimple.hpp>
 #include <Zigbee/ERaZigbeeSimple.hpp>
 #include <Reason/ERaReason.hpp>
@@ -100,6 +102,11 @@ public:
         this->virtualWriteMulti(pin, value, tail...);
     }
 
+    /* Handle writes to any virtual pin number, nullptr removes the handler */
+    bool onVirtualWrite(ERaVirtualPin_t pin, ERaVirtualHandler::WriteCallback_t cb) {
+        return this->ERaVHandler.onWrite(pin, cb);
+    }
+
     void virtualWriteObject(const char* value) {
         ERaDataJson data(value);
         this->virtualWriteObject(data);
@@ -212,6 +219,7 @@ public:
 
     void eraseAllConfigs() {
         this->flash.begin();
+        this->beginFlashBatch();
         this->removePinConfig();
 #if defined(ERA_BT)
         this->removeBluetoothConfig();
@@ -219,6 +227,7 @@ public:
 #if defined(ERA_MODBUS)
         Modbus::removeConfigFromFlash();
 #endif
+        this->commitFlashBatch();
     }
 
     void writeAllPin(ERaPin<ERaReport>::WritePinHandler_t writePin,
@@ -292,6 +301,20 @@ public:
 
     void callERaProHandler(const char* deviceId, const cJSON* const root);
 
+#if ERA_MAX_EVENTS
+    size_t getEventDropped() const {
+        return this->queue.getDropped();
+    }
+
+    size_t getEventCoalesced() const {
+        return this->queue.getCoalesced();
+    }
+
+    size_t getEventHighWater() const {
+        return this->queue.getHighWater();
+    }
+#endif
+
 protected:
     void initApiTask();
     void initERaApiTask();
@@ -365,6 +388,18 @@ protected:
         return this->thisProto().getTransp().run();
     }
 
+    /* Milliseconds until run() has work to do */
+    unsigned long getNextTimeout(unsigned long maxDelay) {
+#if ERA_MAX_EVENTS
+        if (this->isEvent()) {
+            return 0;
+        }
+#endif
+        maxDelay = Property::getNextTimeout(maxDelay);
+        maxDelay = this->ERaPinRp.getNextTimeout(maxDelay);
+        return Handler::getNextTimeout(maxDelay);
+    }
+
     void handlerAPI(bool feed) {
         Property::run();
         this->ERaPinRp.run();
@@ -435,8 +470,11 @@ protected:
     }
 #endif
 
-    void callERaWriteHandler(uint8_t pin, const ERaParam& param) {
+    void callERaWriteHandler(ERaVirtualPin_t pin, const ERaParam& param) {
         Property::handler(pin, param);
+        if (this->ERaVHandler.call(pin, param)) {
+            return;
+        }
         ERaWriteHandler_t handle = getERaWriteHandler(pin);
         if ((handle != nullptr) &&
             (handle != ERaWidgetWrite)) {
@@ -519,6 +557,19 @@ protected:
         }
     }
 
+    /* Group flash writes into one commit where the storage supports it */
+    void beginFlashBatch() {
+#if defined(LINUX)
+        this->flash.beginBatch();
+#endif
+    }
+
+    void commitFlashBatch() {
+#if defined(LINUX)
+        this->flash.commitBatch();
+#endif
+    }
+
     ERaPin<ERaReport>& getPinRp() {
         return this->ERaPinRp;
     }
@@ -578,7 +629,8 @@ private:
     void getPinConfig(const cJSON* const root, PinConfig_t& pin);
     uint8_t getPinMode(const cJSON* const root, const uint8_t defaultMode = VIRTUAL);
     bool isReadPinMode(uint8_t pMode);
-    bool getGPIOPin(const cJSON* const root, const char* key, uint8_t& pin);
+    template <typename T>
+    bool getGPIOPin(const cJSON* const root, const char* key, T& pin);
 
     void sendPinEvent(void* args);
     void sendPinConfigEvent(void* args);
@@ -627,6 +679,9 @@ private:
 
 #if ERA_MAX_EVENTS
     void eventsWrite();
+    bool eventAdd(const ERaEvent_t& event);
+    bool eventCoalesce(const ERaEvent_t& event);
+    void eventFree(ERaEvent_t& event);
 
 #if defined(ERA_MODBUS)
     void eventModbusAdd(ERaDataBuff* value);
@@ -649,20 +704,21 @@ private:
         return this->queue.readable();
     }
 
-    ERaEvent_t& getEvent() {
-        return this->queue;
+    bool getEvent(ERaEvent_t& event) {
+        return this->queue.pop(event);
     }
 
     bool isEmptyEvent() {
         return this->queue.isEmpty();
     }
 
-    ERaQueue<ERaEvent_t, ERA_MAX_EVENTS> queue;
+    ERaEventQueue<ERaEvent_t, ERA_MAX_EVENTS> queue;
 #endif
 
     Flash& flash;
     ERaReport ERaRp;
     ERaPin<ERaReport> ERaPinRp;
+    ERaVirtualHandler ERaVHandler;
 
     int ledPin;
     bool invertLED;
@@ -687,6 +743,7 @@ void ERaApi<Proto, Flash>::handleVirtualPin(cJSON* root) {
     }
 
     PinConfig_t pin {};
+    ERaVirtualPin_t vPin {0};
     cJSON* current = nullptr;
 
     for (current = root->child; current != nullptr; current = current->next) {
@@ -694,16 +751,17 @@ void ERaApi<Proto, Flash>::handleVirtualPin(cJSON* root) {
             continue;
         }
         pin = PinConfig_t();
+        vPin = 0;
         cJSON* item = cJSON_GetObjectItem(current, "config_id");
         if (cJSON_IsNumber(item)) {
             pin.configId = item->valueint;
         }
         item = cJSON_GetObjectItem(current, "pin_number");
         if (cJSON_IsNumber(item)) {
-            pin.pin = ERA_DECODE_PIN_NUMBER(item->valueint);
+            vPin = ERA_DECODE_PIN_NUMBER(item->valueint);
         }
         else if (cJSON_IsString(item)) {
-            pin.pin = ERA_DECODE_PIN_NAME(item->valuestring);
+            vPin = ERA_DECODE_PIN_NAME(item->valuestring);
         }
         item = cJSON_GetObjectItem(current, "new_value_type");
         if (item == nullptr) {
@@ -711,15 +769,15 @@ void ERaApi<Proto, Flash>::handleVirtualPin(cJSON* root) {
         }
         if (cJSON_IsString(item)) {
             if (ERaStrCmp(item->valuestring, "number")) {
-                this->ERaPinRp.setPinVirtual(pin.pin, pin.configId,
+                this->ERaPinRp.setPinVirtual(vPin, pin.configId,
                                             ERaPin<ERaReport>::VIRTUAL_NUMBER);
             }
             else if (ERaStrCmp(item->valuestring, "string")) {
-                this->ERaPinRp.setPinVirtual(pin.pin, pin.configId,
+                this->ERaPinRp.setPinVirtual(vPin, pin.configId,
                                             ERaPin<ERaReport>::VIRTUAL_STRING);
             }
             else {
-                this->ERaPinRp.setPinVirtual(pin.pin, pin.configId);
+                this->ERaPinRp.setPinVirtual(vPin, pin.configId);
             }
         }
     }
@@ -743,7 +801,7 @@ void ERaApi<Proto, Flash>::processVirtualPinRequest(const ERaDataBuff& arrayTopi
     }
     ERaDataJson data(root);
     ERaParam param(data);
-    uint8_t pin = ERA_DECODE_PIN_NAME(str);
+    ERaVirtualPin_t pin = ERA_DECODE_PIN_NAME(str);
     cJSON* item = cJSON_GetObjectItem(root, "value");
     if (cJSON_IsNumber(item) ||
         cJSON_IsBool(item)) {
@@ -1008,8 +1066,9 @@ bool ERaApi<Proto, Flash>::isReadPinMode(uint8_t pMode) {
 }
 
 template <class Proto, class Flash>
+template <typename T>
 inline
-bool ERaApi<Proto, Flash>::getGPIOPin(const cJSON* const root, const char* key, uint8_t& pin) {
+bool ERaApi<Proto, Flash>::getGPIOPin(const cJSON* const root, const char* key, T& pin) {
     if (root == nullptr || key == nullptr) {
         return false;
     }
@@ -1161,47 +1220,109 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
     template <class Proto, class Flash>
     inline
     void ERaApi<Proto, Flash>::eventsWrite() {
-        if (!this->isEvent()) {
-            return;
-        }
-
-        ERaEvent_t& event = this->getEvent();
-        switch (event.type) {
-#if defined(ERA_MODBUS)
-            case ERaTypeWriteT::ERA_WRITE_MODBUS_DATA:
-                this->eventModbusWrite(event);
+        ERaEvent_t event;
+        for (size_t i = 0; i < ERA_EVENT_BATCH; ++i) {
+            if (!this->getEvent(event)) {
                 break;
+            }
+            switch (event.type) {
+#if defined(ERA_MODBUS)
+                case ERaTypeWriteT::ERA_WRITE_MODBUS_DATA:
+                    this->eventModbusWrite(event);
+                    break;
 #endif
 #if defined(ERA_ZIGBEE)
-            case ERaTypeWriteT::ERA_WRITE_ZIGBEE_DATA:
-                this->eventZigbeeWrite(event);
-                break;
+                case ERaTypeWriteT::ERA_WRITE_ZIGBEE_DATA:
+                    this->eventZigbeeWrite(event);
+                    break;
 #endif
 #if defined(ERA_SPECIFIC)
-            case ERaTypeWriteT::ERA_WRITE_SPECIFIC_DATA:
-                this->eventSpecificWrite(event);
-                break;
+                case ERaTypeWriteT::ERA_WRITE_SPECIFIC_DATA:
+                    this->eventSpecificWrite(event);
+                    break;
 #endif
-            default:
-                break;
+                default:
+                    break;
+            }
         }
     }
 
-#if defined(ERA_MODBUS)
     template <class Proto, class Flash>
     inline
-    void ERaApi<Proto, Flash>::eventModbusAdd(ERaDataBuff* value) {
-        if (!this->queue.writeable()) {
+    bool ERaApi<Proto, Flash>::eventAdd(const ERaEvent_t& event) {
+#if (ERA_EVENT_POLICY == ERA_EVENT_POLICY_COALESCE)
+        if (this->eventCoalesce(event)) {
+            this->queue.markCoalesced();
+            return true;
+        }
+#endif
+
+#if (ERA_EVENT_POLICY == ERA_EVENT_POLICY_BLOCK)
+        MillisTime_t startMillis = ERaMillis();
+#endif
+        while (!this->queue.push(event)) {
+#if (ERA_EVENT_POLICY == ERA_EVENT_POLICY_BLOCK)
+            /* Give the consumer a chance, then drop the new event */
+            if (!ERaRemainingTime(startMillis, ERA_EVENT_BLOCK_TIMEOUT)) {
+                ERaEvent_t dropped = event;
+                this->eventFree(dropped);
+                this->queue.markDropped();
+                return false;
+            }
+            ERA_EVENT_NOTIFY();
+            ERaDelay(1);
+#else
+            /* Make room by dropping the oldest event */
+            ERaEvent_t oldest;
+            if (this->queue.pop(oldest)) {
+                this->eventFree(oldest);
+                this->queue.markDropped();
+            }
+#endif
+        }
+        ERA_EVENT_NOTIFY();
+        return true;
+    }
+
+    /* Non-specific events are resolved at write time, one pending copy is enough */
+    template <class Proto, class Flash>
+    inline
+    bool ERaApi<Proto, Flash>::eventCoalesce(const ERaEvent_t& event) {
+        if (event.specific) {
+            return false;
+        }
+        return this->queue.find([&event](const ERaEvent_t& e) -> bool {
+            return (!e.specific &&
+                    (e.type == event.type) &&
+                    (e.retained == event.retained) &&
+                    (e.id == event.id) &&
+                    (e.data == event.data));
+        });
+    }
+
+    template <class Proto, class Flash>
+    inline
+    void ERaApi<Proto, Flash>::eventFree(ERaEvent_t& event) {
+        if (!event.specific) {
             return;
         }
+        free(event.id);
+        free(event.data);
+        event.id = nullptr;
+        event.data = nullptr;
+    }
 
+#if defined(ERA_MODBUS)
+    template <class Proto, class Flash>
+    inline
+    void ERaApi<Proto, Flash>::eventModbusAdd(ERaDataBuff* value) {
         ERaEvent_t event;
         event.type = ERaTypeWriteT::ERA_WRITE_MODBUS_DATA;
         event.specific = false;
         event.retained = true;
         event.id = nullptr;
         event.data = value;
-        this->queue += event;
+        this->eventAdd(event);
     }
 
     template <class Proto, class Flash>
@@ -1226,10 +1347,6 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
     inline
     void ERaApi<Proto, Flash>::eventZigbeeAdd(const char* id, cJSON* value,
                                             bool specific, bool retained) {
-        if (!this->queue.writeable()) {
-            return;
-        }
-
         ERaEvent_t event;
         event.type = ERaTypeWriteT::ERA_WRITE_ZIGBEE_DATA;
         event.specific = specific;
@@ -1242,7 +1359,7 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
             event.id = ERaStrdup(id);
             event.data = cJSON_PrintUnformatted(value);
         }
-        this->queue += event;
+        this->eventAdd(event);
     }
 
     template <class Proto, class Flash>
@@ -1250,6 +1367,7 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
     void ERaApi<Proto, Flash>::eventZigbeeWrite(ERaEvent_t& event) {
         if ((event.id == nullptr) ||
             (event.data == nullptr)) {
+            this->eventFree(event);
             return;
         }
 
@@ -1264,12 +1382,7 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
             rsp.param.add_static((char*)event.data);
         }
         this->thisProto().sendCommand(rsp);
-        if (event.specific) {
-            free(event.id);
-            free(event.data);
-            event.id = nullptr;
-            event.data = nullptr;
-        }
+        this->eventFree(event);
     }
 #endif
 
@@ -1278,10 +1391,6 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
     inline
     void ERaApi<Proto, Flash>::eventSpecificAdd(const char* id, cJSON* value,
                                                 bool specific, bool retained) {
-        if (!this->queue.writeable()) {
-            return;
-        }
-
         ERaEvent_t event;
         event.type = ERaTypeWriteT::ERA_WRITE_SPECIFIC_DATA;
         event.specific = specific;
@@ -1294,17 +1403,13 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
             event.id = ERaStrdup(id);
             event.data = cJSON_PrintUnformatted(value);
         }
-        this->queue += event;
+        this->eventAdd(event);
     }
 
     template <class Proto, class Flash>
     inline
     void ERaApi<Proto, Flash>::eventSpecificAdd(const char* id, const char* value,
                                                 bool specific, bool retained) {
-        if (!this->queue.writeable()) {
-            return;
-        }
-
         ERaEvent_t event;
         event.type = ERaTypeWriteT::ERA_WRITE_SPECIFIC_DATA;
         event.specific = specific;
@@ -1317,7 +1422,7 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
             event.id = ERaStrdup(id);
             event.data = ERaStrdup(value);
         }
-        this->queue += event;
+        this->eventAdd(event);
     }
 
     template <class Proto, class Flash>
@@ -1325,6 +1430,7 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
     void ERaApi<Proto, Flash>::eventSpecificWrite(ERaEvent_t& event) {
         if ((event.id == nullptr) ||
             (event.data == nullptr)) {
+            this->eventFree(event);
             return;
         }
 
@@ -1339,12 +1445,7 @@ void ERaApi<Proto, Flash>::callERaProHandler(const char* deviceId, const cJSON*
             rsp.param.add_static((char*)event.data);
         }
         this->thisProto().sendCommand(rsp);
-        if (event.specific) {
-            free(event.id);
-            free(event.data);
-            event.id = nullptr;
-            event.data = nullptr;
-        }
+        this->eventFree(event);
     }
 #endif
 
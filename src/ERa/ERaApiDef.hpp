@@ -23,6 +23,11 @@
     #endif
 #endif
 
+/* Wakes a main loop that sleeps until its next deadline */
+#if !defined(ERA_EVENT_NOTIFY)
+    #define ERA_EVENT_NOTIFY()           {}
+#endif
+
 #if !defined(ERA_API_TASK_PRIORITY)
     #define ERA_API_TASK_PRIORITY        2
 #endif
@@ -41,6 +46,11 @@
 #if !defined(ERA_MAX_EVENTS)
     #if defined(ERA_NO_RTOS)
         #define ERA_MAX_EVENTS           0
+    #elif defined(LINUX) &&              \
+        (defined(ERA_ZIGBEE) ||          \
+        defined(ERA_SPECIFIC) ||         \
+        defined(ERA_MODBUS))
+        #define ERA_MAX_EVENTS           256
     #elif defined(ERA_ZIGBEE) ||         \
         defined(ERA_SPECIFIC)
         #define ERA_MAX_EVENTS           20
@@ -51,6 +61,24 @@
     #endif
 #endif
 
+/* What a producer does when the event queue is full */
+#define ERA_EVENT_POLICY_BLOCK           0
+#define ERA_EVENT_POLICY_DROP_OLDEST     1
+#define ERA_EVENT_POLICY_COALESCE        2
+
+#if !defined(ERA_EVENT_POLICY)
+    #define ERA_EVENT_POLICY             ERA_EVENT_POLICY_COALESCE
+#endif
+
+#if !defined(ERA_EVENT_BLOCK_TIMEOUT)
+    #define ERA_EVENT_BLOCK_TIMEOUT      100UL
+#endif
+
+/* Events sent per run() */
+#if !defined(ERA_EVENT_BATCH)
+    #define ERA_EVENT_BATCH              16
+#endif
+
 #if defined(analogInputToDigitalPin)
     #define ERA_DECODE_PIN(pin)          analogInputToDigitalPin(pin)
 #else
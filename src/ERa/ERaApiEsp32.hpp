@@ -274,17 +274,18 @@ void ERaApi<Proto, Flash>::handlePinRequest(const ERaDataBuff& arrayTopic, const
 
     ERaParam param;
     PinConfig_t pin {};
+    ERaVirtualPin_t vPin {0};
     cJSON* current = nullptr;
 
     for (current = root->child; current != nullptr && current->string != nullptr; current = current->next) {
-        if (this->getGPIOPin(current, "virtual_pin", pin.pin)) {
+        if (this->getGPIOPin(current, "virtual_pin", vPin)) {
             if (cJSON_IsNumber(current)) {
                 param = current->valuedouble;
             }
             else if (cJSON_IsString(current)) {
                 param.add_static(current->valuestring);
             }
-            this->callERaWriteHandler(pin.pin, param);
+            this->callERaWriteHandler(vPin, param);
             continue;
         }
         if (this->getGPIOPin(current, "pin_mode", pin.pin)) {
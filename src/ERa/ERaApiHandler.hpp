@@ -85,6 +85,10 @@ protected:
         this->ERaTm.run();
     }
 
+    unsigned long getNextTimeout(unsigned long maxDelay) {
+        return this->ERaTm.getNextTimeout(maxDelay);
+    }
+
     virtual void connectNewWiFi(const char* ssid, const char* pass) {
         ERA_LOG(TAG, ERA_PSTR("connectNewWiFi default."));
         ERA_FORCE_UNUSED(ssid);
@@ -102,6 +102,12 @@
     #define ERA_MQTT_PUBLISH_QOS        1
 #endif
 
+#if defined(DEFAULT_MQTT_INFLIGHT_WINDOW)
+    #define ERA_MQTT_INFLIGHT_WINDOW    DEFAULT_MQTT_INFLIGHT_WINDOW
+#else
+    #define ERA_MQTT_INFLIGHT_WINDOW    16
+#endif
+
 #if defined(DEFAULT_MQTT_PUBLISH_RETAINED)
     #define ERA_MQTT_PUBLISH_RETAINED   DEFAULT_MQTT_PUBLISH_RETAINED
 #else
@@ -166,6 +172,8 @@
 #define INFO_MB_DATA                    "data"
 #define INFO_MB_ACK                     "ack"
 #define INFO_MB_SCAN                    "scan"
+#define INFO_MB_DELTA                   "delta"
+#define INFO_MB_KEY                     "key"
 #define INFO_MB_READ_FAIL               "modbus_fail"
 #define INFO_MB_WRITE_FAIL              "modbus_write_fail"
 #define INFO_MB_TOTAL                   "modbus_total"
@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <ERa/ERaDefine.hpp>
+#include <Utility/ERaUtility.hpp>
 
 class ERaParam;
 class ERaDataJson;
@@ -295,8 +296,7 @@ public:
 protected:
     void onChange(const void* ptr, size_t size);
     void onChange(const char* value);
-    void onChangeHex(uint8_t value);
-    void onChangeHex(const uint8_t* ptr, size_t size);
+    void putHex(const uint8_t* ptr, size_t size);
 
     char* buff;
     size_t len;
@@ -323,8 +323,7 @@ void ERaDataBuff::add_hex(uint8_t value) {
     if ((this->len + 2) >= this->buffSize) {
         return;
     }
-    this->onChangeHex(value);
-    this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%02x", value);
+    this->putHex(&value, 1);
     this->buff[this->len++] = '\0';
 }
 
@@ -336,10 +335,7 @@ void ERaDataBuff::add_hex_array(const uint8_t* ptr, size_t size) {
     if ((this->len + (size * 2)) >= this->buffSize) {
         return;
     }
-    this->onChangeHex(ptr, size);
-    for (size_t i = 0; i < size; ++i) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%02x", ptr[i]);
-    }
+    this->putHex(ptr, size);
     this->buff[this->len++] = '\0';
 }
 
@@ -351,9 +347,8 @@ void ERaDataBuff::add_zero_array(size_t size) {
     if ((this->len + (size * 2)) >= this->buffSize) {
         return;
     }
-    for (size_t i = 0; i < size; ++i) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%02x", 0);
-    }
+    memset(this->buff + this->len, '0', size * 2);
+    this->len += (size * 2);
     this->buff[this->len++] = '\0';
 }
 
@@ -427,38 +422,38 @@ void ERaDataBuff::add_on_change(const char* value) {
 
     inline
     void ERaDataBuff::add(int value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%i", value);
-        this->buff[this->len++] = '\0';
+        char str[2 + 8 * sizeof(int)] {0};
+        this->add(str, ERaLltoa(value, str));
     }
 
     inline
     void ERaDataBuff::add(unsigned int value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%u", value);
-        this->buff[this->len++] = '\0';
+        char str[1 + 8 * sizeof(unsigned int)] {0};
+        this->add(str, ERaUtoa(value, str));
     }
 
     inline
     void ERaDataBuff::add(long value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%li", value);
-        this->buff[this->len++] = '\0';
+        char str[2 + 8 * sizeof(long)] {0};
+        this->add(str, ERaLltoa(value, str));
     }
 
     inline
     void ERaDataBuff::add(unsigned long value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%lu", value);
-        this->buff[this->len++] = '\0';
+        char str[1 + 8 * sizeof(unsigned long)] {0};
+        this->add(str, ERaUtoa(value, str));
     }
 
     inline
     void ERaDataBuff::add(long long value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%lli", value);
-        this->buff[this->len++] = '\0';
+        char str[2 + 8 * sizeof(long long)] {0};
+        this->add(str, ERaLltoa(value, str));
     }
 
     inline
     void ERaDataBuff::add(unsigned long long value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%llu", value);
-        this->buff[this->len++] = '\0';
+        char str[1 + 8 * sizeof(unsigned long long)] {0};
+        this->add(str, ERaUtoa(value, str));
     }
 
 #if defined(ERA_USE_ERA_DTOSTRF)
@@ -481,14 +476,14 @@ void ERaDataBuff::add_on_change(const char* value) {
 
     inline
     void ERaDataBuff::add(float value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%.2f", value);
-        this->buff[this->len++] = '\0';
+        char str[33] {0};
+        this->add(str, ERaFormatFixed(str, sizeof(str), value, 2));
     }
 
     inline
     void ERaDataBuff::add(double value) {
-        this->len += snprintf(this->buff + this->len, this->buffSize - this->len, "%.5f", value);
-        this->buff[this->len++] = '\0';
+        char str[33] {0};
+        this->add(str, ERaFormatFixed(str, sizeof(str), value, 5));
     }
 
 #endif
@@ -565,36 +560,30 @@ void ERaDataBuff::onChange(const char* value) {
     this->onChange((void*)value, strlen(value));
 }
 
+/* Encode as lower case hex in place, comparing with the previous contents in the same pass */
 inline
-void ERaDataBuff::onChangeHex(uint8_t value) {
-    char buf[3] {0};
-    snprintf(buf, sizeof(buf), "%02x", value);
-    this->onChange(buf);
-}
-
-inline
-void ERaDataBuff::onChangeHex(const uint8_t* ptr, size_t size) {
-    if ((ptr == nullptr) || !size) {
-        return;
+void ERaDataBuff::putHex(const uint8_t* ptr, size_t size) {
+    static const char hex[] = "0123456789abcdef";
+    char* dst = this->buff + this->len;
+    size_t i {0};
+    if (*dst == '\0') {
+        this->changed = true;
     }
-    size_t len = size * 2 + 1;
-    char locBuf[32] {0};
-    char* buf = locBuf;
-    if (len > sizeof(locBuf)) {
-        buf = (char*)malloc(len);
-        if (buf == nullptr) {
-            return;
+    if (!this->changed) {
+        /* Unchanged digits are already in place */
+        for (; i < size; ++i, dst += 2) {
+            if ((dst[0] != hex[ptr[i] >> 4]) ||
+                (dst[1] != hex[ptr[i] & 0x0F])) {
+                this->changed = true;
+                break;
+            }
         }
     }
-    size_t pos {0};
-    for (size_t i = 0; i < size; ++i) {
-        pos += snprintf(buf + pos, len - pos, "%02x", ptr[i]);
-    }
-    this->onChange(buf);
-    if (buf != locBuf) {
-        free(buf);
+    for (; i < size; ++i, dst += 2) {
+        dst[0] = hex[ptr[i] >> 4];
+        dst[1] = hex[ptr[i] & 0x0F];
     }
-    buf = nullptr;
+    this->len += (size * 2);
 }
 
 inline
@@ -170,6 +170,12 @@
 
         #include <iostream>
         using namespace std;
+        #if defined(ERA_LOG_ASYNC)
+            #define ERA_LOG_LEVEL(LEVEL, tag, format, ...)  { static ERaLogSite _logSite; ERaLogLinux::instance().log(_logSite, ERA_LOG_LEVEL_ ##LEVEL, tag, __FILE__, __LINE__, __FUNCTION__, format, ##__VA_ARGS__); }
+            #define ERA_LOG(tag, format, ...)               ERA_LOG_LEVEL(INFO, tag, format, ##__VA_ARGS__)
+            #define ERA_LOG_ERROR(tag, format, ...)         ERA_LOG_LEVEL(ERROR, tag, format, ##__VA_ARGS__)
+            #define ERA_LOG_WARNING(tag, format, ...)       ERA_LOG_LEVEL(WARNING, tag, format, ##__VA_ARGS__)
+        #else
         #define ERA_LOG_TIME()                          cout << '[' << ERaMillis() << ']'
         #define ERA_LOG_TAG(tag)                        cout << '[' << tag << "] "
         #define ERA_LOG_FN()                            cout << '[' << ERaFileName(__FILE__) << ':' << __LINE__ << "] " << __FUNCTION__ << "(): "
@@ -177,6 +183,7 @@
         #define ERA_LOG(tag, format, ...)               ERA_LOG_COLOR(GREEN, tag, format, ##__VA_ARGS__)
         #define ERA_LOG_ERROR(tag, format, ...)         ERA_LOG_COLOR(RED, tag, format, ##__VA_ARGS__)
         #define ERA_LOG_WARNING(tag, format, ...)       ERA_LOG_COLOR(YELLOW, tag, format, ##__VA_ARGS__)
+        #endif
 
         static inline
         ERA_UNUSED const char* ERaFileName(const char* path) {
@@ -192,6 +199,10 @@
             }
             return path + pos;
         }
+
+        #if defined(ERA_LOG_ASYNC)
+            #include <Utility/ERaLogLinux.hpp>
+        #endif
     #else
         #ifndef ERA_SERIAL
             #define ERA_SERIAL                          Serial
@@ -265,7 +276,10 @@
 
 static inline
 ERA_UNUSED void ERaLogHex(const char ERA_UNUSED *title, const uint8_t ERA_UNUSED *buf, size_t ERA_UNUSED len) {
-#ifdef ERA_DEBUG_DUMP
+#if defined(ERA_DEBUG_DUMP) && \
+    defined(LINUX) && defined(ERA_LOG_ASYNC)
+    ERaLogLinux::instance().hex(title, buf, len, __FILE__, __LINE__, __FUNCTION__);
+#elif defined(ERA_DEBUG_DUMP)
     if (title == nullptr) {
         return;
     }
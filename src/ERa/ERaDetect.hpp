@@ -844,8 +844,9 @@
 
 #elif defined(LINUX)
 
+    /* Larger publishes are streamed into a buffer of their own */
     #if !defined(ERA_MQTT_BUFFER_SIZE)
-        #define ERA_MQTT_BUFFER_SIZE    10240
+        #define ERA_MQTT_BUFFER_SIZE    1024
     #endif
 
     #if !defined(ERA_BUFFER_SIZE)
@@ -857,7 +858,15 @@
     #endif
 
     #if !defined(ERA_MAX_VIRTUAL_PIN)
-        #define ERA_MAX_VIRTUAL_PIN     100
+        #define ERA_MAX_VIRTUAL_PIN     10000
+    #endif
+
+    #if !defined(ERA_VIRTUAL_PIN_TYPE)
+        #define ERA_VIRTUAL_PIN_TYPE    uint32_t
+    #endif
+
+    #if !defined(ERA_MAX_TIMER)
+        #define ERA_MAX_TIMER           1024
     #endif
 
     #define ERA_100_PINS
@@ -908,6 +917,10 @@
     #define ERA_MAX_REPORT              ERA_MAX_VIRTUAL_PIN
 #endif
 
+#if !defined(ERA_MAX_TIMER)
+    #define ERA_MAX_TIMER               16
+#endif
+
 #if !defined(ERA_MQTT_RX_BUFFER_SIZE)
     #define ERA_MQTT_RX_BUFFER_SIZE     ERA_MQTT_BUFFER_SIZE
 #endif
@@ -15,8 +15,8 @@ void ERaNoModbusBaudrate(uint32_t ERA_UNUSED &baudrate) {
 void ERaNoInfo(cJSON ERA_UNUSED *root) {
 }
 
-void ERaWidgetWrite(uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param) {
-    ERA_LOG(ERA_PSTR("ERa"), ERA_PSTR("No handler for writing to V%u"), pin);
+void ERaWidgetWrite(ERaVirtualPin_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param) {
+    ERA_LOG(ERA_PSTR("ERa"), ERA_PSTR("No handler for writing to V%lu"), (unsigned long)pin);
 }
 
 void ERaWidgetPinRead(uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param, const ERaParam ERA_UNUSED &raw) {
@@ -26,7 +26,7 @@ bool ERaWidgetPinWrite(uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param
     return false;
 }
 
-#define ERA_ON_WRITE(Pin) void ERaWidgetWrite ## Pin (uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param) \
+#define ERA_ON_WRITE(Pin) void ERaWidgetWrite ## Pin (ERaVirtualPin_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param) \
         __attribute__((weak, alias("ERaWidgetWrite")))
 
 #define ERA_ON_PIN_READ(Pin) void ERaWidgetPinRead ## Pin (uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param, const ERaParam ERA_UNUSED &raw) \
@@ -431,7 +431,7 @@ static const ERaPinWriteHandler_t ERaPinWriteHandlerVector[] ERA_PROGMEM = {
 #endif
 };
 
-ERaWriteHandler_t getERaWriteHandler(uint8_t pin) {
+ERaWriteHandler_t getERaWriteHandler(ERaVirtualPin_t pin) {
     if (pin >= ERA_COUNT_OF(ERaWriteHandlerVector)) {
         return nullptr;
     }
@@ -2,6 +2,7 @@
 #define INC_ERA_HANDLERS_HPP_
 
 #include <ERa/ERaDetect.hpp>
+#include <ERa/ERaPinDef.hpp>
 #include <ERa/ERaParam.hpp>
 
 #define V0  0
@@ -115,7 +116,7 @@
 #define ERA_INFO()                  void ERaInfo(cJSON ERA_UNUSED *root)
 #define ERA_MODBUS_INFO()           void ERaModbusInfo(cJSON ERA_UNUSED *root)
 
-#define ERA_WRITE_2(Pin)            void ERaWidgetWrite ## Pin (uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param)
+#define ERA_WRITE_2(Pin)            void ERaWidgetWrite ## Pin (ERaVirtualPin_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param)
 #define ERA_WRITE(Pin)              ERA_WRITE_2(Pin)
 
 #define ERA_PIN_READ_2(Pin)         void ERaWidgetPinRead ## Pin (uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param, const ERaParam ERA_UNUSED &raw)
@@ -466,11 +467,11 @@ ERA_PIN_WRITE(49);
     ERA_PIN_WRITE(99);
 #endif
 
-typedef void (*ERaWriteHandler_t)(uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param);
+typedef void (*ERaWriteHandler_t)(ERaVirtualPin_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param);
 typedef void (*ERaPinReadHandler_t)(uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param, const ERaParam ERA_UNUSED &raw);
 typedef bool (*ERaPinWriteHandler_t)(uint8_t ERA_UNUSED &pin, const ERaParam ERA_UNUSED &param, const ERaParam ERA_UNUSED &raw);
 
-ERaWriteHandler_t getERaWriteHandler(uint8_t pin);
+ERaWriteHandler_t getERaWriteHandler(ERaVirtualPin_t pin);
 ERaPinReadHandler_t getERaPinReadHandler(uint8_t pin);
 ERaPinWriteHandler_t getERaPinWriteHandler(uint8_t pin);
 
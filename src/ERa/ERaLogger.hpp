@@ -11,11 +11,19 @@
 class ERaLogger
 {
 public:
+    /* Publishes a stored record captured at timestamp (0 if unknown),
+       false keeps it for a later retry */
+    typedef bool (*ReplayCallback_t)(void* args, const char* subPath,
+                                    const char* id, const char* data,
+                                    unsigned long timestamp);
+
     ERaLogger(ERaTime& _time)
         : time(_time)
         , dirLogger(DIRECTORY_LOGGER)
         , logInterval(LOGGER_LOG_INTERVAL)
         , prevMillis(0)
+        , replayCb(nullptr)
+        , replayArgs(nullptr)
     {}
     virtual ~ERaLogger()
     {}
@@ -40,6 +48,11 @@ public:
         buf = nullptr;
     }
 
+    void onReplay(ReplayCallback_t cb, void* args) {
+        this->replayCb = cb;
+        this->replayArgs = args;
+    }
+
 protected:
     bool isExpireTime(bool skip = false) {
         if (skip) {
@@ -58,10 +71,20 @@ protected:
         this->prevMillis = ERaMillis() - this->logInterval;
     }
 
+    bool replay(const char* subPath, const char* id, const char* data,
+                unsigned long timestamp) {
+        if (this->replayCb == nullptr) {
+            return false;
+        }
+        return this->replayCb(this->replayArgs, subPath, id, data, timestamp);
+    }
+
     ERaTime& time;
     const char* dirLogger;
     unsigned long logInterval;
     unsigned long prevMillis;
+    ReplayCallback_t replayCb;
+    void* replayArgs;
 };
 
 #endif /* INC_ERA_LOGGER_HPP_ */
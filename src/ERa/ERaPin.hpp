@@ -6,6 +6,8 @@
 #include <ERa/ERaReport.hpp>
 #include <ERa/ERaData.hpp>
 #include <ERa/ERaParam.hpp>
+#include <ERa/ERaPinDef.hpp>
+#include <Utility/ERaHashIndex.hpp>
 
 #if defined(__has_include) &&       \
     __has_include(<functional>) &&  \
@@ -57,6 +59,8 @@ class ERaPin
         uint8_t channel; /* for pwm mode */
         bool enable;
         uint8_t called;
+        unsigned long schedMillis;
+        size_t schedIndex;
     } Pin_t;
 
 public:
@@ -74,7 +78,7 @@ public:
 
 private:
     typedef struct __VPin_t {
-        uint8_t pin;
+        ERaVirtualPin_t pin;
         VirtualTypeT type;
         unsigned int configId;
     } VPin_t;
@@ -187,6 +191,7 @@ public:
     ERaPin(Report& _report)
         : report(_report)
         , numPin(0)
+        , hasDeleted(false)
     {
         memset(this->hashID, 0, sizeof(this->hashID));
     }
@@ -196,6 +201,15 @@ public:
     void run();
     bool updateHashID(const char* hash);
 
+    /* Milliseconds until a pin has to be read or reported */
+    unsigned long getNextTimeout(unsigned long maxDelay = ERA_SCHEDULER_MAX_DELAY) {
+        if (this->hasDeleted) {
+            return 0;
+        }
+        return ERaMin(this->pinTimer.remaining(ERaMillis(), maxDelay),
+                    this->report.getNextTimeout(maxDelay));
+    }
+
     iterator setPinReport(uint8_t p, uint8_t pMode, ERaPin::ReadPinHandler_t readPin,
                         unsigned long interval, unsigned long minInterval,
                         unsigned long maxInterval, float minChange,
@@ -215,7 +229,7 @@ public:
         return iterator(this, this->setupPinRaw(p, configId));
     }
 
-    VPin_t* setPinVirtual(uint8_t p, unsigned int configId,
+    VPin_t* setPinVirtual(ERaVirtualPin_t p, unsigned int configId,
                         VirtualTypeT type = VirtualTypeT::VIRTUAL_BASE) {
         return this->setupPinVirtual(p, configId, type);
     }
@@ -258,10 +272,10 @@ public:
     int findPinMode(uint8_t p) const;
     int findChannelPWM(uint8_t p) const;
     int findConfigId(uint8_t p, const ERaParam& param) const;
-    int findVPinConfigId(uint8_t p, const ERaParam& param) const;
-    int findVPinConfigId(uint8_t p, const ERaDataJson::iterator& param) const;
+    int findVPinConfigId(ERaVirtualPin_t p, const ERaParam& param) const;
+    int findVPinConfigId(ERaVirtualPin_t p, const ERaDataJson::iterator& param) const;
     int findChannelFree() const;
-    bool isVPinExist(uint8_t p, const WrapperBase* param) const;
+    bool isVPinExist(ERaVirtualPin_t p, const WrapperBase* param) const;
 
 protected:
 private:
@@ -274,7 +288,7 @@ private:
                         unsigned long maxInterval, float minChange,
                         ERaPin::ReportPinCallback_t cb, unsigned int configId);
     Pin_t* setupPinRaw(uint8_t p, unsigned int configId);
-    VPin_t* setupPinVirtual(uint8_t p, unsigned int configId,
+    VPin_t* setupPinVirtual(ERaVirtualPin_t p, unsigned int configId,
                             VirtualTypeT type = VirtualTypeT::VIRTUAL_BASE);
     Pin_t* setupPWMPinReport(uint8_t p, uint8_t pMode, uint8_t channel,
                             ERaPin::ReadPinHandler_t readPin, unsigned long interval,
@@ -289,7 +303,7 @@ private:
     bool isPinFree() const;
     bool isVPinFree() const;
     Pin_t* findPinExist(uint8_t p) const;
-    VPin_t* findVPinExist(uint8_t p) const;
+    VPin_t* findVPinExist(ERaVirtualPin_t p) const;
     Pin_t* findPinOfChannel(uint8_t channel) const;
 
     bool isValidPin(const Pin_t* pPin) const {
@@ -315,11 +329,27 @@ private:
         return (flags & mask) == mask;
     }
 
+    /* Only pins that are read periodically are scheduled */
+    void schedulePin(Pin_t* pPin, unsigned long currentMillis) {
+        if ((pPin->pinMode == RAW_PIN) ||
+            (pPin->pinMode == VIRTUAL)) {
+            this->pinTimer.cancel(pPin);
+            return;
+        }
+        unsigned long elapsed = (currentMillis - pPin->prevMillis);
+        this->pinTimer.scheduleIn(pPin, currentMillis,
+                            ((elapsed < pPin->delay) ? (pPin->delay - elapsed) : 0));
+    }
+
     Report& report;
+    ERaScheduler<Pin_t> pinTimer;
     ERaList<Pin_t*> pin;
     ERaList<VPin_t*> vPin;
+    ERaHashIndex<uint32_t, Pin_t> pinIndex;
+    ERaHashIndex<uint32_t, VPin_t> vPinIndex;
     unsigned int numPin;
     unsigned int numVPin;
+    bool hasDeleted;
     char hashID[37];
 
     using PinIterator = typename ERaList<Pin_t*>::iterator;
@@ -329,9 +359,8 @@ private:
 template <class Report>
 void ERaPin<Report>::run() {
     unsigned long currentMillis = ERaMillis();
-    const PinIterator* e = this->pin.end();
-    for (PinIterator* it = this->pin.begin(); it != e; it = it->getNext()) {
-        Pin_t* pPin = it->get();
+    Pin_t* pPin = nullptr;
+    while ((pPin = this->pinTimer.pop(currentMillis)) != nullptr) {
         if (!this->isValidPin(pPin)) {
             continue;
         }
@@ -340,11 +369,13 @@ void ERaPin<Report>::run() {
             continue;
         }
         if ((currentMillis - pPin->prevMillis) < pPin->delay) {
+            this->schedulePin(pPin, currentMillis);
             continue;
         }
         unsigned long skipTimes = ((currentMillis - pPin->prevMillis) / pPin->delay);
         // update time
         pPin->prevMillis += (pPin->delay * skipTimes);
+        this->schedulePin(pPin, currentMillis);
         // call update data
         if (!pPin->enable) {
             continue;
@@ -365,26 +396,32 @@ void ERaPin<Report>::run() {
         }
     }
 
-    PinIterator* next = nullptr;
-    for (PinIterator* it = this->pin.begin(); it != e; it = next) {
-        next = it->getNext();
-        Pin_t* pPin = it->get();
-        if (!this->isValidPin(pPin)) {
-            continue;
-        }
-        if (!pPin->called) {
-            continue;
-        }
-        if (this->getFlag(pPin->called, PinFlagT::PIN_ON_DELETE)) {
-            pPin->report.deleteReport();
-            delete pPin;
-            pPin = nullptr;
-            it->get() = nullptr;
-            this->pin.remove(it);
-            this->numPin--;
-            continue;
+    if (this->hasDeleted) {
+        this->hasDeleted = false;
+        const PinIterator* e = this->pin.end();
+        PinIterator* next = nullptr;
+        for (PinIterator* it = this->pin.begin(); it != e; it = next) {
+            next = it->getNext();
+            pPin = it->get();
+            if (!this->isValidPin(pPin)) {
+                continue;
+            }
+            if (!pPin->called) {
+                continue;
+            }
+            if (this->getFlag(pPin->called, PinFlagT::PIN_ON_DELETE)) {
+                pPin->report.deleteReport();
+                this->pinTimer.cancel(pPin);
+                this->pinIndex.remove(pPin->pin, pPin);
+                delete pPin;
+                pPin = nullptr;
+                it->get() = nullptr;
+                this->pin.remove(it);
+                this->numPin--;
+                continue;
+            }
+            pPin->called = 0;
         }
-        pPin->called = 0;
     }
 
     this->report.run();
@@ -427,6 +464,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPinReport(uint8_t p, uint8_
             return nullptr;
         }
         this->pin.put(pPin);
+        this->pinIndex.put(p, pPin);
         this->numPin++;
     }
     
@@ -446,6 +484,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPinReport(uint8_t p, uint8_
     pPin->channel = 0;
     pPin->enable = true;
     pPin->called = 0;
+    this->schedulePin(pPin, pPin->prevMillis);
     return pPin;
 }
 
@@ -474,6 +513,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPinReport(uint8_t p, uint8_
             return nullptr;
         }
         this->pin.put(pPin);
+        this->pinIndex.put(p, pPin);
         this->numPin++;
     }
 
@@ -493,6 +533,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPinReport(uint8_t p, uint8_
     pPin->channel = 0;
     pPin->enable = true;
     pPin->called = 0;
+    this->schedulePin(pPin, pPin->prevMillis);
     return pPin;
 }
 
@@ -508,6 +549,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPinRaw(uint8_t p, unsigned
             return nullptr;
         }
         this->pin.put(pPin);
+        this->pinIndex.put(p, pPin);
         this->numPin++;
     }
 
@@ -521,11 +563,12 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPinRaw(uint8_t p, unsigned
     pPin->channel = 0;
     pPin->enable = true;
     pPin->called = 0;
+    this->schedulePin(pPin, pPin->prevMillis);
     return pPin;
 }
 
 template <class Report>
-typename ERaPin<Report>::VPin_t* ERaPin<Report>::setupPinVirtual(uint8_t p, unsigned int configId, VirtualTypeT type) {
+typename ERaPin<Report>::VPin_t* ERaPin<Report>::setupPinVirtual(ERaVirtualPin_t p, unsigned int configId, VirtualTypeT type) {
     VPin_t* pVPin = this->findVPinExist(p);
     if (pVPin == nullptr) {
         if (!this->isVPinFree()) {
@@ -536,6 +579,7 @@ typename ERaPin<Report>::VPin_t* ERaPin<Report>::setupPinVirtual(uint8_t p, unsi
             return nullptr;
         }
         this->vPin.put(pVPin);
+        this->vPinIndex.put(p, pVPin);
         this->numVPin++;
     }
     
@@ -570,6 +614,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPWMPinReport(uint8_t p, uin
             return nullptr;
         }
         this->pin.put(pPin);
+        this->pinIndex.put(p, pPin);
         this->numPin++;
     }
 
@@ -589,6 +634,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPWMPinReport(uint8_t p, uin
     pPin->channel = channel;
     pPin->enable = true;
     pPin->called = 0;
+    this->schedulePin(pPin, pPin->prevMillis);
     return pPin;
 }
 
@@ -618,6 +664,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPWMPinReport(uint8_t p, uin
             return nullptr;
         }
         this->pin.put(pPin);
+        this->pinIndex.put(p, pPin);
         this->numPin++;
     }
     
@@ -637,6 +684,7 @@ typename ERaPin<Report>::Pin_t* ERaPin<Report>::setupPWMPinReport(uint8_t p, uin
     pPin->channel = channel;
     pPin->enable = true;
     pPin->called = 0;
+    this->schedulePin(pPin, pPin->prevMillis);
     return pPin;
 }
 
@@ -659,6 +707,7 @@ bool ERaPin<Report>::changeInterval(Pin_t* pPin, unsigned long interval,
 
     pPin->delay = interval;
     pPin->report.changeReportableChange(minInterval, maxInterval, minChange);
+    this->schedulePin(pPin, ERaMillis());
     return true;
 }
 
@@ -670,6 +719,7 @@ void ERaPin<Report>::restartPin(Pin_t* pPin) {
 
     pPin->report.restartReport();
     pPin->prevMillis = ERaMillis();
+    this->schedulePin(pPin, pPin->prevMillis);
 }
 
 template <class Report>
@@ -678,7 +728,9 @@ void ERaPin<Report>::executeNow(Pin_t* pPin) {
         return;
     }
 
-    pPin->prevMillis = ERaMillis() - pPin->delay;
+    unsigned long currentMillis = ERaMillis();
+    pPin->prevMillis = currentMillis - pPin->delay;
+    this->schedulePin(pPin, currentMillis);
     pPin->report();
 }
 
@@ -690,6 +742,7 @@ void ERaPin<Report>::deletePin(Pin_t* pPin) {
 
     if (this->isValidPin(pPin)) {
         this->setFlag(pPin->called, PinFlagT::PIN_ON_DELETE, true);
+        this->hasDeleted = true;
     }
 }
 
@@ -717,6 +770,8 @@ void ERaPin<Report>::deleteAll() {
         it->get() = nullptr;
     }
     this->pin.clear();
+    this->pinIndex.clear();
+    this->pinTimer.clear();
     this->numPin = 0;
 
     this->report.run();
@@ -732,6 +787,7 @@ void ERaPin<Report>::deleteAll() {
         it->get() = nullptr;
     }
     this->vPin.clear();
+    this->vPinIndex.clear();
     this->numVPin = 0;
 }
 
@@ -828,34 +884,22 @@ typename Report::ScaleData_t* ERaPin<Report>::getScale(Pin_t* pPin) const {
 
 template <class Report>
 typename Report::ScaleData_t* ERaPin<Report>::findScale(uint8_t p) const {
-    const PinIterator* e = this->pin.end();
-    for (PinIterator* it = this->pin.begin(); it != e; it = it->getNext()) {
-        Pin_t* pPin = it->get();
-        if (!this->isValidPin(pPin)) {
-            continue;
-        }
-        if (pPin->pin == p) {
-            return pPin->report.getScale();
-        }
+    Pin_t* pPin = this->findPinExist(p);
+    if (pPin == nullptr) {
+        return nullptr;
     }
 
-    return nullptr;
+    return pPin->report.getScale();
 }
 
 template <class Report>
 typename Report::iterator* ERaPin<Report>::getReport(uint8_t p) const {
-    const PinIterator* e = this->pin.end();
-    for (PinIterator* it = this->pin.begin(); it != e; it = it->getNext()) {
-        Pin_t* pPin = it->get();
-        if (!this->isValidPin(pPin)) {
-            continue;
-        }
-        if (pPin->pin == p) {
-            return &pPin->report;
-        }
+    Pin_t* pPin = this->findPinExist(p);
+    if (pPin == nullptr) {
+        return nullptr;
     }
 
-    return nullptr;
+    return &pPin->report;
 }
 
 template <class Report>
@@ -878,151 +922,103 @@ bool ERaPin<Report>::isVPinFree() const {
 
 template <class Report>
 typename ERaPin<Report>::Pin_t* ERaPin<Report>::findPinExist(uint8_t p) const {
-    const PinIterator* e = this->pin.end();
-    for (PinIterator* it = this->pin.begin(); it != e; it = it->getNext()) {
-        Pin_t* pPin = it->get();
-        if (!this->isValidPin(pPin)) {
-            continue;
-        }
-        if (pPin->pin == p) {
-            return pPin;
-        }
+    Pin_t* pPin = this->pinIndex.get(p);
+    if (!this->isValidPin(pPin)) {
+        return nullptr;
     }
 
-    return nullptr;
+    return pPin;
 }
 
 template <class Report>
-typename ERaPin<Report>::VPin_t* ERaPin<Report>::findVPinExist(uint8_t p) const {
-    const VPinIterator* e = this->vPin.end();
-    for (VPinIterator* it = this->vPin.begin(); it != e; it = it->getNext()) {
-        VPin_t* pVPin = it->get();
-        if (pVPin == nullptr) {
-            continue;
-        }
-        if (pVPin->pin == p) {
-            return pVPin;
-        }
-    }
-
-    return nullptr;
+typename ERaPin<Report>::VPin_t* ERaPin<Report>::findVPinExist(ERaVirtualPin_t p) const {
+    return this->vPinIndex.get(p);
 }
 
 template <class Report>
 int ERaPin<Report>::findPinMode(uint8_t p) const {
-    const PinIterator* e = this->pin.end();
-    for (PinIterator* it = this->pin.begin(); it != e; it = it->getNext()) {
-        Pin_t* pPin = it->get();
-        if (!this->isValidPin(pPin)) {
-            continue;
-        }
-        if (pPin->pin == p) {
-            return pPin->pinMode;
-        }
+    Pin_t* pPin = this->findPinExist(p);
+    if (pPin == nullptr) {
+        return -1;
     }
 
-    return -1;
+    return pPin->pinMode;
 }
 
 template <class Report>
 int ERaPin<Report>::findChannelPWM(uint8_t p) const {
-    const PinIterator* e = this->pin.end();
-    for (PinIterator* it = this->pin.begin(); it != e; it = it->getNext()) {
-        Pin_t* pPin = it->get();
-        if (!this->isValidPin(pPin)) {
-            continue;
-        }
-        if ((pPin->pin == p) &&
-            (pPin->pinMode == PWM)) {
-            return pPin->channel;
-        }
+    Pin_t* pPin = this->findPinExist(p);
+    if ((pPin == nullptr) ||
+        (pPin->pinMode != PWM)) {
+        return -1;
     }
 
-    return -1;
+    return pPin->channel;
 }
 
 template <class Report>
 int ERaPin<Report>::findConfigId(uint8_t p, const ERaParam& param) const {
-    const PinIterator* e = this->pin.end();
-    for (PinIterator* it = this->pin.begin(); it != e; it = it->getNext()) {
-        Pin_t* pPin = it->get();
-        if (!this->isValidPin(pPin)) {
-            continue;
-        }
-        if ((pPin->pin != p) ||
-            !pPin->configId) {
-            continue;
-        }
-        if (param.isNumber()) {
-            return pPin->configId;
-        }
-        else {
-            break;
-        }
+    Pin_t* pPin = this->findPinExist(p);
+    if ((pPin == nullptr) ||
+        !pPin->configId) {
+        return -1;
+    }
+    if (!param.isNumber()) {
+        return -1;
     }
 
-    return -1;
+    return pPin->configId;
 }
 
 template <class Report>
-int ERaPin<Report>::findVPinConfigId(uint8_t p, const ERaParam& param) const {
-    const VPinIterator* e = this->vPin.end();
-    for (VPinIterator* it = this->vPin.begin(); it != e; it = it->getNext()) {
-        VPin_t* pVPin = it->get();
-        if (pVPin == nullptr) {
-            continue;
-        }
-        if ((pVPin->pin != p) ||
-            !pVPin->configId) {
-            continue;
-        }
-        switch (pVPin->type) {
-            case VirtualTypeT::VIRTUAL_NUMBER:
-                if (param.isNumber()) {
-                    return pVPin->configId;
-                }
-                break;
-            case VirtualTypeT::VIRTUAL_STRING:
-                if (param.isString() || param.isObject()) {
-                    return pVPin->configId;
-                }
-                break;
-            case VirtualTypeT::VIRTUAL_BASE:
-            default:
+int ERaPin<Report>::findVPinConfigId(ERaVirtualPin_t p, const ERaParam& param) const {
+    VPin_t* pVPin = this->findVPinExist(p);
+    if ((pVPin == nullptr) ||
+        !pVPin->configId) {
+        return -1;
+    }
+
+    switch (pVPin->type) {
+        case VirtualTypeT::VIRTUAL_NUMBER:
+            if (param.isNumber()) {
                 return pVPin->configId;
-        }
+            }
+            break;
+        case VirtualTypeT::VIRTUAL_STRING:
+            if (param.isString() || param.isObject()) {
+                return pVPin->configId;
+            }
+            break;
+        case VirtualTypeT::VIRTUAL_BASE:
+        default:
+            return pVPin->configId;
     }
 
     return -1;
 }
 
 template <class Report>
-int ERaPin<Report>::findVPinConfigId(uint8_t p, const ERaDataJson::iterator& param) const {
-    const VPinIterator* e = this->vPin.end();
-    for (VPinIterator* it = this->vPin.begin(); it != e; it = it->getNext()) {
-        VPin_t* pVPin = it->get();
-        if (pVPin == nullptr) {
-            continue;
-        }
-        if ((pVPin->pin != p) ||
-            !pVPin->configId) {
-            continue;
-        }
-        switch (pVPin->type) {
-            case VirtualTypeT::VIRTUAL_NUMBER:
-                if (param.isNumber() || param.isBool()) {
-                    return pVPin->configId;
-                }
-                break;
-            case VirtualTypeT::VIRTUAL_STRING:
-                if (param.isString() || param.isNull()) {
-                    return pVPin->configId;
-                }
-                break;
-            case VirtualTypeT::VIRTUAL_BASE:
-            default:
+int ERaPin<Report>::findVPinConfigId(ERaVirtualPin_t p, const ERaDataJson::iterator& param) const {
+    VPin_t* pVPin = this->findVPinExist(p);
+    if ((pVPin == nullptr) ||
+        !pVPin->configId) {
+        return -1;
+    }
+
+    switch (pVPin->type) {
+        case VirtualTypeT::VIRTUAL_NUMBER:
+            if (param.isNumber() || param.isBool()) {
                 return pVPin->configId;
-        }
+            }
+            break;
+        case VirtualTypeT::VIRTUAL_STRING:
+            if (param.isString() || param.isNull()) {
+                return pVPin->configId;
+            }
+            break;
+        case VirtualTypeT::VIRTUAL_BASE:
+        default:
+            return pVPin->configId;
     }
 
     return -1;
@@ -1040,7 +1036,7 @@ int ERaPin<Report>::findChannelFree() const {
 }
 
 template <class Report>
-bool ERaPin<Report>::isVPinExist(uint8_t p, const WrapperBase* param) const {
+bool ERaPin<Report>::isVPinExist(ERaVirtualPin_t p, const WrapperBase* param) const {
     VPin_t* pVPin = this->findVPinExist(p);
     if (pVPin == nullptr) {
         return false;
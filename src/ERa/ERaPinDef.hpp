@@ -2,6 +2,14 @@
 #define INC_ERA_PIN_DEFINE_HPP_
 
 #include <stdint.h>
+#include <ERa/ERaDetect.hpp>
+
+#if !defined(ERA_VIRTUAL_PIN_TYPE)
+    #define ERA_VIRTUAL_PIN_TYPE        uint8_t
+#endif
+
+/* Virtual pin number, 32-bit on Linux where pins are looked up by hash */
+typedef ERA_VIRTUAL_PIN_TYPE ERaVirtualPin_t;
 
 typedef struct __PinConfig_t {
     uint8_t pin;
@@ -5,6 +5,9 @@
 #include <Utility/ERaUtility.hpp>
 #include <ERa/ERaReport.hpp>
 #include <ERa/ERaParam.hpp>
+#include <ERa/ERaPinDef.hpp>
+#include <Utility/ERaHashIndex.hpp>
+#include <Utility/ERaJsonWriter.hpp>
 #include "types/WrapperTypes.hpp"
 
 #if defined(__has_include) &&       \
@@ -147,7 +150,7 @@ public:
     ~ERaProperty()
     {}
 
-    iterator getPropertyVirtual(uint8_t pin) {
+    iterator getPropertyVirtual(ERaVirtualPin_t pin) {
         return iterator(this, this->isPropertyIdExist(pin));
     }
 
@@ -164,67 +167,67 @@ public:
         return this->addPropertyVirtual(pin, value, permission);
     }
 
-    iterator addPropertyVirtual(uint8_t pin, bool& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, bool& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperBool(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, int& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, int& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperInt(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, unsigned int& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, unsigned int& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperUnsignedInt(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, long& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, long& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperLong(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, unsigned long& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, unsigned long& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperUnsignedLong(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, long long& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, long long& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperLongLong(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, unsigned long long& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, unsigned long long& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperUnsignedLongLong(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, float& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, float& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperFloat(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, double& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, double& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperDouble(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, ERaDataJson& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, ERaDataJson& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperObject(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, ERaString& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, ERaString& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperString(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
 
-    iterator addPropertyVirtual(uint8_t pin, WrapperBase& value, PermissionT const permission) {
+    iterator addPropertyVirtual(ERaVirtualPin_t pin, WrapperBase& value, PermissionT const permission) {
         return iterator(this, this->setupProperty(pin, &value, permission));
     }
 
     template <typename T>
-    iterator addPropertyVirtualT(uint8_t pin, T& value, PermissionT const permission) {
+    iterator addPropertyVirtualT(ERaVirtualPin_t pin, T& value, PermissionT const permission) {
         WrapperBase* wrapper = new WrapperNumber<T>(value);
         return iterator(this, this->setupProperty(pin, wrapper, permission));
     }
@@ -370,13 +373,14 @@ public:
 
 protected:
     void run();
-    void handler(uint8_t pin, const ERaParam& param);
+    unsigned long getNextTimeout(unsigned long maxDelay);
+    void handler(ERaVirtualPin_t pin, const ERaParam& param);
     void handler(const char* id, const ERaParam& param);
     void updateProperty(const ERaPin<ERaReport>& pin);
 
 #if !defined(ERA_VIRTUAL_WRITE_LEGACY)
     template <typename T>
-    void virtualWriteProperty(uint8_t pin, T value) {
+    void virtualWriteProperty(ERaVirtualPin_t pin, T value) {
         Property_t* pProp = this->isPropertyIdExist(pin);
         if (pProp != nullptr) {
             (*pProp->value) = value;
@@ -397,7 +401,7 @@ protected:
         this->addPropertyVirtual(pin, *wrapper, PermissionT::PERMISSION_CLOUD_READ_WRITE).publishOnChange(0, this->writeTimeout).publish().allocatorPointer(pValue);
     }
 
-    void virtualWriteProperty(uint8_t pin, const ERaParam& value) {
+    void virtualWriteProperty(ERaVirtualPin_t pin, const ERaParam& value) {
         if (value.isNumber()) {
             this->virtualWriteProperty(pin, value.getDouble());
         }
@@ -406,15 +410,15 @@ protected:
         }
     }
 
-    void virtualWriteProperty(uint8_t pin, ERaDataJson& value) {
+    void virtualWriteProperty(ERaVirtualPin_t pin, ERaDataJson& value) {
         this->virtualWriteProperty(pin, value.getString());
     }
 
-    void virtualWriteProperty(uint8_t pin, const ERaString& value) {
+    void virtualWriteProperty(ERaVirtualPin_t pin, const ERaString& value) {
         this->virtualWriteProperty(pin, value.getString());
     }
 
-    void virtualWriteProperty(uint8_t pin, const char* value) {
+    void virtualWriteProperty(ERaVirtualPin_t pin, const char* value) {
         Property_t* pProp = this->isPropertyIdExist(pin);
         if (pProp != nullptr) {
             (*pProp->value) = value;
@@ -437,14 +441,16 @@ protected:
         this->addPropertyVirtual(pin, *wrapper, PermissionT::PERMISSION_CLOUD_READ_WRITE).publishOnChange(0, this->writeTimeout).allocatorPointer(pValue);
     }
 
-    void virtualWriteProperty(uint8_t pin, char* value) {
+    void virtualWriteProperty(ERaVirtualPin_t pin, char* value) {
         this->virtualWriteProperty(pin, (const char*)value);
     }
 #endif
 
 private:
+    using PropertyIterator = typename ERaList<Property_t*>::iterator;
+
     void updateValue(const Property_t* pProp);
-    Property_t* setupProperty(uint8_t pin, WrapperBase* value, PermissionT const permission);
+    Property_t* setupProperty(ERaVirtualPin_t pin, WrapperBase* value, PermissionT const permission);
     Property_t* setupProperty(const char* id, WrapperBase* value, PermissionT const permission);
 #if defined(ERA_HAS_PROGMEM)
     Property_t* setupProperty(const __FlashStringHelper* id, WrapperBase* value, PermissionT const permission);
@@ -461,13 +467,18 @@ private:
     bool isPropertyFree();
     int findVirtualPin();
 
-    template <typename T>
-    Property_t* isPropertyIdExist(T pin);
+    Property_t* isPropertyIdExist(int pin);
+    Property_t* isPropertyIdExist(const char* id);
+    void indexProperty(Property_t* pProp);
+    void unindexProperty(const Property_t* pProp);
 
     size_t splitString(char* strInput, const char* delims);
 
     void onCallbackVirtual(const Property_t* const pProp);
     void onCallbackReal(const Property_t* const pProp);
+    const char* getPropertyKey(const Property_t* pProp, const char* device);
+    bool isKeyWrittenLater(PropertyIterator* it, const Property_t* const pProp,
+                            const char* device, const char* key);
     void onCallback(void* args);
 #if !defined(PROPERTY_HAS_FUNCTIONAL_H)
     static void _onCallback(void* args);
@@ -505,12 +516,12 @@ private:
 #endif
 
     ERaList<Property_t*> ERaProp;
+    ERaHashIndex<uint32_t, Property_t> propPinIndex;
+    ERaHashIndex<const char*, Property_t> propIdIndex;
     ERaReport ERaPropRp;
     unsigned int numProperty;
     unsigned long timeout;
     unsigned long writeTimeout;
-
-    using PropertyIterator = typename ERaList<Property_t*>::iterator;
 };
 
 template <class Api>
@@ -541,6 +552,15 @@ void ERaProperty<Api>::run() {
     this->ERaPropRp.run();
 }
 
+template <class Api>
+unsigned long ERaProperty<Api>::getNextTimeout(unsigned long maxDelay) {
+    // bound values are polled, they can change at any time
+    if (this->ERaProp.readable()) {
+        maxDelay = ERaMin(maxDelay, this->timeout);
+    }
+    return this->ERaPropRp.getNextTimeout(maxDelay);
+}
+
 template <class Api>
 void ERaProperty<Api>::updateValue(const Property_t* pProp) {
     switch (pProp->value->getType()) {
@@ -581,23 +601,12 @@ void ERaProperty<Api>::updateValue(const Property_t* pProp) {
 }
 
 template <class Api>
-void ERaProperty<Api>::handler(uint8_t pin, const ERaParam& param) {
+void ERaProperty<Api>::handler(ERaVirtualPin_t pin, const ERaParam& param) {
     bool found {false};
-    Property_t* pProp = nullptr;
-    const PropertyIterator* e = this->ERaProp.end();
-    for (PropertyIterator* it = this->ERaProp.begin(); it != e; it = it->getNext()) {
-        pProp = it->get();
-        if (!this->isValidProperty(pProp)) {
-            continue;
-        }
-        if (!pProp->id.isNumber()) {
-            continue;
-        }
-        if (pProp->id == pin) {
-            found = true;
-            this->getValue(pProp, param);
-            break;
-        }
+    Property_t* pProp = this->isPropertyIdExist(pin);
+    if (this->isValidProperty(pProp)) {
+        found = true;
+        this->getValue(pProp, param);
     }
 #if !defined(ERA_VIRTUAL_WRITE_LEGACY)
     if (!found) {
@@ -618,22 +627,9 @@ void ERaProperty<Api>::handler(uint8_t pin, const ERaParam& param) {
 
 template <class Api>
 void ERaProperty<Api>::handler(const char* id, const ERaParam& param) {
-    bool found {false};
-    Property_t* pProp = nullptr;
-    const PropertyIterator* e = this->ERaProp.end();
-    for (PropertyIterator* it = this->ERaProp.begin(); it != e; it = it->getNext()) {
-        pProp = it->get();
-        if (!this->isValidProperty(pProp)) {
-            continue;
-        }
-        if (!pProp->id.isString()) {
-            continue;
-        }
-        if (pProp->id == id) {
-            found = true;
-            this->getValue(pProp, param);
-            break;
-        }
+    Property_t* pProp = this->isPropertyIdExist(id);
+    if (this->isValidProperty(pProp)) {
+        this->getValue(pProp, param);
     }
 }
 
@@ -676,6 +672,7 @@ void ERaProperty<Api>::handler(const char* id, const ERaParam& param) {
                     pProp->value = nullptr;
                 }
                 pProp->report.deleteReport();
+                this->unindexProperty(pProp);
                 delete pProp;
                 pProp = nullptr;
                 it->get() = nullptr;
@@ -739,7 +736,7 @@ void ERaProperty<Api>::getValue(Property_t* pProp, const ERaParam& param) {
 }
 
 template <class Api>
-typename ERaProperty<Api>::Property_t* ERaProperty<Api>::setupProperty(uint8_t pin, WrapperBase* value,
+typename ERaProperty<Api>::Property_t* ERaProperty<Api>::setupProperty(ERaVirtualPin_t pin, WrapperBase* value,
                                                                     PermissionT const permission) {
     if (!this->isPropertyFree()) {
         return nullptr;
@@ -762,6 +759,7 @@ typename ERaProperty<Api>::Property_t* ERaProperty<Api>::setupProperty(uint8_t p
     pProp->report = ERaReport::iterator();
     this->publishOnChange(pProp);
     this->ERaProp.put(pProp);
+    this->indexProperty(pProp);
     this->numProperty++;
     return pProp;
 }
@@ -794,6 +792,7 @@ typename ERaProperty<Api>::Property_t* ERaProperty<Api>::setupProperty(const cha
     pProp->report = ERaReport::iterator();
     this->publishOnChange(pProp);
     this->ERaProp.put(pProp);
+    this->indexProperty(pProp);
     this->numProperty++;
     return pProp;
 }
@@ -959,146 +958,179 @@ void ERaProperty<Api>::onCallbackReal(const Property_t* const pProp) {
         return;
     }
 
-    cJSON* root = cJSON_CreateObject();
-    if (root == nullptr) {
-        return;
-    }
-    cJSON* dataItem = cJSON_CreateObject();
-    if (dataItem == nullptr) {
-        cJSON_Delete(root);
-        root = nullptr;
-        return;
-    }
     char topic[65] {0};
     FormatString(topic, TOPIC_PROPERTY_DATA, arrayId.at(0).getString());
 
-    cJSON_AddStringToObject(root, "type", "device_data");
-    cJSON_AddItemToObject(root, "data", dataItem);
+    char buffer[ERA_JSON_WRITER_SIZE] {0};
+    ERaJsonWriter writer(buffer, sizeof(buffer));
+    writer.beginObject();
+    writer.add("type", "device_data");
+    writer.beginObject("data");
 
+    const char* device = arrayId.at(0).getString();
     const PropertyIterator* e = this->ERaProp.end();
     for (PropertyIterator* it = this->ERaProp.begin(); it != e; it = it->getNext()) {
         Property_t* property = it->get();
-        if (!this->isValidProperty(property)) {
-            continue;
-        }
-        if (!property->id.isString()) {
-            continue;
-        }
-        if (property->id.getString() == nullptr) {
-            continue;
-        }
-        if (strncmp(property->id.getString(),
-                    arrayId.at(0).getString(),
-                    strlen(arrayId.at(0).getString()))) {
-            continue;
-        }
-        const char* ptrColon = strchr(property->id.getString(), ':');
+        const char* ptrColon = this->getPropertyKey(property, device);
         if (ptrColon == nullptr) {
             continue;
         }
-        ptrColon++;
 
+        bool hasValue = true;
+        double value {0};
         if (property == pProp) {
             switch (property->value->getType()) {
                 case WrapperTypeT::WRAPPER_TYPE_BOOL:
                     property->report.updateReport(property->value->getBool(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getBool());
+                    value = (double)property->value->getBool();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_INT:
                     property->report.updateReport(property->value->getInt(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getInt());
+                    value = (double)property->value->getInt();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_INT:
                     property->report.updateReport(property->value->getUnsignedInt(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getUnsignedInt());
+                    value = (double)property->value->getUnsignedInt();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_LONG:
                     property->report.updateReport(property->value->getLong(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getLong());
+                    value = (double)property->value->getLong();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_LONG:
                     property->report.updateReport(property->value->getUnsignedLong(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getUnsignedLong());
+                    value = (double)property->value->getUnsignedLong();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_LONG_LONG:
                     property->report.updateReport(property->value->getLongLong(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getLongLong());
+                    value = (double)property->value->getLongLong();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_LONG_LONG:
                     property->report.updateReport(property->value->getUnsignedLongLong(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getUnsignedLongLong());
+                    value = (double)property->value->getUnsignedLongLong();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_FLOAT:
                     property->report.updateReport(property->value->getFloat(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getFloat());
+                    value = property->value->getFloat();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_DOUBLE:
                     property->report.updateReport(property->value->getFloat(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getDouble());
+                    value = property->value->getDouble();
                     break;
                 case WrapperTypeT::WRAPPER_TYPE_NUMBER:
                     property->report.updateReport(property->value->getFloat(), false, false);
-                    cJSON_SetNumberToObject(dataItem, ptrColon, property->value->getNumber());
+                    value = (double)property->value->getNumber();
                     break;
                 default:
+                    hasValue = false;
                     break;
             }
-            continue;
         }
+        else if (property->report.isReported()) {
+            switch (property->value->getType()) {
+                case WrapperTypeT::WRAPPER_TYPE_BOOL:
+                    value = (double)(bool)property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_INT:
+                    value = (double)(int)property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_INT:
+                    value = (double)(unsigned int)property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_LONG:
+                    value = (double)(long)property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_LONG:
+                    value = (double)(unsigned long)property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_LONG_LONG:
+                    value = (double)(long long)property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_LONG_LONG:
+                    value = (double)(unsigned long long)property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_FLOAT:
+                    value = property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_DOUBLE:
+                    value = property->report.getPreviousValue();
+                    break;
+                case WrapperTypeT::WRAPPER_TYPE_NUMBER:
+                    value = property->report.getPreviousValue();
+                    break;
+                default:
+                    hasValue = false;
+                    break;
+            }
 
-        if (!property->report.isReported()) {
-            continue;
+            if (property->report.isCalled()) {
+                property->report.skipReport();
+            }
         }
-
-        switch (property->value->getType()) {
-            case WrapperTypeT::WRAPPER_TYPE_BOOL:
-                cJSON_SetNumberToObject(dataItem, ptrColon, (bool)property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_INT:
-                cJSON_SetNumberToObject(dataItem, ptrColon, (int)property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_INT:
-                cJSON_SetNumberToObject(dataItem, ptrColon, (unsigned int)property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_LONG:
-                cJSON_SetNumberToObject(dataItem, ptrColon, (long)property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_LONG:
-                cJSON_SetNumberToObject(dataItem, ptrColon, (unsigned long)property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_LONG_LONG:
-                cJSON_SetNumberToObject(dataItem, ptrColon, (long long)property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_UNSIGNED_LONG_LONG:
-                cJSON_SetNumberToObject(dataItem, ptrColon, (unsigned long long)property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_FLOAT:
-                cJSON_SetNumberToObject(dataItem, ptrColon, property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_DOUBLE:
-                cJSON_SetNumberToObject(dataItem, ptrColon, property->report.getPreviousValue());
-                break;
-            case WrapperTypeT::WRAPPER_TYPE_NUMBER:
-                cJSON_SetNumberToObject(dataItem, ptrColon, property->report.getPreviousValue());
-                break;
-            default:
-                break;
+        else {
+            continue;
         }
 
-        if (property->report.isCalled()) {
-            property->report.skipReport();
+        /* Last property with the same key wins, as with cJSON_SetNumberToObject */
+        if (hasValue && !this->isKeyWrittenLater(it, pProp, device, ptrColon)) {
+            writer.add(ptrColon, value);
         }
     }
 
-    this->thisApi().specificDataWrite(topic, root, true, true);
-    cJSON_Delete(root);
-    root = nullptr;
-    dataItem = nullptr;
+    writer.endObject();
+    writer.endObject();
+    if (!writer.isOverflow()) {
+        this->thisApi().specificDataWrite(topic, writer.getString(), true, true);
+    }
 #endif
     // Update later
     ERA_FORCE_UNUSED(pProp);
 }
 
+template <class Api>
+const char* ERaProperty<Api>::getPropertyKey(const Property_t* pProp, const char* device) {
+    if (!this->isValidProperty(pProp)) {
+        return nullptr;
+    }
+    if (!pProp->id.isString()) {
+        return nullptr;
+    }
+    if (pProp->id.getString() == nullptr) {
+        return nullptr;
+    }
+    if (strncmp(pProp->id.getString(), device, strlen(device))) {
+        return nullptr;
+    }
+    const char* ptrColon = strchr(pProp->id.getString(), ':');
+    if (ptrColon == nullptr) {
+        return nullptr;
+    }
+    return (ptrColon + 1);
+}
+
+template <class Api>
+bool ERaProperty<Api>::isKeyWrittenLater(PropertyIterator* it, const Property_t* const pProp,
+                                          const char* device, const char* key) {
+    const PropertyIterator* e = this->ERaProp.end();
+    for (it = it->getNext(); it != e; it = it->getNext()) {
+        const Property_t* property = it->get();
+        const char* ptrColon = this->getPropertyKey(property, device);
+        if (ptrColon == nullptr) {
+            continue;
+        }
+        if (strcmp(ptrColon, key)) {
+            continue;
+        }
+        if ((property != pProp) && !property->report.isReported()) {
+            continue;
+        }
+        if ((property->value->getType() != WrapperTypeT::WRAPPER_TYPE_INVALID) &&
+            (property->value->getType() != WrapperTypeT::WRAPPER_TYPE_STRING)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 template <class Api>
 void ERaProperty<Api>::onCallback(void* args) {
     ERaProperty::Property_t* pProp = (ERaProperty::Property_t*)args;
@@ -1140,16 +1172,72 @@ int ERaProperty<Api>::findVirtualPin() {
 }
 
 template <class Api>
-template <typename T>
-typename ERaProperty<Api>::Property_t* ERaProperty<Api>::isPropertyIdExist(T pin) {
+typename ERaProperty<Api>::Property_t* ERaProperty<Api>::isPropertyIdExist(int pin) {
+    Property_t* pProp = this->propPinIndex.get((uint32_t)pin);
+    return (this->isValidProperty(pProp) ? pProp : nullptr);
+}
+
+template <class Api>
+typename ERaProperty<Api>::Property_t* ERaProperty<Api>::isPropertyIdExist(const char* id) {
+    if (id == nullptr) {
+        return nullptr;
+    }
+    Property_t* pProp = this->propIdIndex.get(id);
+    return (this->isValidProperty(pProp) ? pProp : nullptr);
+}
+
+/* The first property registered with an id keeps the index entry */
+template <class Api>
+void ERaProperty<Api>::indexProperty(Property_t* pProp) {
+    if (pProp->id.isNumber()) {
+        uint32_t pin = (uint32_t)pProp->id.getInt();
+        if (this->propPinIndex.get(pin) == nullptr) {
+            this->propPinIndex.put(pin, pProp);
+        }
+    }
+    else if (pProp->id.isString() &&
+            (pProp->id.getString() != nullptr)) {
+        const char* id = pProp->id.getString();
+        if (this->propIdIndex.get(id) == nullptr) {
+            this->propIdIndex.put(id, pProp);
+        }
+    }
+}
+
+/* A later property with the same id takes over the index entry */
+template <class Api>
+void ERaProperty<Api>::unindexProperty(const Property_t* pProp) {
+    bool removed {false};
+    if (pProp->id.isNumber()) {
+        removed = this->propPinIndex.remove((uint32_t)pProp->id.getInt(), pProp);
+    }
+    else if (pProp->id.isString() &&
+            (pProp->id.getString() != nullptr)) {
+        removed = this->propIdIndex.remove(pProp->id.getString(), pProp);
+    }
+    if (!removed) {
+        return;
+    }
+
     const PropertyIterator* e = this->ERaProp.end();
     for (PropertyIterator* it = this->ERaProp.begin(); it != e; it = it->getNext()) {
-        Property_t* pProp = it->get();
-        if (pProp->id == pin) {
-            return pProp;
+        Property_t* other = it->get();
+        if (!this->isValidProperty(other) || (other == pProp)) {
+            continue;
+        }
+        if (pProp->id.isNumber()) {
+            if (other->id.isNumber() &&
+                (other->id.getInt() == pProp->id.getInt())) {
+                this->indexProperty(other);
+                break;
+            }
+        }
+        else if (other->id.isString() &&
+                ERaStrCmp(other->id.getString(), pProp->id.getString())) {
+            this->indexProperty(other);
+            break;
         }
     }
-    return nullptr;
 }
 
 template <class Api>
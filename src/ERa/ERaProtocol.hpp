@@ -22,6 +22,7 @@
 #include <ERa/ERaCallbacks.hpp>
 #include <OTA/ERaOTA.hpp>
 #include <Utility/ERaInfo.hpp>
+#include <Utility/ERaJsonWriter.hpp>
 
 #if defined(__has_include) &&       \
     __has_include(<functional>) &&  \
@@ -116,6 +117,15 @@ public:
         this->publishHeartbeat();
     }
 
+    unsigned long getNextTimeout(unsigned long maxDelay) {
+        if (this->heartbeat) {
+            unsigned long elapsed = (ERaMillis() - this->lastHeartbeat);
+            maxDelay = ERaMin(maxDelay, ((elapsed < this->heartbeat) ?
+                                        (this->heartbeat - elapsed) : 0UL));
+        }
+        return Base::getNextTimeout(maxDelay);
+    }
+
     void setERaORG(const char* org) {
         if (org == nullptr) {
             return;
@@ -157,11 +167,16 @@ public:
     }
 
     void setERaLogger(ERaLogger& _logger) override {
-        this->pLogger = &_logger;
+        this->setERaLogger(&_logger);
     }
 
     void setERaLogger(ERaLogger* _pLogger) override {
         this->pLogger = _pLogger;
+        if (this->pLogger != nullptr) {
+            this->pLogger->onReplay(ERaProto::replayLoggerData, this);
+        }
+        this->transp.onUndelivered((this->pLogger != nullptr) ?
+                                   ERaProto::storeUndelivered : nullptr, this);
     }
 
     ERaLogger* getERaLogger() const {
@@ -267,6 +282,7 @@ private:
     bool sendPinMultiData(ERaRsp_t& rsp);
     bool sendConfigIdData(ERaRsp_t& rsp);
     bool sendConfigIdMultiData(ERaRsp_t& rsp);
+    bool publishValue(const char* topicName, const char* name, ERaRsp_t& rsp);
 #if defined(ERA_MODBUS)
     bool sendModbusData(ERaRsp_t& rsp);
 #endif
@@ -276,6 +292,33 @@ private:
 #if defined(ERA_SPECIFIC)
     bool sendSpecificData(ERaRsp_t& rsp);
 #endif
+    static bool replayLoggerData(void* args, const char* subPath,
+                                const char* id, const char* data,
+                                unsigned long timestamp);
+    static void storeUndelivered(void* args, const char* topic,
+                                const char* payload);
+
+    bool isLoggerData(const ERaRsp_t& rsp) const {
+        if (this->pLogger == nullptr) {
+            return false;
+        }
+        switch (rsp.type) {
+#if defined(ERA_MODBUS)
+            case ERaTypeWriteT::ERA_WRITE_MODBUS_DATA:
+                return true;
+#endif
+#if defined(ERA_ZIGBEE)
+            case ERaTypeWriteT::ERA_WRITE_ZIGBEE_DATA:
+                return true;
+#endif
+#if defined(ERA_SPECIFIC)
+            case ERaTypeWriteT::ERA_WRITE_SPECIFIC_DATA:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
     void sendCommandVirtualMulti(const char* auth, ERaRsp_t& rsp, ERaDataJson* data);
 #if defined(ERA_ZIGBEE)
     void sendCommandZigbee(const char* auth, ERaRsp_t& rsp);
@@ -483,6 +526,7 @@ void ERaProto<Transp, Flash>::processDownAction(const char* payload, cJSON* root
         ERaState::set(StateT::STATE_OTA_UPGRADE);
     }
     else if (ERaStrCmp(item->valuestring, "reset_eeprom")) {
+        Base::beginFlashBatch();
         Base::removePinConfig();
 #if defined(ERA_BT)
         Base::removeBluetoothConfig();
@@ -490,6 +534,7 @@ void ERaProto<Transp, Flash>::processDownAction(const char* payload, cJSON* root
 #if defined(ERA_MODBUS)
         Base::Modbus::removeConfigFromFlash();
 #endif
+        Base::commitFlashBatch();
         ERaDelay(1000);
         ERaState::set(StateT::STATE_RESET_CONFIG_REBOOT);
     }
@@ -988,15 +1033,9 @@ bool ERaProto<Transp, Flash>::sendPinData(ERaRsp_t& rsp) {
     }
 
     char name[50] {0};
-    bool status {false};
-    char* payload = nullptr;
     char topicName[MAX_TOPIC_LENGTH] {0};
     FormatString(topicName, this->ERA_TOPIC);
     FormatString(topicName, ERA_PUB_PREFIX_PIN_DATA_TOPIC);
-    cJSON* root = cJSON_CreateObject();
-    if (root == nullptr) {
-        return false;
-    }
     switch (rsp.type) {
     case ERaTypeWriteT::ERA_WRITE_VIRTUAL_PIN:
         FormatString(name, "virtual_pin_%d", rsp.id.getInt());
@@ -1014,28 +1053,9 @@ bool ERaProto<Transp, Flash>::sendPinData(ERaRsp_t& rsp) {
         FormatString(name, "pin_%d", rsp.id.getInt());
         break;
     default:
-        cJSON_Delete(root);
-        root = nullptr;
         return false;
     }
-    if (rsp.param.isString()) {
-        cJSON_AddStringToObject(root, name, rsp.param.getString());
-    }
-    else if (rsp.param.isNumber()) {
-        cJSON_AddNumberWithDecimalToObject(root, name, rsp.param.getDouble(), 5);
-    }
-    else if (rsp.param.isObject()) {
-        cJSON_AddStringToObject(root, name, rsp.param.getObject()->getString());
-    }
-    payload = cJSON_PrintUnformatted(root);
-    if (payload != nullptr) {
-        status = this->transp.publishData(topicName, payload, rsp.retained);
-    }
-    cJSON_Delete(root);
-    free(payload);
-    root = nullptr;
-    payload = nullptr;
-    return status;
+    return this->publishValue(topicName, name, rsp);
 }
 
 template <class Transp, class Flash>
@@ -1055,33 +1075,32 @@ bool ERaProto<Transp, Flash>::sendPinMultiData(ERaRsp_t& rsp) {
 
 template <class Transp, class Flash>
 bool ERaProto<Transp, Flash>::sendConfigIdData(ERaRsp_t& rsp) {
-    bool status {false};
-    char* payload = nullptr;
     char topicName[MAX_TOPIC_LENGTH] {0};
     FormatString(topicName, this->ERA_TOPIC);
     FormatString(topicName, ERA_PUB_PREFIX_CONFIG_DATA_TOPIC, rsp.id.getInt());
-    cJSON* root = cJSON_CreateObject();
-    if (root == nullptr) {
-        return false;
-    }
+    return this->publishValue(topicName, "v", rsp);
+}
+
+/* {"name": value} written on the stack, no cJSON tree */
+template <class Transp, class Flash>
+bool ERaProto<Transp, Flash>::publishValue(const char* topicName, const char* name, ERaRsp_t& rsp) {
+    char buffer[ERA_JSON_WRITER_SIZE] {0};
+    ERaJsonWriter writer(buffer, sizeof(buffer));
+    writer.beginObject();
     if (rsp.param.isString()) {
-        cJSON_AddStringToObject(root, "v", rsp.param.getString());
+        writer.add(name, rsp.param.getString());
     }
     else if (rsp.param.isNumber()) {
-        cJSON_AddNumberWithDecimalToObject(root, "v", rsp.param.getDouble(), 5);
+        writer.add(name, rsp.param.getDouble(), 5);
     }
     else if (rsp.param.isObject()) {
-        cJSON_AddStringToObject(root, "v", rsp.param.getObject()->getString());
+        writer.add(name, rsp.param.getObject()->getString());
     }
-    payload = cJSON_PrintUnformatted(root);
-    if (payload != nullptr) {
-        status = this->transp.publishData(topicName, payload, rsp.retained);
+    writer.endObject();
+    if (writer.isOverflow()) {
+        return false;
     }
-    cJSON_Delete(root);
-    free(payload);
-    root = nullptr;
-    payload = nullptr;
-    return status;
+    return this->transp.publishData(topicName, writer.getString(), rsp.retained);
 }
 
 template <class Transp, class Flash>
@@ -1173,6 +1192,71 @@ bool ERaProto<Transp, Flash>::sendConfigIdMultiData(ERaRsp_t& rsp) {
     }
 #endif
 
+/* Replayed on the history sub-topic with the capture time, so an old
+   reading neither overwrites a live value nor is stamped at replay time */
+template <class Transp, class Flash>
+bool ERaProto<Transp, Flash>::replayLoggerData(void* args, const char* subPath,
+                                            const char* id, const char* data,
+                                            unsigned long timestamp) {
+    ERaProto* proto = (ERaProto*)args;
+    if ((proto == nullptr) || !proto->connected()) {
+        return false;
+    }
+    char topicName[MAX_TOPIC_LENGTH] {0};
+    FormatString(topicName, proto->ERA_TOPIC);
+    if (ERaStrCmp(subPath, "modbus")) {
+        FormatString(topicName, ERA_PUB_PREFIX_MODBUS_DATA_TOPIC);
+    }
+    else if ((id != nullptr) && strlen(id)) {
+        FormatString(topicName, id);
+    }
+    else {
+        /* Nowhere to publish it, drop the record */
+        return true;
+    }
+    FormatString(topicName, ERA_PUB_SUFFIX_HISTORY_TOPIC);
+
+    char buffer[ERA_JSON_WRITER_SIZE] {0};
+    ERaJsonWriter writer(buffer, sizeof(buffer));
+    writer.beginObject();
+    writer.add("ts", (double)timestamp);
+    if ((data[0] == '{') || (data[0] == '[')) {
+        writer.addRaw("data", data);
+    }
+    else {
+        writer.add("data", data);
+    }
+    writer.endObject();
+    if (writer.isOverflow()) {
+        return false;
+    }
+    return proto->transp.publishData(topicName, writer.getString());
+}
+
+/* Keeps a publish the broker never acknowledged, replayed under ERA_TOPIC like the others */
+template <class Transp, class Flash>
+void ERaProto<Transp, Flash>::storeUndelivered(void* args, const char* topic,
+                                            const char* payload) {
+    ERaProto* proto = (ERaProto*)args;
+    if ((proto == nullptr) || (proto->pLogger == nullptr)) {
+        return;
+    }
+    if ((topic == nullptr) || (payload == nullptr)) {
+        return;
+    }
+    size_t length = strlen(proto->ERA_TOPIC);
+    if (strncmp(topic, proto->ERA_TOPIC, length)) {
+        return;
+    }
+    const char* subTopic = (topic + length);
+    if (ERaStrCmp(subTopic, ERA_PUB_PREFIX_MODBUS_DATA_TOPIC)) {
+        proto->pLogger->put("modbus", "", payload, false);
+    }
+    else if (strlen(subTopic)) {
+        proto->pLogger->put("mqtt", subTopic, payload, false, true);
+    }
+}
+
 template <class Transp, class Flash>
 void ERaProto<Transp, Flash>::sendCommand(const char* auth, ERaRsp_t& rsp, ApiData_t data) {
     if (!this->connected()) {
@@ -1182,7 +1266,6 @@ void ERaProto<Transp, Flash>::sendCommand(const char* auth, ERaRsp_t& rsp, ApiDa
         return;
     }
 
-    char* payload = nullptr;
     char topicName[MAX_TOPIC_LENGTH] {0};
     FormatString(topicName, "%s/%s", BASE_TOPIC, auth);
     switch (rsp.type) {
@@ -1209,27 +1292,7 @@ void ERaProto<Transp, Flash>::sendCommand(const char* auth, ERaRsp_t& rsp, ApiDa
             return;
     }
 
-    cJSON* root = cJSON_CreateObject();
-    if (root == nullptr) {
-        return;
-    }
-    if (rsp.param.isString()) {
-        cJSON_AddStringToObject(root, "value", rsp.param.getString());
-    }
-    else if (rsp.param.isNumber()) {
-        cJSON_AddNumberWithDecimalToObject(root, "value", rsp.param.getDouble(), 5);
-    }
-    else if (rsp.param.isObject()) {
-        cJSON_AddStringToObject(root, "value", rsp.param.getObject()->getString());
-    }
-    payload = cJSON_PrintUnformatted(root);
-    if (payload != nullptr) {
-        this->transp.publishData(topicName, payload, rsp.retained);
-    }
-    cJSON_Delete(root);
-    free(payload);
-    root = nullptr;
-    payload = nullptr;
+    this->publishValue(topicName, "value", rsp);
 }
 
 template <class Transp, class Flash>
@@ -1280,7 +1343,8 @@ void ERaProto<Transp, Flash>::sendCommandVirtualMulti(const char* auth, ERaRsp_t
 
 template <class Transp, class Flash>
 void ERaProto<Transp, Flash>::sendCommand(ERaRsp_t& rsp, ApiData_t data) {
-    if (!this->connected()) {
+    /* The logger keeps what cannot be published */
+    if (!this->connected() && !this->isLoggerData(rsp)) {
         return;
     }
 
@@ -1377,10 +1441,19 @@ void ERaProto<Transp, Flash>::sendCommandVirtual(ERaRsp_t& rsp, ERaDataJson* dat
         if (mbAck == nullptr) {
             return;
         }
+        int mbKey {-1};
         const char* mbScan = nullptr;
+        cJSON* mbDelta = nullptr;
         const ERaDataBuff::iterator e = data->end(data->getDataLen());
         for (ERaDataBuff::iterator it = data->begin(data->getDataLen()); it < e; ++it) {
-            if (it == "fail_read") {
+            if (it == "delta") {
+                mbDelta = cJSON_AddArrayToObject(root, INFO_MB_DELTA);
+            }
+            else if (it == "key") {
+                ++it;
+                mbKey = it.getInt();
+            }
+            else if (it == "fail_read") {
                 ++it;
                 mbFailed = it.getInt();
             }
@@ -1396,6 +1469,16 @@ void ERaProto<Transp, Flash>::sendCommandVirtual(ERaRsp_t& rsp, ERaDataJson* dat
                 ++it;
                 mbScan = it.getString();
             }
+            else if (mbDelta != nullptr) {
+                /* index, data, ack */
+                cJSON* item = cJSON_CreateArray();
+                cJSON_AddItemToArray(mbDelta, item);
+                cJSON_AddItemToArray(item, cJSON_CreateNumber(it.getInt()));
+                ++it;
+                cJSON_AddItemToArray(item, cJSON_CreateString(it.getString()));
+                ++it;
+                cJSON_AddItemToArray(item, cJSON_CreateString(it.getString()));
+            }
             else {
                 if (index++ % 2 == 0) {
                     FormatString(mbData, dataLen, it);
@@ -1405,8 +1488,13 @@ void ERaProto<Transp, Flash>::sendCommandVirtual(ERaRsp_t& rsp, ERaDataJson* dat
                 }
             }
         }
-        cJSON_AddStringToObject(root, INFO_MB_DATA, mbData);
-        cJSON_AddStringToObject(root, INFO_MB_ACK, mbAck);
+        if (mbDelta == nullptr) {
+            cJSON_AddStringToObject(root, INFO_MB_DATA, mbData);
+            cJSON_AddStringToObject(root, INFO_MB_ACK, mbAck);
+        }
+        if (mbKey >= 0) {
+            cJSON_AddNumberToObject(root, INFO_MB_KEY, mbKey);
+        }
         cJSON_AddNumberToObject(root, INFO_MB_READ_FAIL, mbFailed);
         cJSON_AddNumberToObject(root, INFO_MB_WRITE_FAIL, mbWriteFailed);
         cJSON_AddNumberToObject(root, INFO_MB_TOTAL, mbTotal);
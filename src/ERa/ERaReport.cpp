@@ -7,49 +7,45 @@ ERaReport::ERaReport()
     : numReport(0)
 {}
 
+ERaReport::~ERaReport() {
+    for (size_t i = 0; i < this->report.size(); ++i) {
+        delete this->report.at(i);
+    }
+    this->report.clear();
+}
+
 void ERaReport::run() {
     unsigned long currentMillis = ERaMillis();
-    const ERaList<Report_t*>::iterator* e = this->report.end();
-    for (ERaList<Report_t*>::iterator* it = this->report.begin(); it != e; it = it->getNext()) {
-        Report_t* pReport = it->get();
-        if (!this->isValidReport(pReport)) {
-            continue;
-        }
-        if ((currentMillis - pReport->prevMillis) < pReport->minInterval) {
-            continue;
-        }
-        if (ERaFloatCompare(pReport->data.value, pReport->data.prevValue) ||
-            abs(pReport->data.value - pReport->data.prevValue) < pReport->reportableChange) {
-            if (((currentMillis - pReport->prevMillis) < pReport->maxInterval) ||
-                (pReport->maxInterval == REPORT_MAX_INTERVAL)) {
-                continue;
+    Report_t* calledReport = nullptr;
+    Report_t** lastReport = &calledReport;
+    Report_t* pReport = nullptr;
+    while ((pReport = this->report.pop(currentMillis)) != nullptr) {
+        if (((currentMillis - pReport->prevMillis) >= pReport->minInterval) &&
+            (this->isReportableChange(pReport) ||
+            (((currentMillis - pReport->prevMillis) >= pReport->maxInterval) &&
+            (pReport->maxInterval != REPORT_MAX_INTERVAL)))) {
+            // update time
+            pReport->prevMillis = currentMillis;
+            // update value
+            pReport->data.prevValue = pReport->data.value;
+            // call callback
+            if (pReport->updated && pReport->enable) {
+                pReport->reported = true;
+                this->setFlag(pReport->called, ReportFlagT::REPORT_ON_CALLED, true);
             }
         }
-        // update time
-        pReport->prevMillis = currentMillis;
-        // update value
-        pReport->data.prevValue = pReport->data.value;
-        if (!pReport->updated) {
-            continue;
-        }
-        // call callback
-        if (!pReport->enable) {
+        if (!pReport->called) {
+            this->scheduleReport(pReport, currentMillis);
             continue;
         }
-        pReport->reported = true;
-        this->setFlag(pReport->called, ReportFlagT::REPORT_ON_CALLED, true);
+        pReport->nextCalled = nullptr;
+        (*lastReport) = pReport;
+        lastReport = &pReport->nextCalled;
     }
 
-    ERaList<Report_t*>::iterator* next = nullptr;
-    for (ERaList<Report_t*>::iterator* it = this->report.begin(); it != e; it = next) {
-        next = it->getNext();
-        Report_t* pReport = it->get();
-        if (!this->isValidReport(pReport)) {
-            continue;
-        }
-        if (!pReport->called) {
-            continue;
-        }
+    Report_t* next = nullptr;
+    for (pReport = calledReport; pReport != nullptr; pReport = next) {
+        next = pReport->nextCalled;
         if (this->getFlag(pReport->called, ReportFlagT::REPORT_ON_CALLED)) {
             if (pReport->callback_p == nullptr) {
                 pReport->callback();
@@ -59,14 +55,14 @@ void ERaReport::run() {
             }
         }
         if (this->getFlag(pReport->called, ReportFlagT::REPORT_ON_DELETE)) {
+            this->report.cancel(pReport);
             delete pReport;
             pReport = nullptr;
-            it->get() = nullptr;
-            this->report.remove(it);
             this->numReport--;
             continue;
         }
         pReport->called = 0;
+        this->scheduleReport(pReport, ERaMillis());
     }
 }
 
@@ -108,7 +104,10 @@ ERaReport::Report_t* ERaReport::setupReport(unsigned long minInterval, unsigned
     pReport->updated = false;
     pReport->reported = false;
     pReport->called = 0;
-    this->report.put(pReport);
+    if (!this->report.scheduleIn(pReport, pReport->prevMillis, maxInterval)) {
+        delete pReport;
+        return nullptr;
+    }
     this->numReport++;
     return pReport;
 }
@@ -152,7 +151,10 @@ ERaReport::Report_t* ERaReport::setupReport(unsigned long minInterval, unsigned
     pReport->updated = false;
     pReport->reported = false;
     pReport->called = 0;
-    this->report.put(pReport);
+    if (!this->report.scheduleIn(pReport, pReport->prevMillis, maxInterval)) {
+        delete pReport;
+        return nullptr;
+    }
     this->numReport++;
     return pReport;
 }
@@ -196,7 +198,10 @@ ERaReport::Report_t* ERaReport::setupReport(unsigned long minInterval, unsigned
     pReport->updated = false;
     pReport->reported = false;
     pReport->called = 0;
-    this->report.put(pReport);
+    if (!this->report.scheduleIn(pReport, pReport->prevMillis, maxInterval)) {
+        delete pReport;
+        return nullptr;
+    }
     this->numReport++;
     return pReport;
 }
@@ -216,6 +221,7 @@ bool ERaReport::changeReportableChange(Report_t* pReport, unsigned long minInter
     pReport->reportableChange = minChange;
     pReport->minInterval = minInterval;
     pReport->maxInterval = maxInterval;
+    this->scheduleReport(pReport, ERaMillis());
     return true;
 }
 
@@ -241,6 +247,7 @@ bool ERaReport::changeReportableChange(Report_t* pReport, unsigned long minInter
     pReport->data.pin = pin;
     pReport->data.pinMode = pinMode;
     pReport->data.configId = configId;
+    this->scheduleReport(pReport, ERaMillis());
     return true;
 }
 
@@ -267,6 +274,7 @@ void ERaReport::updateReport(Report_t* pReport, float value, bool isRound, bool
         }
     }
     pReport->updated = true;
+    this->scheduleReport(pReport, ERaMillis());
 }
 
 bool ERaReport::reportEvery(Report_t* pReport, unsigned long interval) {
@@ -278,6 +286,7 @@ bool ERaReport::reportEvery(Report_t* pReport, unsigned long interval) {
     }
 
     pReport->maxInterval = interval;
+    this->scheduleReport(pReport, ERaMillis());
     return true;
 }
 
@@ -332,6 +341,7 @@ void ERaReport::skipReport(Report_t* pReport) {
     pReport->data.prevValue = pReport->data.value;
     // clear flag called
     this->setFlag(pReport->called, ReportFlagT::REPORT_ON_CALLED, false);
+    this->scheduleReport(pReport, pReport->prevMillis);
 }
 
 void ERaReport::restartReport(Report_t* pReport) {
@@ -341,6 +351,7 @@ void ERaReport::restartReport(Report_t* pReport) {
 
     pReport->updated = false;
     pReport->prevMillis = ERaMillis();
+    this->scheduleReport(pReport, pReport->prevMillis);
 }
 
 void ERaReport::executeReport(Report_t* pReport) {
@@ -352,13 +363,16 @@ void ERaReport::executeReport(Report_t* pReport) {
     pReport->prevMillis = ERaMillis();
     // update value
     pReport->data.prevValue = pReport->data.value;
-    // clear flag called
+    // set flag called
     this->setFlag(pReport->called, ReportFlagT::REPORT_ON_CALLED, true);
+    this->scheduleReport(pReport, pReport->prevMillis);
 }
 
 void ERaReport::executeNow(Report_t* pReport) {
     if (this->isValidReport(pReport)) {
-        pReport->prevMillis = ERaMillis() - pReport->maxInterval;
+        unsigned long currentMillis = ERaMillis();
+        pReport->prevMillis = currentMillis - pReport->maxInterval;
+        this->scheduleReport(pReport, currentMillis);
     }
 }
 
@@ -369,6 +383,8 @@ void ERaReport::deleteReport(Report_t* pReport) {
 
     if (this->isValidReport(pReport)) {
         this->setFlag(pReport->called, ReportFlagT::REPORT_ON_DELETE, true);
+        // let the next run release it
+        this->scheduleReport(pReport, ERaMillis());
     }
 }
 
@@ -410,12 +426,12 @@ void ERaReport::setScale(Report_t* pReport, float min, float max, float rawMin,
     pReport->data.scale.rawMax = rawMax;
     pReport->reportableChange = ERaMapNumberRange(pReport->reportableChange,
                                         0.0f, rawMax - rawMin, 0.0f, max - min);
+    this->scheduleReport(pReport, ERaMillis());
 }
 
 void ERaReport::enableAll() {
-    const ERaList<Report_t*>::iterator* e = this->report.end();
-    for (ERaList<Report_t*>::iterator* it = this->report.begin(); it != e; it = it->getNext()) {
-        Report_t* pReport = it->get();
+    for (size_t i = 0; i < this->report.size(); ++i) {
+        Report_t* pReport = this->report.at(i);
         if (this->isValidReport(pReport)) {
             pReport->enable = true;
         }
@@ -423,9 +439,8 @@ void ERaReport::enableAll() {
 }
 
 void ERaReport::disableAll() {
-    const ERaList<Report_t*>::iterator* e = this->report.end();
-    for (ERaList<Report_t*>::iterator* it = this->report.begin(); it != e; it = it->getNext()) {
-        Report_t* pReport = it->get();
+    for (size_t i = 0; i < this->report.size(); ++i) {
+        Report_t* pReport = this->report.at(i);
         if (this->isValidReport(pReport)) {
             pReport->enable = false;
         }
@@ -441,6 +456,31 @@ ERaReport::ScaleData_t* ERaReport::getScale(Report_t* pReport) const {
     }
 }
 
+bool ERaReport::isReportableChange(const Report_t* pReport) const {
+    return !(ERaFloatCompare(pReport->data.value, pReport->data.prevValue) ||
+            abs(pReport->data.value - pReport->data.prevValue) < pReport->reportableChange);
+}
+
+void ERaReport::scheduleReport(Report_t* pReport, unsigned long currentMillis) {
+    // pending callback or delete, handle it on the next run
+    if (pReport->called) {
+        this->report.schedule(pReport, currentMillis);
+        return;
+    }
+
+    unsigned long delay = pReport->maxInterval;
+    if (this->isReportableChange(pReport)) {
+        delay = pReport->minInterval;
+    }
+    unsigned long elapsed = (currentMillis - pReport->prevMillis);
+    if ((delay == REPORT_MAX_INTERVAL) || (elapsed < delay)) {
+        this->report.scheduleIn(pReport, currentMillis, delay - elapsed);
+    }
+    else {
+        this->report.schedule(pReport, currentMillis);
+    }
+}
+
 bool ERaReport::isReportFree() {
     if (this->numReport >= MAX_REPORTS) {
         return false;
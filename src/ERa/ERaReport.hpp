@@ -6,7 +6,7 @@
 #include <stdint.h>
 #include <ERa/ERaDefine.hpp>
 #include <ERa/ERaDetect.hpp>
-#include <Utility/ERaQueue.hpp>
+#include <Utility/ERaScheduler.hpp>
 
 #if defined(__has_include) &&       \
     __has_include(<functional>) &&  \
@@ -65,6 +65,9 @@ private:
         bool updated;
         bool reported;
         uint8_t called;
+        unsigned long schedMillis;
+        size_t schedIndex;
+        struct __Report_t* nextCalled;
     } Report_t;
 
 public:
@@ -258,11 +261,15 @@ public:
     };
 
     ERaReport();
-    ~ERaReport()
-    {}
+    ~ERaReport();
 
     void run();
 
+    /* Milliseconds until the next report may be due */
+    unsigned long getNextTimeout(unsigned long maxDelay = ERA_SCHEDULER_MAX_DELAY) {
+        return this->report.remaining(ERaMillis(), maxDelay);
+    }
+
     iterator setReporting(unsigned long minInterval, unsigned long maxInterval,
                         float minChange, ERaReport::ReportCallback_t cb) {
         return iterator(this, this->setupReport(minInterval, maxInterval, minChange, cb));
@@ -339,6 +346,8 @@ private:
     }
 
     bool isReportFree();
+    bool isReportableChange(const Report_t* pReport) const;
+    void scheduleReport(Report_t* pReport, unsigned long currentMillis);
 
     bool isValidReport(const Report_t* pReport) const {
         if (pReport == nullptr) {
@@ -360,7 +369,7 @@ private:
         return (flags & mask) == mask;
     }
 
-    ERaList<Report_t*> report;
+    ERaScheduler<Report_t> report;
     unsigned int numReport;
 };
 
@@ -7,37 +7,42 @@ ERaTimer::ERaTimer()
     : numTimer(0)
 {}
 
+ERaTimer::~ERaTimer() {
+    for (size_t i = 0; i < this->timer.size(); ++i) {
+        delete this->timer.at(i);
+    }
+    this->timer.clear();
+}
+
 void ERaTimer::run() {
     unsigned long currentMillis = ERaMillis();
-    const ERaList<Timer_t*>::iterator* e = this->timer.end();
-    for (ERaList<Timer_t*>::iterator* it = this->timer.begin(); it != e; it = it->getNext()) {
-        Timer_t* pTimer = it->get();
-        if (!this->isValidTimer(pTimer)) {
-            continue;
+    Timer_t* calledTimer = nullptr;
+    Timer_t** lastTimer = &calledTimer;
+    Timer_t* pTimer = nullptr;
+    while ((pTimer = this->timer.pop(currentMillis)) != nullptr) {
+        if ((currentMillis - pTimer->prevMillis) >= pTimer->delay) {
+            unsigned long skipTimes = ((currentMillis - pTimer->prevMillis) / pTimer->delay);
+            // update time
+            pTimer->prevMillis += (pTimer->delay * skipTimes);
+            // call callback
+            if (pTimer->enable) {
+                this->setFlag(pTimer->called, TimerFlagT::TIMER_ON_CALLED, true);
+            }
         }
-        if ((currentMillis - pTimer->prevMillis) < pTimer->delay) {
-            continue;
+        if (!this->getFlag(pTimer->called, TimerFlagT::TIMER_ON_DELETE)) {
+            this->scheduleTimer(pTimer, currentMillis);
         }
-        unsigned long skipTimes = ((currentMillis - pTimer->prevMillis) / pTimer->delay);
-        // update time
-        pTimer->prevMillis += (pTimer->delay * skipTimes);
-        // call callback
-        if (!pTimer->enable) {
+        if (!pTimer->called) {
             continue;
         }
-        this->setFlag(pTimer->called, TimerFlagT::TIMER_ON_CALLED, true);
+        pTimer->nextCalled = nullptr;
+        (*lastTimer) = pTimer;
+        lastTimer = &pTimer->nextCalled;
     }
 
-    ERaList<Timer_t*>::iterator* next = nullptr;
-    for (ERaList<Timer_t*>::iterator* it = this->timer.begin(); it != e; it = next) {
-        next = it->getNext();
-        Timer_t* pTimer = it->get();
-        if (!this->isValidTimer(pTimer)) {
-            continue;
-        }
-        if (!pTimer->called) {
-            continue;
-        }
+    Timer_t* next = nullptr;
+    for (pTimer = calledTimer; pTimer != nullptr; pTimer = next) {
+        next = pTimer->nextCalled;
         if (this->getFlag(pTimer->called, TimerFlagT::TIMER_ON_CALLED)) {
             if (pTimer->callback_p == nullptr) {
                 pTimer->callback();
@@ -52,10 +57,9 @@ void ERaTimer::run() {
             }
         }
         if (this->getFlag(pTimer->called, TimerFlagT::TIMER_ON_DELETE)) {
+            this->timer.cancel(pTimer);
             delete pTimer;
             pTimer = nullptr;
-            it->get() = nullptr;
-            this->timer.remove(it);
             this->numTimer--;
             continue;
         }
@@ -85,7 +89,10 @@ ERaTimer::Timer_t* ERaTimer::setupTimer(unsigned long interval, TimerCallback_t
     pTimer->enable = true;
     pTimer->called = 0;
     pTimer->prevMillis = ERaMillis();
-    this->timer.put(pTimer);
+    if (!this->timer.scheduleIn(pTimer, pTimer->prevMillis, interval)) {
+        delete pTimer;
+        return nullptr;
+    }
     this->numTimer++;
     return pTimer;
 }
@@ -112,7 +119,10 @@ ERaTimer::Timer_t* ERaTimer::setupTimer(unsigned long interval, TimerCallback_p_
     pTimer->enable = true;
     pTimer->called = 0;
     pTimer->prevMillis = ERaMillis();
-    this->timer.put(pTimer);
+    if (!this->timer.scheduleIn(pTimer, pTimer->prevMillis, interval)) {
+        delete pTimer;
+        return nullptr;
+    }
     this->numTimer++;
     return pTimer;
 }
@@ -127,18 +137,22 @@ bool ERaTimer::changeInterval(Timer_t* pTimer, unsigned long interval) {
 
     pTimer->delay = interval;
     pTimer->prevMillis = ERaMillis();
+    this->scheduleTimer(pTimer, pTimer->prevMillis);
     return true;
 }
 
 void ERaTimer::restartTimer(Timer_t* pTimer) {
     if (this->isValidTimer(pTimer)) {
         pTimer->prevMillis = ERaMillis();
+        this->scheduleTimer(pTimer, pTimer->prevMillis);
     }
 }
 
 void ERaTimer::executeNow(Timer_t* pTimer) {
     if (this->isValidTimer(pTimer)) {
-        pTimer->prevMillis = ERaMillis() - pTimer->delay;
+        unsigned long currentMillis = ERaMillis();
+        pTimer->prevMillis = currentMillis - pTimer->delay;
+        this->scheduleTimer(pTimer, currentMillis);
     }
 }
 
@@ -149,6 +163,8 @@ void ERaTimer::deleteTimer(Timer_t* pTimer) {
 
     if (this->isValidTimer(pTimer)) {
         this->setFlag(pTimer->called, TimerFlagT::TIMER_ON_DELETE, true);
+        // let the next run release it
+        this->scheduleTimer(pTimer, ERaMillis());
     }
 }
 
@@ -174,9 +190,8 @@ void ERaTimer::disable(Timer_t* pTimer) {
 }
 
 void ERaTimer::enableAll() {
-    const ERaList<Timer_t*>::iterator* e = this->timer.end();
-    for (ERaList<Timer_t*>::iterator* it = this->timer.begin(); it != e; it = it->getNext()) {
-        Timer_t* pTimer = it->get();
+    for (size_t i = 0; i < this->timer.size(); ++i) {
+        Timer_t* pTimer = this->timer.at(i);
         if (this->isValidTimer(pTimer)) {
             pTimer->enable = true;
         }
@@ -184,9 +199,8 @@ void ERaTimer::enableAll() {
 }
 
 void ERaTimer::disableAll() {
-    const ERaList<Timer_t*>::iterator* e = this->timer.end();
-    for (ERaList<Timer_t*>::iterator* it = this->timer.begin(); it != e; it = it->getNext()) {
-        Timer_t* pTimer = it->get();
+    for (size_t i = 0; i < this->timer.size(); ++i) {
+        Timer_t* pTimer = this->timer.at(i);
         if (this->isValidTimer(pTimer)) {
             pTimer->enable = false;
         }
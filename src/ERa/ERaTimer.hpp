@@ -3,7 +3,7 @@
 
 #include <ERa/ERaDefine.hpp>
 #include <ERa/ERaDetect.hpp>
-#include <Utility/ERaQueue.hpp>
+#include <Utility/ERaScheduler.hpp>
 
 #if defined(__has_include) &&       \
     __has_include(<functional>) &&  \
@@ -22,7 +22,7 @@ class ERaTimer
     typedef void (*TimerCallback_p_t)(void*);
 #endif
 
-    const static int MAX_TIMERS = 16;
+    const static int MAX_TIMERS = ERA_MAX_TIMER;
     enum TimerFlagT {
         TIMER_ON_CALLED = 0x01,
         TIMER_ON_DELETE = 0x80
@@ -37,6 +37,9 @@ class ERaTimer
         void* param;
         bool enable;
         uint8_t called;
+        unsigned long schedMillis;
+        size_t schedIndex;
+        struct __Timer_t* nextCalled;
     } Timer_t;
 
 public:
@@ -132,11 +135,15 @@ public:
     };
 
     ERaTimer();
-    ~ERaTimer()
-    {}
+    ~ERaTimer();
 
     void run();
 
+    /* Milliseconds until the next timer is due */
+    unsigned long getNextTimeout(unsigned long maxDelay = ERA_SCHEDULER_MAX_DELAY) {
+        return this->timer.remaining(ERaMillis(), maxDelay);
+    }
+
     iterator setInterval(unsigned long interval, ERaTimer::TimerCallback_t cb) {
         return iterator(this, this->setupTimer(interval, cb, 0));
     }
@@ -177,6 +184,16 @@ private:
     Timer_t* setupTimer(unsigned long interval, ERaTimer::TimerCallback_p_t cb, void* arg, unsigned int limit);
     bool isTimerFree();
 
+    void scheduleTimer(Timer_t* pTimer, unsigned long currentMillis) {
+        if (this->getFlag(pTimer->called, TimerFlagT::TIMER_ON_DELETE)) {
+            this->timer.schedule(pTimer, currentMillis);
+            return;
+        }
+        unsigned long elapsed = (currentMillis - pTimer->prevMillis);
+        this->timer.scheduleIn(pTimer, currentMillis,
+                            ((elapsed < pTimer->delay) ? (pTimer->delay - elapsed) : 0));
+    }
+
     bool isValidTimer(const Timer_t* pTimer) const {
         if (pTimer == nullptr) {
             return false;
@@ -197,7 +214,7 @@ private:
         return (flags & mask) == mask;
     }
 
-    ERaList<Timer_t*> timer;
+    ERaScheduler<Timer_t> timer;
     unsigned int numTimer;
 };
 
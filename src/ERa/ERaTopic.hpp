@@ -28,6 +28,8 @@ Topic format:
 #define ERA_PUB_PREFIX_MODBUS_DATA_TOPIC            "/data"
 #define ERA_PUB_PREFIX_CONFIG_DATA_TOPIC            "/config/%d/value"
 #define ERA_PUB_PREFIX_MULTI_CONFIG_DATA_TOPIC      "/config_value"
+/* Appended to the live topic of journal records replayed after an outage */
+#define ERA_PUB_SUFFIX_HISTORY_TOPIC                "/history"
 
 /* For debug */
 #if !defined(ERA_DEBUG_PREFIX)
@@ -0,0 +1,149 @@
+#ifndef INC_ERA_VIRTUAL_HANDLER_HPP_
+#define INC_ERA_VIRTUAL_HANDLER_HPP_
+
+#include <stdint.h>
+#include <ERa/ERaDefine.hpp>
+#include <ERa/ERaPinDef.hpp>
+#include <ERa/ERaParam.hpp>
+#include <Utility/ERaQueue.hpp>
+#include <Utility/ERaHashIndex.hpp>
+
+#if defined(__has_include) &&       \
+    __has_include(<functional>) &&  \
+    !defined(ERA_IGNORE_STD_FUNCTIONAL_STRING)
+    #include <functional>
+    #define VIRTUAL_HANDLER_HAS_FUNCTIONAL_H
+#endif
+
+/* Write handlers registered at runtime for any virtual pin number,
+ * looked up by hash so dispatch does not depend on how many exist.
+ * ERA_WRITE(Vx) handlers keep working for the pins of the static table.
+ */
+class ERaVirtualHandler
+{
+public:
+#if defined(VIRTUAL_HANDLER_HAS_FUNCTIONAL_H)
+    typedef std::function<void(ERaVirtualPin_t, const ERaParam&)> WriteCallback_t;
+#else
+    typedef void (*WriteCallback_t)(ERaVirtualPin_t, const ERaParam&);
+#endif
+
+private:
+    typedef struct __Handler_t {
+        ERaVirtualPin_t pin;
+        ERaVirtualHandler::WriteCallback_t callback;
+    } Handler_t;
+
+public:
+    ERaVirtualHandler()
+        : numHandler(0)
+        , numAlloc(0)
+    {}
+    ~ERaVirtualHandler()
+    {
+        this->clear();
+    }
+
+    /* Set or replace the handler of pin, nullptr removes it */
+    bool onWrite(ERaVirtualPin_t pin, ERaVirtualHandler::WriteCallback_t cb) {
+        Handler_t* pHandler = this->handlerIndex.get((uint32_t)pin);
+        if (cb == nullptr) {
+            if (pHandler != nullptr) {
+                this->handlerIndex.remove((uint32_t)pin, pHandler);
+                pHandler->callback = nullptr;
+                this->numHandler--;
+            }
+            return true;
+        }
+        if (pHandler == nullptr) {
+            pHandler = this->findFree();
+        }
+        if (pHandler == nullptr) {
+            pHandler = new Handler_t();
+            if (pHandler == nullptr) {
+                return false;
+            }
+            this->handler.put(pHandler);
+            this->numAlloc++;
+        }
+        pHandler->pin = pin;
+        pHandler->callback = cb;
+        if (this->handlerIndex.get((uint32_t)pin) == nullptr) {
+            if (!this->handlerIndex.put((uint32_t)pin, pHandler)) {
+                pHandler->callback = nullptr;
+                return false;
+            }
+            this->numHandler++;
+        }
+        return true;
+    }
+
+    /* Returns false when no handler is registered for pin */
+    bool call(ERaVirtualPin_t pin, const ERaParam& param) const {
+        if (!this->numHandler) {
+            return false;
+        }
+        const Handler_t* pHandler = this->handlerIndex.get((uint32_t)pin);
+        if ((pHandler == nullptr) ||
+            (pHandler->callback == nullptr)) {
+            return false;
+        }
+        pHandler->callback(pin, param);
+        return true;
+    }
+
+    bool isExist(ERaVirtualPin_t pin) const {
+        return (this->handlerIndex.get((uint32_t)pin) != nullptr);
+    }
+
+    size_t size() const {
+        return this->numHandler;
+    }
+
+    void clear() {
+        const HandlerIterator* e = this->handler.end();
+        for (HandlerIterator* it = this->handler.begin(); it != e; it = it->getNext()) {
+            Handler_t* pHandler = it->get();
+            if (pHandler == nullptr) {
+                continue;
+            }
+            delete pHandler;
+            pHandler = nullptr;
+            it->get() = nullptr;
+        }
+        this->handler.clear();
+        this->handlerIndex.clear();
+        this->numHandler = 0;
+        this->numAlloc = 0;
+    }
+
+protected:
+private:
+    ERaVirtualHandler(const ERaVirtualHandler&);
+    ERaVirtualHandler& operator = (const ERaVirtualHandler&);
+
+    /* Reuse an entry left by a removed handler */
+    Handler_t* findFree() const {
+        if (this->numHandler >= this->numAlloc) {
+            return nullptr;
+        }
+        const HandlerIterator* e = this->handler.end();
+        for (HandlerIterator* it = this->handler.begin(); it != e; it = it->getNext()) {
+            Handler_t* pHandler = it->get();
+            if ((pHandler != nullptr) &&
+                (pHandler->callback == nullptr)) {
+                return pHandler;
+            }
+        }
+        return nullptr;
+    }
+
+    ERaList<Handler_t*> handler;
+    ERaHashIndex<uint32_t, Handler_t> handlerIndex;
+    size_t numHandler;
+    size_t numAlloc;
+
+    using HandlerIterator = typename ERaList<Handler_t*>::iterator;
+};
+
+#endif /* INC_ERA_VIRTUAL_HANDLER_HPP_ */
@@ -12,9 +12,15 @@ void lwmqtt_init(lwmqtt_client_t *client, uint8_t *write_buf, size_t write_buf_s
   client->read_buf_size = read_buf_size;
   client->read_buf_size_s = read_buf_size;
 
+  client->payload_len = 0;
+  client->payload_buf = NULL;
+
   client->callback = NULL;
   client->callback_ref = NULL;
 
+  client->ack_callback = NULL;
+  client->ack_callback_ref = NULL;
+
   client->network = NULL;
   client->network_read = NULL;
   client->network_write = NULL;
@@ -50,6 +56,11 @@ void lwmqtt_set_callback(lwmqtt_client_t *client, void *ref, lwmqtt_callback_t c
   client->callback = cb;
 }
 
+void lwmqtt_set_ack_callback(lwmqtt_client_t *client, void *ref, lwmqtt_ack_callback_t cb) {
+  client->ack_callback_ref = ref;
+  client->ack_callback = cb;
+}
+
 void lwmqtt_call_callback(lwmqtt_client_t *client, lwmqtt_string_t *topic, lwmqtt_message_t *msg) {
   if (client->callback == NULL) {
     return;
@@ -80,17 +91,7 @@ static uint16_t lwmqtt_get_next_packet_id(lwmqtt_client_t *client) {
   return client->last_packet_id;
 }
 
-static lwmqtt_err_t lwmqtt_read_from_network(lwmqtt_client_t *client, size_t offset, size_t len) {
-  // check read buffer capacity
-  if (client->read_buf_size < offset + len) {
-    uint8_t* copy = (uint8_t*)ERA_REALLOC(client->read_buf, offset + len + 1);
-    if (copy == NULL) {
-      return LWMQTT_BUFFER_TOO_SHORT;
-    }
-    client->read_buf_size = offset + len;
-    client->read_buf = copy;
-  }
-
+static lwmqtt_err_t lwmqtt_read_to_buffer(lwmqtt_client_t *client, uint8_t *buf, size_t len) {
   // prepare counter
   size_t read = 0;
 
@@ -104,7 +105,7 @@ static lwmqtt_err_t lwmqtt_read_from_network(lwmqtt_client_t *client, size_t off
 
     // read
     size_t partial_read = 0;
-    lwmqtt_err_t err = client->network_read(client->network, client->read_buf + offset + read, len - read,
+    lwmqtt_err_t err = client->network_read(client->network, buf + read, len - read,
                                             &partial_read, (uint32_t)remaining_time);
     if (err != LWMQTT_SUCCESS) {
       return err;
@@ -117,6 +118,77 @@ static lwmqtt_err_t lwmqtt_read_from_network(lwmqtt_client_t *client, size_t off
   return LWMQTT_SUCCESS;
 }
 
+static lwmqtt_err_t lwmqtt_read_from_network(lwmqtt_client_t *client, size_t offset, size_t len) {
+  // check read buffer capacity
+  if (client->read_buf_size < offset + len) {
+    uint8_t* copy = (uint8_t*)ERA_REALLOC(client->read_buf, offset + len + 1);
+    if (copy == NULL) {
+      return LWMQTT_BUFFER_TOO_SHORT;
+    }
+    client->read_buf_size = offset + len;
+    client->read_buf = copy;
+  }
+
+  return lwmqtt_read_to_buffer(client, client->read_buf + offset, len);
+}
+
+static void lwmqtt_release_payload(lwmqtt_client_t *client) {
+  if (client->payload_buf == NULL) {
+    return;
+  }
+
+  ERA_FREE(client->payload_buf);
+  client->payload_buf = NULL;
+  client->payload_len = 0;
+}
+
+static lwmqtt_err_t lwmqtt_read_publish_streamed(lwmqtt_client_t *client, size_t offset, uint32_t rem_len) {
+  // check remaining length (topic length)
+  if (rem_len < 2) {
+    return LWMQTT_REMAINING_LENGTH_MISMATCH;
+  }
+
+  // read topic length
+  lwmqtt_err_t err = lwmqtt_read_from_network(client, offset, 2);
+  if (err != LWMQTT_SUCCESS) {
+    return err;
+  }
+
+  // get variable header length
+  size_t header_len = 2 + (((size_t)client->read_buf[offset] << 8) | client->read_buf[offset + 1]);
+  if (lwmqtt_read_bits(client->read_buf[0], 1, 2) > 0) {
+    header_len += 2;
+  }
+  if (header_len > rem_len) {
+    return LWMQTT_REMAINING_LENGTH_MISMATCH;
+  }
+
+  // read topic and packet id
+  err = lwmqtt_read_from_network(client, offset + 2, header_len - 2);
+  if (err != LWMQTT_SUCCESS) {
+    return err;
+  }
+
+  // allocate exactly the payload, with room for a terminator
+  size_t payload_len = rem_len - header_len;
+  uint8_t *payload = (uint8_t *)ERA_MALLOC(payload_len + 1);
+  if (payload == NULL) {
+    return LWMQTT_BUFFER_TOO_SHORT;
+  }
+
+  // read payload straight from the network
+  err = lwmqtt_read_to_buffer(client, payload, payload_len);
+  if (err != LWMQTT_SUCCESS) {
+    ERA_FREE(payload);
+    return err;
+  }
+
+  client->payload_buf = payload;
+  client->payload_len = payload_len;
+
+  return LWMQTT_SUCCESS;
+}
+
 static lwmqtt_err_t lwmqtt_drain_network(lwmqtt_client_t *client, size_t amount) {
   // read while data is left
   while (amount > 0) {
@@ -179,6 +251,9 @@ static lwmqtt_err_t lwmqtt_read_packet_in_buffer(lwmqtt_client_t *client, size_t
   // preset packet type
   *packet_type = LWMQTT_NO_PACKET;
 
+  // release a payload left by a failed cycle
+  lwmqtt_release_payload(client);
+
   // read or wait for header byte
   lwmqtt_err_t err = lwmqtt_read_from_network(client, 0, 1);
   if (err == LWMQTT_NETWORK_TIMEOUT) {
@@ -237,6 +312,19 @@ static lwmqtt_err_t lwmqtt_read_packet_in_buffer(lwmqtt_client_t *client, size_t
     return LWMQTT_SUCCESS;
   }
 
+  // stream publish payloads that do not fit into the read buffer
+  if (*packet_type == LWMQTT_PUBLISH_PACKET && 1 + len + rem_len > client->read_buf_size) {
+    err = lwmqtt_read_publish_streamed(client, 1 + len, rem_len);
+    if (err != LWMQTT_SUCCESS) {
+      return err;
+    }
+
+    // adjust counter
+    *read += 1 + len + rem_len;
+
+    return LWMQTT_SUCCESS;
+  }
+
   // read the rest of the buffer if needed
   if (rem_len > 0) {
     err = lwmqtt_read_from_network(client, 1 + len, rem_len);
@@ -281,14 +369,21 @@ static lwmqtt_err_t lwmqtt_cycle_once(lwmqtt_client_t *client, size_t *read, lwm
       uint16_t packet_id;
       lwmqtt_string_t topic;
       lwmqtt_message_t msg;
-      err = lwmqtt_decode_publish(client->read_buf, client->read_buf_size, &dup, &packet_id, &topic, &msg);
+      if (client->payload_buf != NULL) {
+        err = lwmqtt_decode_publish_streamed(client->read_buf, client->read_buf_size, client->payload_buf,
+                                             client->payload_len, &dup, &packet_id, &topic, &msg);
+      } else {
+        err = lwmqtt_decode_publish(client->read_buf, client->read_buf_size, &dup, &packet_id, &topic, &msg);
+      }
       if (err != LWMQTT_SUCCESS) {
+        lwmqtt_release_payload(client);
         return err;
       }
 
       // break early on qos zero
       if (msg.qos == LWMQTT_QOS0) {
         lwmqtt_call_callback(client, &topic, &msg);
+        lwmqtt_release_payload(client);
         break;
       }
 
@@ -305,6 +400,7 @@ static lwmqtt_err_t lwmqtt_cycle_once(lwmqtt_client_t *client, size_t *read, lwm
       err = lwmqtt_encode_ack(client->write_buf, client->write_buf_size, &len, ack_type, packet_id);
       if (err != LWMQTT_SUCCESS) {
         lwmqtt_call_callback(client, &topic, &msg);
+        lwmqtt_release_payload(client);
         return err;
       }
 
@@ -312,10 +408,12 @@ static lwmqtt_err_t lwmqtt_cycle_once(lwmqtt_client_t *client, size_t *read, lwm
       err = lwmqtt_send_packet_in_buffer(client, len);
       if (err != LWMQTT_SUCCESS) {
         lwmqtt_call_callback(client, &topic, &msg);
+        lwmqtt_release_payload(client);
         return err;
       }
 
       lwmqtt_call_callback(client, &topic, &msg);
+      lwmqtt_release_payload(client);
       break;
     }
 
@@ -369,6 +467,27 @@ static lwmqtt_err_t lwmqtt_cycle_once(lwmqtt_client_t *client, size_t *read, lwm
       break;
     }
 
+    // handle puback and pubcomp packets
+    case LWMQTT_PUBACK_PACKET:
+    case LWMQTT_PUBCOMP_PACKET: {
+      // return if callback is not set
+      if (client->ack_callback == NULL) {
+        break;
+      }
+
+      // decode ack packet
+      uint16_t packet_id;
+      err = lwmqtt_decode_ack(client->read_buf, client->read_buf_size, *packet_type, &packet_id);
+      if (err != LWMQTT_SUCCESS) {
+        return err;
+      }
+
+      // call callback
+      client->ack_callback(client, client->ack_callback_ref, packet_id);
+
+      break;
+    }
+
     // handle pingresp packets
     case LWMQTT_PINGRESP_PACKET: {
       // set flag
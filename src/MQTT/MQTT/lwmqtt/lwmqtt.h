@@ -215,6 +215,18 @@ typedef int32_t (*lwmqtt_timer_get_t)(void *ref);
  */
 typedef void (*lwmqtt_callback_t)(lwmqtt_client_t *client, void *ref, lwmqtt_string_t str, lwmqtt_message_t msg);
 
+/**
+ * The callback used to forward PUBACK and PUBCOMP packets that no call is waiting for.
+ *
+ * Note: It is executed from lwmqtt_yield() for publishes sent with the skip_ack option, and may also run while
+ * another command is waiting for its own acknowledgement.
+ *
+ * @param client - The client object.
+ * @param ref - A custom reference.
+ * @param packet_id - The acknowledged packet id.
+ */
+typedef void (*lwmqtt_ack_callback_t)(lwmqtt_client_t *client, void *ref, uint16_t packet_id);
+
 /**
  * The client object.
  */
@@ -227,9 +239,15 @@ struct lwmqtt_client_t {
   size_t read_buf_size_s;
   uint8_t *write_buf, *read_buf;
 
+  size_t payload_len;
+  uint8_t *payload_buf;
+
   lwmqtt_callback_t callback;
   void *callback_ref;
 
+  lwmqtt_ack_callback_t ack_callback;
+  void *ack_callback_ref;
+
   void *network;
   lwmqtt_network_read_t network_read;
   lwmqtt_network_write_t network_write;
@@ -286,6 +304,15 @@ void lwmqtt_set_timers(lwmqtt_client_t *client, void *keep_alive_timer, void *co
  */
 void lwmqtt_set_callback(lwmqtt_client_t *client, void *ref, lwmqtt_callback_t cb);
 
+/**
+ * Will set the callback used to receive publish acknowledgements.
+ *
+ * @param client - The client object.
+ * @param ref - A custom reference that will passed to the callback.
+ * @param cb - The callback to be called.
+ */
+void lwmqtt_set_ack_callback(lwmqtt_client_t *client, void *ref, lwmqtt_ack_callback_t cb);
+
 /**
  * Will configure the client to drop packets that overflow the read buffer. If a counter is provided it will be
  * incremented with each dropped packet.
@@ -380,6 +380,12 @@ lwmqtt_err_t lwmqtt_encode_ack(uint8_t *buf, size_t buf_len, size_t *len, lwmqtt
 
 lwmqtt_err_t lwmqtt_decode_publish(uint8_t *buf, size_t buf_len, bool *dup, uint16_t *packet_id, lwmqtt_string_t *topic,
                                    lwmqtt_message_t *msg) {
+  return lwmqtt_decode_publish_streamed(buf, buf_len, NULL, 0, dup, packet_id, topic, msg);
+}
+
+lwmqtt_err_t lwmqtt_decode_publish_streamed(uint8_t *buf, size_t buf_len, uint8_t *payload, size_t payload_len,
+                                            bool *dup, uint16_t *packet_id, lwmqtt_string_t *topic,
+                                            lwmqtt_message_t *msg) {
   // prepare pointer
   uint8_t *buf_ptr = buf;
   uint8_t *buf_end = buf + buf_len;
@@ -430,6 +436,14 @@ lwmqtt_err_t lwmqtt_decode_publish(uint8_t *buf, size_t buf_len, bool *dup, uint
     return LWMQTT_REMAINING_LENGTH_MISMATCH;
   }
 
+  // exclude the payload held in a separate buffer
+  if (payload != NULL) {
+    if (rem_len < payload_len) {
+      return LWMQTT_REMAINING_LENGTH_MISMATCH;
+    }
+    rem_len -= (uint32_t)payload_len;
+  }
+
   // check buffer capacity
   if ((uint32_t)(buf_end - buf_ptr) < rem_len) {
     return LWMQTT_BUFFER_TOO_SHORT;
@@ -454,6 +468,16 @@ lwmqtt_err_t lwmqtt_decode_publish(uint8_t *buf, size_t buf_len, bool *dup, uint
     *packet_id = 0;
   }
 
+  // set streamed payload
+  if (payload != NULL) {
+    if (buf_ptr != buf_end) {
+      return LWMQTT_REMAINING_LENGTH_MISMATCH;
+    }
+    msg->payload = payload;
+    msg->payload_len = payload_len;
+    return LWMQTT_SUCCESS;
+  }
+
   // set payload length
   msg->payload_len = buf_end - buf_ptr;
 
@@ -122,6 +122,25 @@ lwmqtt_err_t lwmqtt_encode_ack(uint8_t *buf, size_t buf_len, size_t *len, lwmqtt
 lwmqtt_err_t lwmqtt_decode_publish(uint8_t *buf, size_t buf_len, bool *dup, uint16_t *packet_id, lwmqtt_string_t *topic,
                                    lwmqtt_message_t *msg);
 
+/**
+ * Decodes a publish packet whose payload was read into a separate buffer.
+ *
+ * Note: The supplied buffer only holds the fixed header, topic and packet id.
+ *
+ * @param buf - The raw buffer data.
+ * @param buf_len - The length of the specified buffer.
+ * @param payload - The buffer holding the payload.
+ * @param payload_len - The length of the payload.
+ * @param dup - The dup flag.
+ * @param packet_id  - The packet id.
+ * @param topic - The topic.
+ * @parma msg - The message.
+ * @return An error value.
+ */
+lwmqtt_err_t lwmqtt_decode_publish_streamed(uint8_t *buf, size_t buf_len, uint8_t *payload, size_t payload_len,
+                                            bool *dup, uint16_t *packet_id, lwmqtt_string_t *topic,
+                                            lwmqtt_message_t *msg);
+
 /**
  * Encodes a publish packet into the supplied buffer.
  *
@@ -9,8 +9,20 @@
 #include <Modbus/ERaModbusConfig.hpp>
 #include <Modbus/ERaDefineModbus.hpp>
 #include <Modbus/ERaModbusTransp.hpp>
+#include <Modbus/ERaModbusPlanner.hpp>
 #include <Modbus/ERaModbusCallbacks.hpp>
 
+#if defined(LINUX)
+    class ERaModbusBus;
+
+    /* Bus of one config entry (by id) or of a serial slave (by unit) */
+    typedef struct __ModbusBusRoute_t {
+        bool entry;
+        int id;
+        uint8_t bus;
+    } ModbusBusRoute_t;
+#endif
+
 using namespace std;
 
 template <class Api>
@@ -46,8 +58,14 @@ public:
         , modbusControl(ERaModbusEntry::control())
         , modbusScan(ERaScanEntry::instance())
         , pModbusCallbacks(NULL)
+        , readBlock(NULL)
         , timeout(DEFAULT_TIMEOUT_MODBUS)
         , prevMillis(0)
+        , keyData(NULL)
+        , keyLen(0)
+        , keySize(0)
+        , keySeq(0)
+        , deltaPublish(ERA_MODBUS_DELTA_PUBLISH)
         , total(0)
         , failRead(0)
         , failWrite(0)
@@ -70,10 +88,19 @@ public:
         , skipModbus(false)
         , wifiConfig(false)
         , runApiResponse(true)
+#if defined(LINUX)
+        , activeBus(NULL)
+#endif
     {}
     ~ERaModbus()
     {
         this->switchToModbusRTU();
+#if defined(LINUX)
+        this->endBus();
+#endif
+        ERA_FREE(this->keyData);
+        this->keyData = NULL;
+        this->keySize = 0;
     }
 
     void setModbusClient(Client& _client, IPAddress _ip = IPAddress(0, 0, 0, 0), uint16_t _port = 502) {
@@ -97,6 +124,13 @@ public:
         ERaModbusEntry::getConfig()->pubInterval.delay = _interval;
     }
 
+    /* Publish only the blocks changed since the last full snapshot,
+       the full snapshot is still sent every pubInterval */
+    void setModbusDeltaPublish(bool enable) {
+        this->deltaPublish = enable;
+        this->keyLen = 0;
+    }
+
     void setModbusCallbacks(ERaModbusCallbacks& callbacks) {
         this->pModbusCallbacks = &callbacks;
     }
@@ -117,6 +151,20 @@ public:
         this->wifiConfig = enable;
     }
 
+    /* Own poll period of a slave, 0 follows the configured sweep */
+    void setModbusSlaveInterval(uint8_t slave, uint32_t interval) {
+        ERaGuardLock(this->mutex);
+        this->readPlan.setInterval(slave, interval);
+        ERaGuardUnlock(this->mutex);
+    }
+
+#if defined(LINUX)
+    uint8_t addModbusBus(const char* device, int baudrate);
+    uint8_t addModbusBus(IPAddress _ip, uint16_t _port);
+    void setModbusSlaveBus(uint8_t slave, uint8_t bus);
+    void setModbusConfigBus(int id, uint8_t bus);
+#endif
+
 protected:
     void begin() {
         ERaModbusEntry::getConfig();
@@ -151,6 +199,9 @@ protected:
                 this->modbusConfig->modbusInterval.prevMillis = ERaMillis();
                 this->readModbusConfig();
             }
+            else if (this->isScheduleDue()) {
+                this->readModbusConfig(false);
+            }
 #if !defined(ERA_NO_RTOS)
             this->timer.run();
 #endif
@@ -191,6 +242,7 @@ protected:
         else {
             ERaGuardLock(this->mutex);
             this->modbusConfig->parseConfig(config);
+            this->readPlan.invalidate(true);
             if (this->modbusConfig->updateHashID(hash)) {
                 this->clearDataBuff();
                 this->thisApi().writeToFlash(FILENAME_CONFIG, buf);
@@ -221,17 +273,21 @@ protected:
         if (this->modbusConfig != nullptr) {
             this->modbusConfig->deleteAll();
         }
+        this->readPlan.invalidate(true);
         if (this->modbusControl != nullptr) {
             this->modbusControl->deleteAll();
         }
         ModbusState::set(ModbusStateT::STATE_MB_PARSE);
         ERaGuardUnlock(this->mutex);
+        this->thisApi().beginFlashBatch();
         this->thisApi().removeFromFlash(FILENAME_CONFIG);
         this->thisApi().removeFromFlash(FILENAME_CONTROL);
+        this->thisApi().commitFlashBatch();
     }
 
     void clearDataBuff() {
         this->dataBuff.clearBuffer();
+        this->keyLen = 0;
     }
 
     bool addModbusAction(const char* ptr) {
@@ -321,6 +377,7 @@ private:
         char* ptr = nullptr;
         ptr = this->thisApi().readFromFlash(FILENAME_CONFIG);
         this->updateConfig(this->modbusConfig, ptr, "configuration");
+        this->readPlan.invalidate(true);
         if (this->initialized) {
             this->setBaudRate(this->modbusConfig->baudSpeed);
         }
@@ -425,13 +482,16 @@ private:
     void configModbus();
     void endModbus();
     void setBaudRate(uint32_t baudrate);
-    void readModbusConfig();
+    void readModbusConfig(bool sweep = true);
     bool checkPubDataInterval();
+    void publishModbusData();
+    void publishModbusDelta();
+    bool buildModbusDelta();
     void delayModbus(const int address, bool unlock = false, bool skip = false);
     void delays(MillisTime_t ms);
     ModbusConfigAlias_t* getModbusAlias(const char* key);
     ModbusConfig_t* getModbusConfig(int id);
-    void addScanData();
+    void addScanData(ERaDataBuff& buff);
     void processModbusScan();
 #if defined(ERA_PNP_MODBUS)
     void processModbusControl();
@@ -441,11 +501,26 @@ private:
     bool eachActionModbus(ModbusAction_t& request, Action_t& action, ModbusConfig_t*& config);
     void sendModbusRead(ModbusConfig_t& param);
     bool handlerModbusRead(ModbusConfig_t* param);
+    bool handlerModbusReadBlock(ModbusBlock_t* block);
+    bool handlerModbusReadPipeline(ModbusBlock_t** blocks, size_t count);
+    void handlerModbusReadItem(ModbusReadItem_t* item);
     bool sendModbusWrite(ModbusConfig_t& param);
     bool handlerModbusWrite(ModbusConfig_t* param);
     void onData(ERaModbusRequest* request, ERaModbusResponse* response, bool skip = false);
-    void onError(ERaModbusRequest* request, bool skip = false);
+    void onError(ERaModbusRequest* request, ERaModbusResponse* response, bool skip = false);
     bool waitResponse(ERaModbusResponse* response);
+#if defined(LINUX)
+    bool waitResponseRTU(ERaModbusResponse* response);
+    ERaModbusBus* getBus(uint8_t id);
+    void setBusRoute(bool entry, int id, uint8_t bus);
+    bool findBus(const ModbusConfig_t& param, uint8_t& bus);
+    void routeBus();
+    void dispatchBus();
+    void collectBus(uint32_t generation);
+    void nextBus(const ModbusConfig_t& param);
+    void releaseBus();
+    void endBus();
+#endif
     void sendCommand(uint8_t* data, size_t size);
     void switchToTransmit();
     void switchToReceive();
@@ -482,6 +557,27 @@ private:
         } while (!this->thisApi().connected());
     }
 
+#if defined(ERA_NO_RTOS)
+    void runApi() {
+        if (this->runApiResponse) {
+            this->thisApi().run();
+            this->thisApi().runZigbee();
+        }
+    }
+#endif
+
+    bool isPipelineRead(const ModbusConfig_t& param) const {
+        return ((ERA_MODBUS_TCP_WINDOW > 1) &&
+                (this->clientTCP != nullptr) &&
+                param.ipSlave.ip.dword &&
+                param.ipSlave.port);
+    }
+
+    bool isSameGateway(const ModbusConfig_t& a, const ModbusConfig_t& b) const {
+        return ((a.ipSlave.ip.dword == b.ipSlave.ip.dword) &&
+                (a.ipSlave.port == b.ipSlave.port));
+    }
+
     bool getBit(uint8_t byte, uint8_t pos) {
         return ((byte >> pos) & 0x01);
     }
@@ -490,6 +586,16 @@ private:
         return this->_streamDefault;
     }
 
+    bool isScheduleDue() {
+        bool due {false};
+        ERaGuardLock(this->mutex);
+        if (!this->readPlan.isDirty()) {
+            due = this->readPlan.hasDue(ERaMillis());
+        }
+        ERaGuardUnlock(this->mutex);
+        return due;
+    }
+
     void executeNow() {
         this->modbusConfig->modbusInterval.prevMillis = (ERaMillis() - this->modbusConfig->modbusInterval.delay + ERA_MODBUS_EXECUTE_MS);
     }
@@ -525,12 +631,20 @@ private:
 
     ERaQueue<ModbusAction_t, MODBUS_MAX_ACTION> queue;
     ERaDataBuffDynamic dataBuff;
+    ERaDataBuffDynamic deltaBuff;
     ERaModbusEntry*& modbusConfig;
     ERaModbusEntry*& modbusControl;
     ERaScanEntry*& modbusScan;
     ERaModbusCallbacks* pModbusCallbacks;
+    ERaModbusPlanner readPlan;
+    ModbusBlock_t* readBlock;
     uint32_t timeout;
     unsigned long prevMillis;
+    char* keyData;
+    size_t keyLen;
+    size_t keySize;
+    unsigned int keySeq;
+    bool deltaPublish;
     int total;
     int failRead;
     int failWrite;
@@ -552,25 +666,91 @@ private:
     bool skipModbus;
     bool wifiConfig;
     volatile bool runApiResponse;
+
+#if defined(LINUX)
+    ERaList<ERaModbusBus*> buses;
+    ERaList<ModbusBusRoute_t*> busRoutes;
+    ERaModbusBus* activeBus;
+#endif
 };
 
 template <class Api>
-void ERaModbus<Api>::readModbusConfig() {
+void ERaModbus<Api>::readModbusConfig(bool sweep) {
     if (this->modbusConfig->modbusConfigParam.isEmpty()) {
         return;
     }
+    ERaGuardLock(this->mutex);
+    if (this->readPlan.isDirty()) {
+#if defined(LINUX)
+        this->routeBus();
+#endif
+        this->readPlan.build(this->modbusConfig->modbusConfigParam);
+    }
+    this->readPlan.plan(ERaMillis(), sweep);
+    ERaGuardUnlock(this->mutex);
     this->dataBuff.clear();
-    const ERaList<ModbusConfig_t*>::iterator* e = this->modbusConfig->modbusConfigParam.end();
-    for (ERaList<ModbusConfig_t*>::iterator* it = this->modbusConfig->modbusConfigParam.begin(); it != e; it = it->getNext()) {
-        ModbusConfig_t* param = it->get();
-        if (!this->handlerModbusRead(param)) {
+#if defined(LINUX)
+    uint32_t generation = this->readPlan.getGeneration();
+    this->dispatchBus();
+#endif
+    size_t count {0};
+    ModbusBlock_t* window[ERA_MODBUS_TCP_WINDOW] {nullptr};
+    const ERaList<ModbusBlock_t*>::iterator* e = this->readPlan.getBlocks().end();
+    for (ERaList<ModbusBlock_t*>::iterator* it = this->readPlan.getBlocks().begin(); it != e; it = it->getNext()) {
+        ModbusBlock_t* block = it->get();
+        if (block->param.bus) {
+            /* Read by the bus worker */
+            continue;
+        }
+        if (ERaModbusPlanner::isSkipped(block)) {
+            continue;
+        }
+        if (count && !this->isSameGateway(window[0]->param, block->param)) {
+            if (!this->handlerModbusReadPipeline(window, count)) {
+                return;
+            }
+            count = 0;
+        }
+        if (this->isPipelineRead(block->param)) {
+            window[count++] = block;
+            if (count < ERA_MODBUS_TCP_WINDOW) {
+                continue;
+            }
+            if (!this->handlerModbusReadPipeline(window, count)) {
+                return;
+            }
+            count = 0;
+        }
+        else if (!this->handlerModbusReadBlock(block)) {
             return;
         }
     }
+    if (count && !this->handlerModbusReadPipeline(window, count)) {
+        return;
+    }
+#if defined(LINUX)
+    this->collectBus(generation);
+#endif
+    ERaGuardLock(this->mutex);
+    if (ModbusState::is(ModbusStateT::STATE_MB_PARSE) ||
+        ModbusState::is(ModbusStateT::STATE_MB_CONTROLLED)) {
+        ERaGuardUnlock(this->mutex);
+        this->executeNow();
+        return;
+    }
+    const ERaList<ModbusReadItem_t*>::iterator* ei = this->readPlan.getItems().end();
+    for (ERaList<ModbusReadItem_t*>::iterator* it = this->readPlan.getItems().begin(); it != ei; it = it->getNext()) {
+        this->handlerModbusReadItem(it->get());
+    }
+    ERaGuardUnlock(this->mutex);
     if (this->dataBuff.isEmpty()) {
         return;
     }
 #if !defined(ERA_MODBUS_DATA_LEGACY)
+    if (this->deltaPublish) {
+        this->publishModbusDelta();
+        return;
+    }
     if (this->dataBuff.isChange()) {
         this->prevMillis = ERaMillis();
     }
@@ -578,12 +758,99 @@ void ERaModbus<Api>::readModbusConfig() {
         return;
     }
 #endif
+    this->publishModbusData();
+}
+
+template <class Api>
+void ERaModbus<Api>::publishModbusData() {
     this->dataBuff.add_multi(ERA_F("fail_read"), this->failRead, ERA_F("fail_write"), this->failWrite, ERA_F("total"), this->total);
-    this->addScanData();
+    this->addScanData(this->dataBuff);
     this->dataBuff.done();
     this->thisApi().modbusDataWrite(&this->dataBuff);
 }
 
+template <class Api>
+void ERaModbus<Api>::publishModbusDelta() {
+    bool changed = this->dataBuff.isChange();
+    bool keyframe = this->checkPubDataInterval();
+    if (!keyframe && !changed) {
+        return;
+    }
+    if (!keyframe && this->buildModbusDelta()) {
+        this->deltaBuff.add_multi(ERA_F("key"), this->keySeq);
+        this->deltaBuff.add_multi(ERA_F("fail_read"), this->failRead, ERA_F("fail_write"), this->failWrite, ERA_F("total"), this->total);
+        this->addScanData(this->deltaBuff);
+        this->deltaBuff.done();
+        this->thisApi().modbusDataWrite(&this->deltaBuff);
+        return;
+    }
+
+    /* Full snapshot, the next deltas are relative to it */
+    this->keyLen = 0;
+    size_t len = this->dataBuff.getLen();
+    if (len > this->keySize) {
+        /* Grow with the data, a truncated snapshot would never match */
+        char* copy = (char*)ERA_REALLOC(this->keyData, len);
+        if (copy != nullptr) {
+            this->keyData = copy;
+            this->keySize = len;
+        }
+    }
+    if ((this->keyData != nullptr) && (len <= this->keySize)) {
+        this->keyLen = len;
+        memcpy(this->keyData, this->dataBuff.getBuffer(), this->keyLen);
+    }
+    this->prevMillis = ERaMillis();
+    this->dataBuff.add_multi(ERA_F("key"), ++this->keySeq);
+    this->publishModbusData();
+}
+
+/* Blocks that differ from the last snapshot, as index, data and ack.
+   Deltas are cumulative so a lost or coalesced one does no harm. */
+template <class Api>
+bool ERaModbus<Api>::buildModbusDelta() {
+    if ((this->keyData == nullptr) || !this->keyLen) {
+        return false;
+    }
+    this->deltaBuff.allocate(MODBUS_DATA_BUFFER_SIZE);
+    if (!this->deltaBuff.isValid()) {
+        return false;
+    }
+    this->deltaBuff.clear();
+    this->deltaBuff.add(ERA_F("delta"));
+
+    int index {0};
+    ERaDataBuff keyBuff(this->keyData, this->keyLen);
+    ERaDataBuff::iterator it = this->dataBuff.begin();
+    ERaDataBuff::iterator kit = keyBuff.begin();
+    const ERaDataBuff::iterator e = this->dataBuff.end();
+    const ERaDataBuff::iterator ke = keyBuff.end();
+    for (; (it < e) && (kit < ke); ++index) {
+        const char* data = it;
+        const char* keyValue = kit;
+        ++it; ++kit;
+        if (!it.isValid() || !kit.isValid()) {
+            return false;
+        }
+        const char* ack = it;
+        const char* keyAck = kit;
+        ++it; ++kit;
+        if (!strcmp(data, keyValue) &&
+            !strcmp(ack, keyAck)) {
+            continue;
+        }
+        this->deltaBuff.add(index);
+        this->deltaBuff.add(data);
+        this->deltaBuff.add(ack);
+    }
+    if ((it < e) || (kit < ke)) {
+        /* Layout changed */
+        return false;
+    }
+    /* Not worth it when most blocks changed */
+    return ((this->deltaBuff.getLen() * 2) <= this->dataBuff.getLen());
+}
+
 template <class Api>
 bool ERaModbus<Api>::checkPubDataInterval() {
     unsigned long currentMillis = ERaMillis();
@@ -676,18 +943,18 @@ ModbusConfigAlias_t* ERaModbus<Api>::getModbusAlias(const char* key) {
 }
 
 template <class Api>
-void ERaModbus<Api>::addScanData() {
+void ERaModbus<Api>::addScanData(ERaDataBuff& buff) {
     if (this->modbusScan == nullptr) {
         return;
     }
 
     if (this->modbusScan->numberDevice) {
-        this->dataBuff.add(ERA_F("scan"));
-        this->dataBuff.add_hex_array(this->modbusScan->addr,
+        buff.add(ERA_F("scan"));
+        buff.add_hex_array(this->modbusScan->addr,
                             this->modbusScan->numberDevice);
     }
     else {
-        this->dataBuff.add_multi(ERA_F("scan"), ERA_F("None"));
+        buff.add_multi(ERA_F("scan"), ERA_F("None"));
     }
 }
 
@@ -707,7 +974,8 @@ void ERaModbus<Api>::processModbusScan() {
         .sa1 = 0,
         .sa2 = 0,
         .len1 = 0,
-        .len2 = 1
+        .len2 = 1,
+        .bus = 0
     };
 
     for (size_t i = this->modbusScan->start; (i < this->modbusScan->end) &&
@@ -935,10 +1203,186 @@ bool ERaModbus<Api>::handlerModbusRead(ModbusConfig_t* param) {
     return true;
 }
 
+template <class Api>
+bool ERaModbus<Api>::handlerModbusReadBlock(ModbusBlock_t* block) {
+    if (block == nullptr) {
+        return false;
+    }
+    ERaGuardLock(this->mutex);
+    if (ModbusState::is(ModbusStateT::STATE_MB_PARSE) ||
+        ModbusState::is(ModbusStateT::STATE_MB_CONTROLLED)) {
+        ERaGuardUnlock(this->mutex);
+        this->executeNow();
+        return false;
+    }
+
+    uint32_t prevTimeout = this->timeout;
+    if (block->probe) {
+        /* Dead slave, do not wait the full timeout for it */
+        this->timeout = ERaMin(prevTimeout, (uint32_t)ERA_MODBUS_PROBE_TIMEOUT_MS);
+    }
+    block->status = false;
+    block->statusCode = ModbusStatusT::MODBUS_STATUS_OK;
+    block->bytes = 0;
+    this->readBlock = block;
+    this->sendModbusRead(block->param);
+    this->readBlock = nullptr;
+    this->timeout = prevTimeout;
+    if (!block->status &&
+        (block->statusCode != ModbusStatusT::MODBUS_STATUS_OK)) {
+        /* Slave rejected the joined range, read these entries one by one */
+        this->readPlan.split(block);
+    }
+    this->readPlan.schedule(block, ERaMillis());
+
+    this->delayModbus(block->param.addr, true);
+    if (ModbusState::is(ModbusStateT::STATE_MB_PARSE) ||
+        ModbusState::is(ModbusStateT::STATE_MB_CONTROLLED)) {
+        this->executeNow();
+        return false;
+    }
+    return true;
+}
+
+template <class Api>
+bool ERaModbus<Api>::handlerModbusReadPipeline(ModbusBlock_t** blocks, size_t count) {
+    if ((blocks == nullptr) ||
+        !count) {
+        return false;
+    }
+    if (count == 1) {
+        return this->handlerModbusReadBlock(blocks[0]);
+    }
+
+    ERaGuardLock(this->mutex);
+    if (ModbusState::is(ModbusStateT::STATE_MB_PARSE) ||
+        ModbusState::is(ModbusStateT::STATE_MB_CONTROLLED)) {
+        ERaGuardUnlock(this->mutex);
+        this->executeNow();
+        return false;
+    }
+
+    ModbusTransaction_t trans[ERA_MODBUS_TCP_WINDOW] {};
+    this->nextTransport(blocks[0]->param);
+    for (size_t i = 0; i < count; ++i) {
+        trans[i].request = ERaModbusReadRequest(this->transp, blocks[i]->param);
+        if (trans[i].request != nullptr) {
+            trans[i].response = new_modbus ERaModbusResponse(trans[i].request, trans[i].request->responseLength());
+        }
+        if (blocks[i]->probe) {
+            /* Dead slave, do not hold the window the full timeout for it */
+            trans[i].timeout = ERaMin(this->timeout, (uint32_t)ERA_MODBUS_PROBE_TIMEOUT_MS);
+        }
+    }
+
+    ModbusTransp::processReadPipeline(trans, count);
+
+    for (size_t i = 0; i < count; ++i) {
+        ModbusBlock_t* block = blocks[i];
+        block->status = false;
+        block->statusCode = ModbusStatusT::MODBUS_STATUS_OK;
+        block->bytes = 0;
+        if ((trans[i].request != nullptr) &&
+            (trans[i].response != nullptr)) {
+            this->readBlock = block;
+            if (trans[i].status) {
+                this->onData(trans[i].request, trans[i].response);
+            }
+            else {
+                this->onError(trans[i].request, trans[i].response);
+            }
+            this->readBlock = nullptr;
+        }
+        if (block->status) {
+            block->param.totalFail = 0;
+        }
+        else {
+            this->failRead++;
+            block->param.totalFail++;
+            if (block->statusCode != ModbusStatusT::MODBUS_STATUS_OK) {
+                this->readPlan.split(block);
+            }
+        }
+        this->readPlan.schedule(block, ERaMillis());
+        delete trans[i].request;
+        delete trans[i].response;
+    }
+
+#if defined(ERA_NO_RTOS)
+    ERaWatchdogFeed();
+#endif
+
+    this->delayModbus(blocks[count - 1]->param.addr, true);
+    if (ModbusState::is(ModbusStateT::STATE_MB_PARSE) ||
+        ModbusState::is(ModbusStateT::STATE_MB_CONTROLLED)) {
+        this->executeNow();
+        return false;
+    }
+    return true;
+}
+
+template <class Api>
+void ERaModbus<Api>::handlerModbusReadItem(ModbusReadItem_t* item) {
+    if ((item == nullptr) ||
+        (item->param == nullptr) ||
+        (item->block == nullptr)) {
+        return;
+    }
+
+    ModbusConfig_t& param = (*item->param);
+    const ModbusBlock_t& block = (*item->block);
+    uint8_t itemTransp = ModbusTransportT::MODBUS_TRANSPORT_RTU;
+    if ((this->clientTCP != nullptr) && param.ipSlave.ip.dword) {
+        itemTransp = ModbusTransportT::MODBUS_TRANSPORT_TCP;
+    }
+    ERaModbusRequest* request = ERaModbusReadRequest(itemTransp, param);
+    ERA_ASSERT_NULL(request, )
+    ERaModbusResponse* response = new_modbus ERaModbusResponse(request, request->responseLength());
+    if (response == nullptr) {
+        delete request;
+        return;
+    }
+
+    if (block.status) {
+        uint8_t data[MODBUS_BUFFER_SIZE] {0};
+        uint16_t length = ERaModbusPlanner::getLength(param);
+        uint8_t bytes {0};
+        if (ERaModbusPlanner::isBits(param.func)) {
+            bytes = ((length + 7) / 8);
+            for (uint16_t i = 0; i < length; ++i) {
+                uint16_t bit = (item->offset + i);
+                if (this->getBit(block.data[bit / 8], bit % 8)) {
+                    data[i / 8] |= (0x01 << (i % 8));
+                }
+            }
+        }
+        else {
+            bytes = (length * 2);
+            memcpy(data, block.data + (item->offset * 2), bytes);
+        }
+        response->setDataIndex();
+        response->setBytes(bytes);
+        response->setData(data, bytes);
+        param.totalFail = 0;
+        this->onData(request, response);
+    }
+    else {
+        param.totalFail++;
+        this->onError(request, response);
+    }
+
+    delete request;
+    delete response;
+}
+
 template <class Api>
 bool ERaModbus<Api>::sendModbusWrite(ModbusConfig_t& param) {
     bool status {false};
+    bool valid {true};
     this->nextTransport(param);
+#if defined(LINUX)
+    this->nextBus(param);
+#endif
     switch (param.func) {
         case ModbusFunctionT::FORCE_SINGLE_COIL:
             status = ModbusTransp::forceSingleCoil(this->transp, param);
@@ -953,7 +1397,16 @@ bool ERaModbus<Api>::sendModbusWrite(ModbusConfig_t& param) {
             status = ModbusTransp::presetMultipleRegisters(this->transp, param);
             break;
         default:
-            return false;
+            valid = false;
+            break;
+    }
+
+#if defined(LINUX)
+    this->releaseBus();
+#endif
+
+    if (!valid) {
+        return false;
     }
 
 #if defined(ERA_NO_RTOS)
@@ -996,6 +1449,12 @@ void ERaModbus<Api>::onData(ERaModbusRequest* request, ERaModbusResponse* respon
     if (ModbusState::is(ModbusStateT::STATE_MB_PARSE)) {
         return;
     }
+    if (this->readBlock != nullptr) {
+        this->readBlock->status = true;
+        this->readBlock->bytes = ERaMin(response->getBytes(), (uint8_t)sizeof(this->readBlock->data));
+        memcpy(this->readBlock->data, response->getData(), this->readBlock->bytes);
+        return;
+    }
 
     switch (request->getFunction()) {
         case ModbusFunctionT::READ_COIL_STATUS:
@@ -1025,7 +1484,7 @@ void ERaModbus<Api>::onData(ERaModbusRequest* request, ERaModbusResponse* respon
 }
 
 template <class Api>
-void ERaModbus<Api>::onError(ERaModbusRequest* request, bool skip) {
+void ERaModbus<Api>::onError(ERaModbusRequest* request, ERaModbusResponse* response, bool skip) {
     if (skip) {
         return;
     }
@@ -1035,6 +1494,13 @@ void ERaModbus<Api>::onError(ERaModbusRequest* request, bool skip) {
     if (ModbusState::is(ModbusStateT::STATE_MB_PARSE)) {
         return;
     }
+    if (this->readBlock != nullptr) {
+        this->readBlock->status = false;
+        if (response != nullptr) {
+            this->readBlock->statusCode = response->getStatusCode();
+        }
+        return;
+    }
 
     size_t pDataLen {0};
     switch (request->getFunction()) {
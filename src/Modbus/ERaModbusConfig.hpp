@@ -94,6 +94,16 @@
     #define ERA_MODBUS_MUTEX_MS         100UL
 #endif
 
+/* Outstanding Modbus TCP transactions per gateway, 1 to disable pipelining */
+#if !defined(ERA_MODBUS_TCP_WINDOW)
+    #define ERA_MODBUS_TCP_WINDOW       4
+#endif
+
+/* Publish changed blocks only, with a full snapshot every pubInterval */
+#if !defined(ERA_MODBUS_DELTA_PUBLISH)
+    #define ERA_MODBUS_DELTA_PUBLISH    false
+#endif
+
 #if !defined(ERA_DISABLE_PNP_MODBUS)
     #define ERA_PNP_MODBUS
 #endif
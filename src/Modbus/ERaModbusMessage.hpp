@@ -44,6 +44,10 @@ public:
         return this->index;
     }
 
+    uint8_t getRemaining() {
+        return (this->length - this->index);
+    }
+
     void add(uint8_t value) {
         if (this->index >= this->length) {
             return;
@@ -51,6 +55,18 @@ public:
         this->buffer[this->index++] = value;
     }
 
+    /* Bulk receive: read straight into getNext(), then commit with advance() */
+    uint8_t* getNext() {
+        return (this->buffer + this->index);
+    }
+
+    void advance(size_t count) {
+        if (count > this->getRemaining()) {
+            count = this->getRemaining();
+        }
+        this->index += count;
+    }
+
 protected:
     uint8_t* buffer;
     uint8_t length;
@@ -0,0 +1,522 @@
+#ifndef INC_ERA_MODBUS_PLANNER_HPP_
+#define INC_ERA_MODBUS_PLANNER_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <Utility/ERaUtility.hpp>
+#include <Modbus/ERaParse.hpp>
+#include <Modbus/ERaDefineModbus.hpp>
+#include <Modbus/ERaModbusConfig.hpp>
+#include <Modbus/ERaModbusMessage.hpp>
+
+/* Largest hole (registers or bits) read through to join two entries */
+#if !defined(ERA_MODBUS_MAX_READ_GAP)
+    #define ERA_MODBUS_MAX_READ_GAP     4
+#endif
+
+/* Polling cycles in a row with every read timing out before a slave is treated as dead */
+#if !defined(ERA_MODBUS_DEAD_FAILS)
+    #define ERA_MODBUS_DEAD_FAILS       3
+#endif
+
+/* Probe period of a dead slave, doubled after every failed probe */
+#if !defined(ERA_MODBUS_BACKOFF_MIN_MS)
+    #define ERA_MODBUS_BACKOFF_MIN_MS   5000UL
+#endif
+
+#if !defined(ERA_MODBUS_BACKOFF_MAX_MS)
+    #define ERA_MODBUS_BACKOFF_MAX_MS   300000UL
+#endif
+
+/* Response timeout of a probe */
+#if !defined(ERA_MODBUS_PROBE_TIMEOUT_MS)
+    #define ERA_MODBUS_PROBE_TIMEOUT_MS 300UL
+#endif
+
+#define MODBUS_MAX_READ_REGISTERS       125
+#define MODBUS_MAX_READ_BITS            2000
+
+typedef struct __ModbusSlave_t {
+    uint8_t addr;
+    uint8_t bus;
+    uint32_t ip;
+    uint16_t port;
+    uint32_t interval;
+    uint8_t fails;
+    uint32_t backoff;
+    MillisTime_t probeMillis;
+    uint32_t probeCycle;
+    uint32_t failCycle;
+} ModbusSlave_t;
+
+typedef struct __ModbusBlock_t {
+    ModbusConfig_t param;
+    ModbusSlave_t* slave;
+    uint8_t count;
+    bool status;
+    uint8_t statusCode;
+    uint8_t bytes;
+    uint8_t data[MODBUS_BUFFER_SIZE];
+    MillisTime_t lastMillis;
+    bool hasRead;
+    bool due;
+    bool probe;
+} ModbusBlock_t;
+
+typedef struct __ModbusReadItem_t {
+    ModbusConfig_t* param;
+    ModbusBlock_t* block;
+    uint16_t offset;
+} ModbusReadItem_t;
+
+typedef struct __ModbusNoMerge_t {
+    uint8_t addr;
+    uint8_t func;
+    uint32_t ip;
+} ModbusNoMerge_t;
+
+typedef struct __ModbusInterval_t {
+    uint8_t addr;
+    uint32_t interval;
+} ModbusInterval_t;
+
+class ERaModbusPlanner
+{
+public:
+    ERaModbusPlanner()
+        : dirty(true)
+        , generation(0)
+        , cycle(0)
+    {}
+    ~ERaModbusPlanner()
+    {
+        this->clear();
+        this->clearNoMerge();
+        this->clearSlaves();
+        this->clearIntervals();
+    }
+
+    /* Reset drops entries pointing at the old config, call it under the modbus mutex */
+    void invalidate(bool reset = false) {
+        if (reset) {
+            this->clear();
+            this->clearNoMerge();
+            this->clearSlaves();
+        }
+        this->dirty = true;
+    }
+
+    bool isDirty() const {
+        return this->dirty;
+    }
+
+    bool isEmpty() const {
+        return this->items.isEmpty();
+    }
+
+    /* Changes whenever blocks are freed */
+    uint32_t getGeneration() const {
+        return this->generation;
+    }
+
+    void build(const ERaList<ModbusConfig_t*>& params);
+    void split(const ModbusBlock_t* block);
+    void setInterval(uint8_t addr, uint32_t interval);
+    void plan(MillisTime_t now, bool sweep);
+    bool hasDue(MillisTime_t now) const;
+    void schedule(ModbusBlock_t* block, MillisTime_t now);
+
+    /* Not planned, or its slave died earlier in this cycle */
+    static bool isSkipped(const ModbusBlock_t* block) {
+        return (!block->due ||
+                (block->slave->backoff && !block->probe));
+    }
+
+    const ERaList<ModbusBlock_t*>& getBlocks() const {
+        return this->blocks;
+    }
+
+    const ERaList<ModbusReadItem_t*>& getItems() const {
+        return this->items;
+    }
+
+    static bool isRead(uint8_t func) {
+        switch (func) {
+            case ModbusFunctionT::READ_COIL_STATUS:
+            case ModbusFunctionT::READ_INPUT_STATUS:
+            case ModbusFunctionT::READ_HOLDING_REGISTERS:
+            case ModbusFunctionT::READ_INPUT_REGISTERS:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool isBits(uint8_t func) {
+        return ((func == ModbusFunctionT::READ_COIL_STATUS) ||
+                (func == ModbusFunctionT::READ_INPUT_STATUS));
+    }
+
+    static uint16_t getStart(const ModbusConfig_t& param) {
+        return BUILD_WORD(param.sa1, param.sa2);
+    }
+
+    static uint16_t getLength(const ModbusConfig_t& param) {
+        return BUILD_WORD(param.len1, param.len2);
+    }
+
+    /* Response must fit the uint8_t sized ERaModbusMessage */
+    static uint16_t getMaxLength(const ModbusConfig_t& param) {
+        size_t bytes = (0xFF - (param.ipSlave.ip.dword ? 9 : 5));
+        if (ERaModbusPlanner::isBits(param.func)) {
+            return (uint16_t)ERaMin(bytes * 8, (size_t)MODBUS_MAX_READ_BITS);
+        }
+        return (uint16_t)ERaMin(bytes / 2, (size_t)MODBUS_MAX_READ_REGISTERS);
+    }
+
+private:
+    ModbusBlock_t* findBlock(const ModbusConfig_t& param);
+    ModbusSlave_t* findSlave(const ModbusConfig_t& param);
+    uint32_t getInterval(uint8_t addr) const;
+    bool isDue(const ModbusBlock_t* block, MillisTime_t now, bool sweep) const;
+    bool isNoMerge(const ModbusConfig_t& param);
+    void clear();
+    void clearNoMerge();
+    void clearSlaves();
+    void clearIntervals();
+
+    static bool isSameSlave(const ModbusConfig_t& a, const ModbusConfig_t& b) {
+        return ((a.addr == b.addr) &&
+                (a.func == b.func) &&
+                (a.ipSlave.ip.dword == b.ipSlave.ip.dword) &&
+                (a.ipSlave.port == b.ipSlave.port) &&
+                (a.bus == b.bus));
+    }
+
+    ERaList<ModbusBlock_t*> blocks;
+    ERaList<ModbusReadItem_t*> items;
+    ERaList<ModbusNoMerge_t*> noMerge;
+    ERaList<ModbusSlave_t*> slaves;
+    ERaList<ModbusInterval_t*> intervals;
+    bool dirty;
+    uint32_t generation;
+    uint32_t cycle;
+};
+
+inline
+void ERaModbusPlanner::build(const ERaList<ModbusConfig_t*>& params) {
+    this->clear();
+    this->dirty = false;
+
+    const ERaList<ModbusConfig_t*>::iterator* e = params.end();
+    for (ERaList<ModbusConfig_t*>::iterator* it = params.begin(); it != e; it = it->getNext()) {
+        ModbusConfig_t* param = it->get();
+        if (param == nullptr) {
+            continue;
+        }
+        if (!ERaModbusPlanner::isRead(param->func)) {
+            continue;
+        }
+
+        ModbusReadItem_t* item = new_modbus ModbusReadItem_t();
+        if (item == nullptr) {
+            continue;
+        }
+        ModbusBlock_t* block = this->findBlock(*param);
+        if (block != nullptr) {
+            uint16_t start = ERaMin(getStart(block->param), getStart(*param));
+            uint16_t end = ERaMax((uint16_t)(getStart(block->param) + getLength(block->param)),
+                                  (uint16_t)(getStart(*param) + getLength(*param)));
+            block->param.sa1 = HI_WORD(start);
+            block->param.sa2 = LO_WORD(start);
+            block->param.len1 = HI_WORD(end - start);
+            block->param.len2 = LO_WORD(end - start);
+            block->count++;
+        }
+        else {
+            block = new_modbus ModbusBlock_t();
+            if (block == nullptr) {
+                delete item;
+                continue;
+            }
+            block->param = (*param);
+            block->slave = this->findSlave(*param);
+            block->count = 1;
+            if (block->slave == nullptr) {
+                delete block;
+                delete item;
+                continue;
+            }
+            this->blocks.put(block);
+        }
+        item->param = param;
+        item->block = block;
+        this->items.put(item);
+    }
+
+    const ERaList<ModbusReadItem_t*>::iterator* ei = this->items.end();
+    for (ERaList<ModbusReadItem_t*>::iterator* it = this->items.begin(); it != ei; it = it->getNext()) {
+        ModbusReadItem_t* item = it->get();
+        item->offset = (getStart(*item->param) - getStart(item->block->param));
+    }
+}
+
+inline
+void ERaModbusPlanner::split(const ModbusBlock_t* block) {
+    if ((block == nullptr) ||
+        (block->count < 2)) {
+        return;
+    }
+    if (this->isNoMerge(block->param)) {
+        return;
+    }
+
+    ModbusNoMerge_t* key = new_modbus ModbusNoMerge_t();
+    if (key == nullptr) {
+        return;
+    }
+    key->addr = block->param.addr;
+    key->func = block->param.func;
+    key->ip = block->param.ipSlave.ip.dword;
+    this->noMerge.put(key);
+    this->dirty = true;
+}
+
+inline
+void ERaModbusPlanner::setInterval(uint8_t addr, uint32_t interval) {
+    const ERaList<ModbusInterval_t*>::iterator* e = this->intervals.end();
+    for (ERaList<ModbusInterval_t*>::iterator* it = this->intervals.begin(); it != e; it = it->getNext()) {
+        ModbusInterval_t* item = it->get();
+        if (item->addr == addr) {
+            item->interval = interval;
+            this->dirty = true;
+            return;
+        }
+    }
+
+    ModbusInterval_t* item = new_modbus ModbusInterval_t();
+    if (item == nullptr) {
+        return;
+    }
+    item->addr = addr;
+    item->interval = interval;
+    this->intervals.put(item);
+    this->dirty = true;
+}
+
+/* Marks the blocks to read this cycle, a dead slave gets one probe per backoff period */
+inline
+void ERaModbusPlanner::plan(MillisTime_t now, bool sweep) {
+    this->cycle++;
+    const ERaList<ModbusBlock_t*>::iterator* e = this->blocks.end();
+    for (ERaList<ModbusBlock_t*>::iterator* it = this->blocks.begin(); it != e; it = it->getNext()) {
+        ModbusBlock_t* block = it->get();
+        ModbusSlave_t* slave = block->slave;
+        block->due = this->isDue(block, now, sweep);
+        block->probe = false;
+        if (!block->due || !slave->backoff) {
+            continue;
+        }
+        if (slave->probeCycle == this->cycle) {
+            /* Only the first block of a dead slave is probed */
+            block->due = false;
+            continue;
+        }
+        block->probe = true;
+        slave->probeCycle = this->cycle;
+        slave->probeMillis = now;
+    }
+}
+
+/* True if a slave with its own interval is due before the next sweep */
+inline
+bool ERaModbusPlanner::hasDue(MillisTime_t now) const {
+    const ERaList<ModbusBlock_t*>::iterator* e = this->blocks.end();
+    for (ERaList<ModbusBlock_t*>::iterator* it = this->blocks.begin(); it != e; it = it->getNext()) {
+        const ModbusBlock_t* block = it->get();
+        if (block->slave->interval &&
+            this->isDue(block, now, false)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline
+void ERaModbusPlanner::schedule(ModbusBlock_t* block, MillisTime_t now) {
+    if (block == nullptr) {
+        return;
+    }
+
+    ModbusSlave_t* slave = block->slave;
+    bool probe = block->probe;
+    block->due = false;
+    block->probe = false;
+    block->hasRead = true;
+    block->lastMillis = now;
+    if (block->status ||
+        (block->statusCode != ModbusStatusT::MODBUS_STATUS_OK)) {
+        /* Data or an exception, the slave is alive */
+        slave->fails = 0;
+        slave->backoff = 0;
+        return;
+    }
+    if (slave->failCycle == this->cycle) {
+        /* One failure per slave and cycle, however many blocks timed out */
+        return;
+    }
+    slave->failCycle = this->cycle;
+    if (!slave->backoff) {
+        if (++slave->fails >= ERA_MODBUS_DEAD_FAILS) {
+            slave->fails = 0;
+            slave->backoff = ERA_MODBUS_BACKOFF_MIN_MS;
+            slave->probeMillis = now;
+        }
+        return;
+    }
+    if (probe) {
+        slave->backoff = ERaMin(slave->backoff * 2, (uint32_t)ERA_MODBUS_BACKOFF_MAX_MS);
+        slave->probeMillis = now;
+    }
+}
+
+inline
+bool ERaModbusPlanner::isDue(const ModbusBlock_t* block, MillisTime_t now, bool sweep) const {
+    const ModbusSlave_t* slave = block->slave;
+    if (slave->backoff) {
+        return ((now - slave->probeMillis) >= slave->backoff);
+    }
+    if (!block->hasRead) {
+        return true;
+    }
+    if (!slave->interval) {
+        return sweep;
+    }
+    return ((now - block->lastMillis) >= slave->interval);
+}
+
+inline
+ModbusSlave_t* ERaModbusPlanner::findSlave(const ModbusConfig_t& param) {
+    const ERaList<ModbusSlave_t*>::iterator* e = this->slaves.end();
+    for (ERaList<ModbusSlave_t*>::iterator* it = this->slaves.begin(); it != e; it = it->getNext()) {
+        ModbusSlave_t* slave = it->get();
+        if ((slave->addr == param.addr) &&
+            (slave->bus == param.bus) &&
+            (slave->ip == param.ipSlave.ip.dword) &&
+            (slave->port == param.ipSlave.port)) {
+            slave->interval = this->getInterval(param.addr);
+            return slave;
+        }
+    }
+
+    ModbusSlave_t* slave = new_modbus ModbusSlave_t();
+    if (slave == nullptr) {
+        return nullptr;
+    }
+    slave->addr = param.addr;
+    slave->bus = param.bus;
+    slave->ip = param.ipSlave.ip.dword;
+    slave->port = param.ipSlave.port;
+    slave->interval = this->getInterval(param.addr);
+    this->slaves.put(slave);
+    return slave;
+}
+
+inline
+uint32_t ERaModbusPlanner::getInterval(uint8_t addr) const {
+    const ERaList<ModbusInterval_t*>::iterator* e = this->intervals.end();
+    for (ERaList<ModbusInterval_t*>::iterator* it = this->intervals.begin(); it != e; it = it->getNext()) {
+        const ModbusInterval_t* item = it->get();
+        if (item->addr == addr) {
+            return item->interval;
+        }
+    }
+    return 0;
+}
+
+inline
+ModbusBlock_t* ERaModbusPlanner::findBlock(const ModbusConfig_t& param) {
+    if (this->isNoMerge(param)) {
+        return nullptr;
+    }
+
+    uint32_t start = getStart(param);
+    uint32_t end = start + getLength(param);
+    const ERaList<ModbusBlock_t*>::iterator* e = this->blocks.end();
+    for (ERaList<ModbusBlock_t*>::iterator* it = this->blocks.begin(); it != e; it = it->getNext()) {
+        ModbusBlock_t* block = it->get();
+        if (!ERaModbusPlanner::isSameSlave(block->param, param)) {
+            continue;
+        }
+        uint32_t blockStart = getStart(block->param);
+        uint32_t blockEnd = blockStart + getLength(block->param);
+        if ((start > (blockEnd + ERA_MODBUS_MAX_READ_GAP)) ||
+            ((end + ERA_MODBUS_MAX_READ_GAP) < blockStart)) {
+            continue;
+        }
+        if ((ERaMax(end, blockEnd) - ERaMin(start, blockStart)) > getMaxLength(param)) {
+            continue;
+        }
+        return block;
+    }
+    return nullptr;
+}
+
+inline
+bool ERaModbusPlanner::isNoMerge(const ModbusConfig_t& param) {
+    const ERaList<ModbusNoMerge_t*>::iterator* e = this->noMerge.end();
+    for (ERaList<ModbusNoMerge_t*>::iterator* it = this->noMerge.begin(); it != e; it = it->getNext()) {
+        const ModbusNoMerge_t* key = it->get();
+        if ((key->addr == param.addr) &&
+            (key->func == param.func) &&
+            (key->ip == param.ipSlave.ip.dword)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline
+void ERaModbusPlanner::clear() {
+    const ERaList<ModbusBlock_t*>::iterator* e = this->blocks.end();
+    for (ERaList<ModbusBlock_t*>::iterator* it = this->blocks.begin(); it != e; it = it->getNext()) {
+        delete it->get();
+    }
+    this->blocks.clear();
+    const ERaList<ModbusReadItem_t*>::iterator* ei = this->items.end();
+    for (ERaList<ModbusReadItem_t*>::iterator* it = this->items.begin(); it != ei; it = it->getNext()) {
+        delete it->get();
+    }
+    this->items.clear();
+    this->generation++;
+}
+
+inline
+void ERaModbusPlanner::clearSlaves() {
+    const ERaList<ModbusSlave_t*>::iterator* e = this->slaves.end();
+    for (ERaList<ModbusSlave_t*>::iterator* it = this->slaves.begin(); it != e; it = it->getNext()) {
+        delete it->get();
+    }
+    this->slaves.clear();
+}
+
+inline
+void ERaModbusPlanner::clearIntervals() {
+    const ERaList<ModbusInterval_t*>::iterator* e = this->intervals.end();
+    for (ERaList<ModbusInterval_t*>::iterator* it = this->intervals.begin(); it != e; it = it->getNext()) {
+        delete it->get();
+    }
+    this->intervals.clear();
+}
+
+inline
+void ERaModbusPlanner::clearNoMerge() {
+    const ERaList<ModbusNoMerge_t*>::iterator* e = this->noMerge.end();
+    for (ERaList<ModbusNoMerge_t*>::iterator* it = this->noMerge.begin(); it != e; it = it->getNext()) {
+        delete it->get();
+    }
+    this->noMerge.clear();
+}
+
+#endif /* INC_ERA_MODBUS_PLANNER_HPP_ */
@@ -2,6 +2,7 @@
 #define INC_ERA_MODBUS_TRANSPORT_HPP_
 
 #include <math.h>
+#include <Utility/CRC16.hpp>
 #include <Modbus/ERaParse.hpp>
 #include <Modbus/ERaDefineModbus.hpp>
 #include <Modbus/ERaModbusMessage.hpp>
@@ -101,23 +102,7 @@ protected:
     }
 
     uint16_t modbusCRC(uint8_t* buf, size_t len) {
-        uint16_t crc = 0xFFFF;
-
-        for (size_t pos = 0; pos < len; pos++) {
-            crc ^= (uint16_t)buf[pos];
-
-            for (int i = 8; i != 0; i--) {
-                if ((crc & 0x0001) != 0) {
-                    crc >>= 1;
-                    crc ^= 0xA001;
-                }
-                else {
-                    crc >>= 1;
-                }
-            }
-        }
-
-        return crc;
+        return CRC16::calculate(buf, len);
     }
 
     static uint16_t nextPacketId() {
@@ -698,8 +683,38 @@ public:
     }
 };
 
+static inline
+ERaModbusRequest* ERaModbusReadRequest(const uint8_t transp, const ModbusConfig_t& param) {
+    uint16_t addr = BUILD_WORD(param.sa1, param.sa2);
+    uint16_t len = BUILD_WORD(param.len1, param.len2);
+    switch (param.func) {
+        case ModbusFunctionT::READ_COIL_STATUS:
+            return new_modbus ERaModbusRequest01(transp, param.addr, addr, len);
+        case ModbusFunctionT::READ_INPUT_STATUS:
+            return new_modbus ERaModbusRequest02(transp, param.addr, addr, len);
+        case ModbusFunctionT::READ_HOLDING_REGISTERS:
+            return new_modbus ERaModbusRequest03(transp, param.addr, addr, len);
+        case ModbusFunctionT::READ_INPUT_REGISTERS:
+            return new_modbus ERaModbusRequest04(transp, param.addr, addr, len);
+        default:
+            return nullptr;
+    }
+}
+
 #include <Modbus/ERaModbusInternal.hpp>
 
+/* Largest frame ERaModbusMessage holds, reads are sized to fit */
+#define MODBUS_TCP_FRAME_SIZE           255
+
+typedef struct __ModbusTransaction_t {
+    ERaModbusRequest* request;
+    ERaModbusResponse* response;
+    MillisTime_t startMillis;
+    MillisTime_t timeout; /* 0 is the modbus timeout */
+    bool done;
+    bool status;
+} ModbusTransaction_t;
+
 template <class Modbus>
 class ERaModbusTransp
     : public ERaModbusInternal
@@ -775,13 +790,102 @@ public:
             this->thisModbus().onData(request, response, skip);
         }
         else {
-            this->thisModbus().onError(request, skip);
+            this->thisModbus().onError(request, response, skip);
         }
         delete request;
         delete response;
         return status;
     }
 
+    /* Send every request before waiting, responses are matched by transaction ID */
+    void processReadPipeline(ModbusTransaction_t* trans, size_t count) {
+        size_t pending {0};
+        Stream* stream = this->thisModbus().stream;
+        if ((trans == nullptr) ||
+            (stream == NULL)) {
+            return;
+        }
+
+        /* Late answers of expired transactions */
+        while (stream->available()) {
+            stream->read();
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            trans[i].done = true;
+            trans[i].status = false;
+            if ((trans[i].request == nullptr) ||
+                (trans[i].response == nullptr)) {
+                continue;
+            }
+            this->thisModbus().updateTotalTransmit();
+            if (ERaModbusInternal::handlerRead(trans[i].request, trans[i].response, trans[i].status)) {
+                ERaLogHex("IB <<", trans[i].response->getMessage(), trans[i].response->getSize());
+                continue;
+            }
+            this->thisModbus().sendCommand(trans[i].request->getMessage(), trans[i].request->getSize());
+            trans[i].startMillis = ERaMillis();
+            if (!trans[i].timeout) {
+                trans[i].timeout = this->thisModbus().timeout;
+            }
+            trans[i].done = false;
+            pending++;
+        }
+
+        size_t position {0};
+        uint8_t frame[MODBUS_TCP_FRAME_SIZE] {0};
+
+        while (pending) {
+            if (!stream->available()) {
+#if defined(ERA_NO_RTOS)
+                this->thisModbus().runApi();
+#endif
+                if (ModbusState::is(ModbusStateT::STATE_MB_PARSE)) {
+                    break;
+                }
+                pending -= this->expireTransactions(trans, count);
+                if (pending) {
+                    ERA_MODBUS_YIELD();
+                }
+                continue;
+            }
+
+            do {
+                int c = stream->read();
+                if (c < 0) {
+                    continue;
+                }
+                frame[position++] = (uint8_t)c;
+                if (position < 7) {
+                    continue;
+                }
+                size_t frameLength = (6 + BUILD_WORD(frame[4], frame[5]));
+                if ((frameLength < 9) ||
+                    (frameLength > sizeof(frame))) {
+                    /* Lost framing, drop what is buffered */
+                    ERaLogHex("MB <<", frame, position);
+                    while (stream->available()) {
+                        stream->read();
+                    }
+                    position = 0;
+                    break;
+                }
+                if (position < frameLength) {
+                    continue;
+                }
+                ERaLogHex("MB <<", frame, position);
+                ModbusTransaction_t* tr = this->findTransaction(trans, count, BUILD_WORD(frame[0], frame[1]));
+                if (tr != nullptr) {
+                    tr->response->setData(frame, position);
+                    tr->status = tr->response->isSuccess();
+                    tr->done = true;
+                    pending--;
+                }
+                position = 0;
+            } while (pending && stream->available());
+        }
+    }
+
     bool processWrite(ERaModbusRequest* request) {
         bool status {false};
         ERA_ASSERT_NULL(request, false)
@@ -806,6 +910,33 @@ public:
     }
 
 private:
+    ModbusTransaction_t* findTransaction(ModbusTransaction_t* trans, size_t count, uint16_t packetId) {
+        for (size_t i = 0; i < count; ++i) {
+            if (trans[i].done) {
+                continue;
+            }
+            if (trans[i].request->getPacketId() == packetId) {
+                return &trans[i];
+            }
+        }
+        return nullptr;
+    }
+
+    size_t expireTransactions(ModbusTransaction_t* trans, size_t count) {
+        size_t expired {0};
+        for (size_t i = 0; i < count; ++i) {
+            if (trans[i].done) {
+                continue;
+            }
+            if (ERaRemainingTime(trans[i].startMillis, trans[i].timeout)) {
+                continue;
+            }
+            trans[i].done = true;
+            expired++;
+        }
+        return expired;
+    }
+
     inline
     const Modbus& thisModbus() const {
         return static_cast<const Modbus&>(*this);
@@ -56,6 +56,7 @@ typedef struct __ModbusConfig_t {
     uint8_t sizeData;
     uint32_t value;
     uint8_t ack;
+    uint8_t bus;
 } ModbusConfig_t;
 
 typedef struct __Action_t {
@@ -596,6 +597,8 @@ void ERaModbusEntry::actOneConfigSensorReadWrite(const int* ptr, size_t len, Mod
     config.sa2 = ptr[4];
     config.len1 = ptr[5];
     config.len2 = ptr[6];
+    /* Entries are reused across parses, the bus is routed again */
+    config.bus = 0;
 
     for (size_t i = 0; (i < len - 7) &&
         (i < sizeof(config.extra)); ++i) {
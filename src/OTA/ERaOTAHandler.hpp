@@ -1,6 +1,7 @@
 #ifndef INC_ERA_OTA_HANDLER_HPP_
 #define INC_ERA_OTA_HANDLER_HPP_
 
+#include <Utility/CRC32.hpp>
 #include <Utility/ERaUtility.hpp>
 
 #if !defined(ERA_OTA_BUFFER_SIZE)
@@ -30,16 +31,7 @@ public:
 
 protected:
     uint32_t calcCRC32(const void* data, size_t length, uint32_t previousCrc32 = 0) {
-        const uint32_t Polynomial = 0xEDB88320;
-        const uint8_t* ptr = (const uint8_t*)data;
-        uint32_t crc = ~previousCrc32;
-        while (length--) {
-            crc ^= *ptr++;
-            for (unsigned int j = 0; j < 8; j++) {
-                crc = ((crc >> 1) ^ (-int(crc & 1) & Polynomial));
-            }
-        }
-        return ~crc;
+        return CRC32::calculate(data, length, previousCrc32);
     }
 };
 
@@ -0,0 +1,36 @@
+#ifndef INC_CRC16_HPP_
+#define INC_CRC16_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* CRC-16/MODBUS: reflected 0x8005, initial 0xFFFF, no final xor */
+class CRC16
+{
+public:
+    CRC16();
+
+    void begin();
+    void reset();
+    void update(const uint8_t& data);
+    void update(const uint8_t* data, size_t size);
+
+    template <typename T>
+    void update(const T* data, size_t size) {
+        this->update((const uint8_t*)data, size * sizeof(T));
+    }
+
+    uint16_t finalize() const;
+
+    template <typename T>
+    static uint16_t calculate(const T* data, size_t size) {
+        CRC16 crc;
+        crc.update(data, size);
+        return crc.finalize();
+    }
+
+private:
+    uint16_t _state = 0xFFFF;
+};
+
+#endif /* INC_CRC16_HPP_ */
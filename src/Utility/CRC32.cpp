@@ -1,3 +1,4 @@
+#include <string.h>
 #include <Utility/CRC32.hpp>
 
 #if defined(__AVR__) || \
@@ -5,6 +6,22 @@
     #include <avr/pgmspace.h>
 #endif
 
+/* 8 KB of tables, only where RAM is plenty */
+#if !defined(ERA_CRC32_SLICE_BY_8) &&   \
+    (defined(LINUX) || defined(ESP32))
+    #define ERA_CRC32_SLICE_BY_8
+#endif
+
+#if defined(ERA_CRC32_SLICE_BY_8) &&    \
+    defined(LINUX) &&                   \
+    defined(__aarch64__) &&             \
+    defined(__GNUC__) && !defined(__clang__)
+    #define ERA_CRC32_ARMV8
+    #include <sys/auxv.h>
+    #include <asm/hwcap.h>
+    #include <arm_acle.h>
+#endif
+
 #if defined(PROGMEM)
     #define CRC_PROGMEM PROGMEM
     #define CRC_READ_DWORD(x) (pgm_read_dword_near(x))
@@ -13,6 +30,102 @@
     #define CRC_READ_DWORD(x) (*(uint32_t*)(x))
 #endif
 
+#if defined(ERA_CRC32_SLICE_BY_8)
+
+typedef uint32_t (*CRC32Fn_t)(uint32_t state, const uint8_t* data, size_t size);
+
+typedef struct __CRC32Table_t {
+    uint32_t data[8][256];
+
+    __CRC32Table_t() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int j = 0; j < 8; ++j) {
+                crc = ((crc >> 1) ^ ((crc & 1) ? 0xedb88320 : 0));
+            }
+            this->data[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int k = 1; k < 8; ++k) {
+                uint32_t prev = this->data[k - 1][i];
+                this->data[k][i] = ((prev >> 8) ^ this->data[0][prev & 0xff]);
+            }
+        }
+    }
+} CRC32Table_t;
+
+static const CRC32Table_t& crc32Table() {
+    static const CRC32Table_t table;
+    return table;
+}
+
+static uint32_t crc32SliceBy8(uint32_t state, const uint8_t* data, size_t size) {
+    const CRC32Table_t& table = crc32Table();
+    const uint32_t (*t)[256] = table.data;
+
+#if defined(__BYTE_ORDER__) &&  \
+    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    while (size >= 8) {
+        uint32_t one {0};
+        uint32_t two {0};
+        memcpy(&one, data, sizeof(one));
+        memcpy(&two, data + 4, sizeof(two));
+        one ^= state;
+        state = t[7][one & 0xff] ^ t[6][(one >> 8) & 0xff] ^
+                t[5][(one >> 16) & 0xff] ^ t[4][one >> 24] ^
+                t[3][two & 0xff] ^ t[2][(two >> 8) & 0xff] ^
+                t[1][(two >> 16) & 0xff] ^ t[0][two >> 24];
+        data += 8;
+        size -= 8;
+    }
+#endif
+
+    while (size--) {
+        state = (t[0][(state ^ *data++) & 0xff] ^ (state >> 8));
+    }
+    return state;
+}
+
+#if defined(ERA_CRC32_ARMV8)
+
+/* The ARMv8 CRC32 instructions use the same polynomial */
+__attribute__((target("+crc")))
+static uint32_t crc32Armv8(uint32_t state, const uint8_t* data, size_t size) {
+    while (size && ((uintptr_t)data & 7)) {
+        state = __crc32b(state, *data++);
+        size--;
+    }
+    while (size >= 8) {
+        uint64_t value {0};
+        memcpy(&value, data, sizeof(value));
+        state = __crc32d(state, value);
+        data += 8;
+        size -= 8;
+    }
+    while (size--) {
+        state = __crc32b(state, *data++);
+    }
+    return state;
+}
+
+#endif
+
+static CRC32Fn_t crc32Select() {
+#if defined(ERA_CRC32_ARMV8)
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32) {
+        return crc32Armv8;
+    }
+#endif
+    return crc32SliceBy8;
+}
+
+static CRC32Fn_t crc32Fn() {
+    static const CRC32Fn_t fn = crc32Select();
+    return fn;
+}
+
+#else
+
 static const uint32_t crc32_table[] CRC_PROGMEM = {
     0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
     0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
@@ -20,6 +133,8 @@ static const uint32_t crc32_table[] CRC_PROGMEM = {
     0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
 };
 
+#endif
+
 CRC32::CRC32() {
     reset();
 }
@@ -33,12 +148,26 @@ void CRC32::reset() {
 }
 
 void CRC32::update(const uint8_t& data) {
+#if defined(ERA_CRC32_SLICE_BY_8)
+    _state = crc32Table().data[0][(_state ^ data) & 0xff] ^ (_state >> 8);
+#else
     uint8_t tbl_idx = 0;
 
     tbl_idx = _state ^ (data >> (0 * 4));
     _state = CRC_READ_DWORD(crc32_table + (tbl_idx & 0x0f)) ^ (_state >> 4);
     tbl_idx = _state ^ (data >> (1 * 4));
     _state = CRC_READ_DWORD(crc32_table + (tbl_idx & 0x0f)) ^ (_state >> 4);
+#endif
+}
+
+void CRC32::update(const uint8_t* data, size_t size) {
+#if defined(ERA_CRC32_SLICE_BY_8)
+    _state = crc32Fn()(_state, data, size);
+#else
+    for (size_t i = 0; i < size; ++i) {
+        this->update(data[i]);
+    }
+#endif
 }
 
 uint32_t CRC32::finalize() const {
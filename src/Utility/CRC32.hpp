@@ -18,14 +18,11 @@ public:
         this->update(&data, 1);
     }
 
+    void update(const uint8_t* data, size_t size);
+
     template <typename T>
     void update(const T* data, size_t size) {
-        size_t nBytes = size * sizeof(T);
-        const uint8_t* pData = (const uint8_t*)data;
-
-        for (size_t i = 0; i < nBytes; ++i) {
-            this->update(pData[i]);
-        }
+        this->update((const uint8_t*)data, size * sizeof(T));
     }
 
     size_t update(uint32_t start, uint32_t end, uint8_t byte) {
@@ -49,6 +46,14 @@ public:
         return crc.finalize();
     }
 
+    /* Continue a finalized CRC over more data */
+    static uint32_t calculate(const void* data, size_t size, uint32_t previous) {
+        CRC32 crc;
+        crc._state = ~previous;
+        crc.update((const uint8_t*)data, size);
+        return crc.finalize();
+    }
+
 private:
     uint32_t _state = ~0L;
 };
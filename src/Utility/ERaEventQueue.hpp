@@ -0,0 +1,172 @@
+#ifndef INC_ERA_EVENT_QUEUE_HPP_
+#define INC_ERA_EVENT_QUEUE_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <ERa/ERaDefine.hpp>
+
+#define ERA_ATOMIC_LOAD(ptr)            __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define ERA_ATOMIC_STORE(ptr, val)      __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define ERA_ATOMIC_ADD(ptr, val)        __atomic_add_fetch(ptr, val, __ATOMIC_RELAXED)
+#define ERA_ATOMIC_CAS(ptr, exp, val)   __atomic_compare_exchange_n(ptr, exp, val, true,    \
+                                                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)
+
+/* Bounded lock-free ring (sequence per cell), safe for many producers.
+ * pop() may also be called by producers to drop the oldest entry.
+ * The depth is rounded up to a power of two.
+ */
+template <class T, size_t N>
+class ERaEventQueue
+{
+    static constexpr size_t roundUp(size_t value, size_t power = 2) {
+        return ((power >= value) ? power : roundUp(value, (power << 1)));
+    }
+
+    const static size_t Size = roundUp(N);
+    const static size_t Mask = (Size - 1);
+
+    typedef struct __Cell_t {
+        size_t sequence;
+        T data;
+    } Cell_t;
+
+public:
+    ERaEventQueue()
+        : head(0)
+        , tail(0)
+        , dropped(0)
+        , coalesced(0)
+        , highWater(0)
+    {
+        for (size_t i = 0; i < Size; ++i) {
+            this->cells[i].sequence = i;
+        }
+    }
+    ~ERaEventQueue()
+    {}
+
+    bool push(const T& value) {
+        Cell_t* cell = nullptr;
+        size_t pos = __atomic_load_n(&this->tail, __ATOMIC_RELAXED);
+        for (;;) {
+            cell = &this->cells[pos & Mask];
+            size_t seq = ERA_ATOMIC_LOAD(&cell->sequence);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (ERA_ATOMIC_CAS(&this->tail, &pos, pos + 1)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = __atomic_load_n(&this->tail, __ATOMIC_RELAXED);
+            }
+        }
+        cell->data = value;
+        ERA_ATOMIC_STORE(&cell->sequence, pos + 1);
+        this->updateHighWater(pos + 1);
+        return true;
+    }
+
+    bool pop(T& value) {
+        Cell_t* cell = nullptr;
+        size_t pos = __atomic_load_n(&this->head, __ATOMIC_RELAXED);
+        for (;;) {
+            cell = &this->cells[pos & Mask];
+            size_t seq = ERA_ATOMIC_LOAD(&cell->sequence);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (ERA_ATOMIC_CAS(&this->head, &pos, pos + 1)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = __atomic_load_n(&this->head, __ATOMIC_RELAXED);
+            }
+        }
+        value = cell->data;
+        ERA_ATOMIC_STORE(&cell->sequence, pos + Mask + 1);
+        return true;
+    }
+
+    /* Best effort scan of the queued entries */
+    template <typename Predicate>
+    bool find(Predicate predicate) const {
+        size_t pos = ERA_ATOMIC_LOAD(&this->head);
+        size_t end = ERA_ATOMIC_LOAD(&this->tail);
+        for (; pos != end; ++pos) {
+            const Cell_t* cell = &this->cells[pos & Mask];
+            if (ERA_ATOMIC_LOAD(&cell->sequence) != (pos + 1)) {
+                continue;
+            }
+            if (predicate(cell->data)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t size() const {
+        size_t _head = ERA_ATOMIC_LOAD(&this->head);
+        size_t _tail = ERA_ATOMIC_LOAD(&this->tail);
+        return ((_tail > _head) ? (_tail - _head) : 0);
+    }
+
+    size_t capacity() const {
+        return Size;
+    }
+
+    bool readable() const {
+        return (this->size() > 0);
+    }
+
+    bool isEmpty() const {
+        return !this->readable();
+    }
+
+    void markDropped() {
+        ERA_ATOMIC_ADD(&this->dropped, 1);
+    }
+
+    void markCoalesced() {
+        ERA_ATOMIC_ADD(&this->coalesced, 1);
+    }
+
+    size_t getDropped() const {
+        return ERA_ATOMIC_LOAD(&this->dropped);
+    }
+
+    size_t getCoalesced() const {
+        return ERA_ATOMIC_LOAD(&this->coalesced);
+    }
+
+    size_t getHighWater() const {
+        return ERA_ATOMIC_LOAD(&this->highWater);
+    }
+
+protected:
+private:
+    void updateHighWater(size_t pos) {
+        size_t used = (pos - ERA_ATOMIC_LOAD(&this->head));
+        size_t peak = __atomic_load_n(&this->highWater, __ATOMIC_RELAXED);
+        while ((used > peak) && (used <= Size)) {
+            if (ERA_ATOMIC_CAS(&this->highWater, &peak, used)) {
+                break;
+            }
+        }
+    }
+
+    Cell_t cells[Size];
+    size_t head;
+    size_t tail;
+    size_t dropped;
+    size_t coalesced;
+    size_t highWater;
+};
+
+#endif /* INC_ERA_EVENT_QUEUE_HPP_ */
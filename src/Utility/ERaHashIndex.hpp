@@ -0,0 +1,231 @@
+#ifndef INC_ERA_HASH_INDEX_HPP_
+#define INC_ERA_HASH_INDEX_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <ERa/ERaDefine.hpp>
+#include <Utility/ERaLoc.hpp>
+
+#define ERA_HASH_INDEX_MIN_SIZE     16
+
+/* Open-addressing (linear probing) index of entries owned elsewhere.
+ * K is a 32/64-bit integer or a 'const char*' that must stay valid while indexed.
+ */
+template <class K, class T>
+class ERaHashIndex
+{
+    typedef struct __Slot_t {
+        K key;
+        T* value;
+        uint32_t hash;
+        uint8_t state;
+    } Slot_t;
+
+    enum SlotStateT
+        : uint8_t {
+        SLOT_EMPTY = 0x00,
+        SLOT_USED = 0x01,
+        SLOT_DELETED = 0x02
+    };
+
+public:
+    ERaHashIndex()
+        : slots(nullptr)
+        , capacity(0)
+        , count(0)
+        , deleted(0)
+    {}
+    ~ERaHashIndex()
+    {
+        ERA_FREE(this->slots);
+        this->slots = nullptr;
+    }
+
+    /* Insert or replace the entry of key */
+    bool put(K key, T* value) {
+        if (value == nullptr) {
+            return false;
+        }
+        if (!this->reserve(this->count + this->deleted + 1)) {
+            return false;
+        }
+        uint32_t hash = ERaHashIndex::hashOf(key);
+        Slot_t* slot = this->lookup(key, hash);
+        if (slot != nullptr) {
+            slot->value = value;
+            return true;
+        }
+        this->insert(key, value, hash);
+        return true;
+    }
+
+    T* get(K key) const {
+        if (!this->count) {
+            return nullptr;
+        }
+        Slot_t* slot = this->lookup(key, ERaHashIndex::hashOf(key));
+        return ((slot != nullptr) ? slot->value : nullptr);
+    }
+
+    /* Remove the entry of key, only if it still maps to value */
+    bool remove(K key, const T* value = nullptr) {
+        if (!this->count) {
+            return false;
+        }
+        Slot_t* slot = this->lookup(key, ERaHashIndex::hashOf(key));
+        if (slot == nullptr) {
+            return false;
+        }
+        if ((value != nullptr) && (slot->value != value)) {
+            return false;
+        }
+        slot->state = SlotStateT::SLOT_DELETED;
+        slot->value = nullptr;
+        this->count--;
+        this->deleted++;
+        return true;
+    }
+
+    void clear() {
+        if (this->slots != nullptr) {
+            memset((void*)this->slots, 0, this->capacity * sizeof(Slot_t));
+        }
+        this->count = 0;
+        this->deleted = 0;
+    }
+
+    size_t size() const {
+        return this->count;
+    }
+
+    /* Free the slots, the index stays usable */
+    void release() {
+        ERA_FREE(this->slots);
+        this->slots = nullptr;
+        this->capacity = 0;
+        this->count = 0;
+        this->deleted = 0;
+    }
+
+protected:
+private:
+    ERaHashIndex(const ERaHashIndex&);
+    ERaHashIndex& operator = (const ERaHashIndex&);
+
+    static uint32_t hashOf(uint32_t key) {
+        key ^= (key >> 16);
+        key *= 0x45D9F3BUL;
+        key ^= (key >> 16);
+        return key;
+    }
+
+    static uint32_t hashOf(uint64_t key) {
+        return ERaHashIndex::hashOf((uint32_t)(key ^ (key >> 32)));
+    }
+
+    static uint32_t hashOf(const char* key) {
+        /* FNV-1a */
+        uint32_t hash = 2166136261UL;
+        if (key == nullptr) {
+            return hash;
+        }
+        while (*key) {
+            hash ^= (uint8_t)(*key++);
+            hash *= 16777619UL;
+        }
+        return hash;
+    }
+
+    static bool equal(uint32_t a, uint32_t b) {
+        return (a == b);
+    }
+
+    static bool equal(uint64_t a, uint64_t b) {
+        return (a == b);
+    }
+
+    static bool equal(const char* a, const char* b) {
+        if (a == b) {
+            return true;
+        }
+        if ((a == nullptr) || (b == nullptr)) {
+            return false;
+        }
+        return !strcmp(a, b);
+    }
+
+    Slot_t* lookup(K key, uint32_t hash) const {
+        if (this->slots == nullptr) {
+            return nullptr;
+        }
+        size_t mask = (this->capacity - 1);
+        for (size_t i = (hash & mask), n = 0; n < this->capacity; i = ((i + 1) & mask), ++n) {
+            Slot_t* slot = &this->slots[i];
+            if (slot->state == SlotStateT::SLOT_EMPTY) {
+                break;
+            }
+            if ((slot->state == SlotStateT::SLOT_USED) &&
+                (slot->hash == hash) &&
+                ERaHashIndex::equal(slot->key, key)) {
+                return slot;
+            }
+        }
+        return nullptr;
+    }
+
+    void insert(K key, T* value, uint32_t hash) {
+        size_t mask = (this->capacity - 1);
+        size_t i = (hash & mask);
+        while (this->slots[i].state == SlotStateT::SLOT_USED) {
+            i = ((i + 1) & mask);
+        }
+        Slot_t* slot = &this->slots[i];
+        if (slot->state == SlotStateT::SLOT_DELETED) {
+            this->deleted--;
+        }
+        slot->key = key;
+        slot->value = value;
+        slot->hash = hash;
+        slot->state = SlotStateT::SLOT_USED;
+        this->count++;
+    }
+
+    /* Keep the load under 3/4, rehashing also drops deleted slots */
+    bool reserve(size_t size) {
+        if ((size * 4) <= (this->capacity * 3)) {
+            return true;
+        }
+        size_t newCapacity = ERA_HASH_INDEX_MIN_SIZE;
+        while ((newCapacity * 3) < ((this->count + 1) * 4)) {
+            newCapacity <<= 1;
+        }
+        if (newCapacity < this->capacity) {
+            newCapacity = this->capacity;
+        }
+        Slot_t* newSlots = (Slot_t*)ERA_CALLOC(newCapacity, sizeof(Slot_t));
+        if (newSlots == nullptr) {
+            return false;
+        }
+        Slot_t* oldSlots = this->slots;
+        size_t oldCapacity = this->capacity;
+        this->slots = newSlots;
+        this->capacity = newCapacity;
+        this->count = 0;
+        this->deleted = 0;
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldSlots[i].state == SlotStateT::SLOT_USED) {
+                this->insert(oldSlots[i].key, oldSlots[i].value, oldSlots[i].hash);
+            }
+        }
+        ERA_FREE(oldSlots);
+        return true;
+    }
+
+    Slot_t* slots;
+    size_t capacity;
+    size_t count;
+    size_t deleted;
+};
+
+#endif /* INC_ERA_HASH_INDEX_HPP_ */
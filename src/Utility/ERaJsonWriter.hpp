@@ -0,0 +1,254 @@
+#ifndef INC_ERA_JSON_WRITER_HPP_
+#define INC_ERA_JSON_WRITER_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <ERa/ERaDefine.hpp>
+#include <Utility/ERaLoc.hpp>
+#include <Utility/ERaUtility.hpp>
+#include <Utility/ERacJSON.hpp>
+
+/* Stack buffer used by the publish paths, larger payloads move to the heap */
+#if !defined(ERA_JSON_WRITER_SIZE)
+    #define ERA_JSON_WRITER_SIZE        256
+#endif
+
+#define ERA_JSON_WRITER_MAX_DEPTH       32
+
+/* Streaming JSON writer over a caller supplied buffer.
+ * Output matches cJSON_PrintUnformatted for the same items.
+ */
+class ERaJsonWriter
+{
+public:
+    ERaJsonWriter(char* _buffer, size_t _size, bool _grow = true)
+        : buffer(_buffer)
+        , size(_size)
+        , pos(0)
+        , depth(0)
+        , first(1)
+        , grow(_grow)
+        , heap(false)
+        , overflow(false)
+    {
+        this->terminate();
+    }
+    ~ERaJsonWriter()
+    {
+        if (this->heap) {
+            ERA_FREE(this->buffer);
+        }
+        this->buffer = nullptr;
+    }
+
+    ERaJsonWriter& beginObject(const char* name = nullptr) {
+        /* Deeper nesting cannot be closed correctly, fail the output */
+        if (this->depth >= ERA_JSON_WRITER_MAX_DEPTH) {
+            this->overflow = true;
+            return (*this);
+        }
+        this->key(name);
+        this->put('{');
+        this->depth++;
+        this->first |= ((uint64_t)1 << this->depth);
+        return (*this);
+    }
+
+    ERaJsonWriter& endObject() {
+        if (this->depth) {
+            this->first &= ~((uint64_t)1 << this->depth);
+            this->depth--;
+        }
+        this->put('}');
+        return (*this);
+    }
+
+    ERaJsonWriter& add(const char* name, const char* value) {
+        this->key(name);
+        if (value == nullptr) {
+            this->write("null");
+        }
+        else {
+            this->putString(value);
+        }
+        return (*this);
+    }
+
+    ERaJsonWriter& add(const char* name, bool value) {
+        this->key(name);
+        this->write(value ? "true" : "false");
+        return (*this);
+    }
+
+    ERaJsonWriter& add(const char* name, int value) {
+        return this->add(name, (double)value);
+    }
+
+    ERaJsonWriter& add(const char* name, double value) {
+        char number[26] {0};
+        cJSON_PrintNumber(number, sizeof(number), value);
+        this->key(name);
+        this->write(number);
+        return (*this);
+    }
+
+    ERaJsonWriter& add(const char* name, double value, int decimal) {
+        char number[26] {0};
+        cJSON_PrintNumberWithDecimal(number, sizeof(number), value, decimal);
+        this->key(name);
+        this->write(number);
+        return (*this);
+    }
+
+    ERaJsonWriter& addRaw(const char* name, const char* raw) {
+        this->key(name);
+        this->write((raw != nullptr) ? raw : "null");
+        return (*this);
+    }
+
+    const char* getString() const {
+        return this->buffer;
+    }
+
+    size_t length() const {
+        return this->pos;
+    }
+
+    /* The output did not fit, could not grow or nested too deep */
+    bool isOverflow() const {
+        return this->overflow;
+    }
+
+    operator const char* () const {
+        return this->getString();
+    }
+
+protected:
+private:
+    ERaJsonWriter(const ERaJsonWriter&);
+    ERaJsonWriter& operator = (const ERaJsonWriter&);
+
+    void key(const char* name) {
+        if (this->first & ((uint64_t)1 << this->depth)) {
+            this->first &= ~((uint64_t)1 << this->depth);
+        }
+        else {
+            this->put(',');
+        }
+        if (name == nullptr) {
+            return;
+        }
+        this->putString(name);
+        this->put(':');
+    }
+
+    void putString(const char* str) {
+        static const char hex[] = "0123456789abcdef";
+        this->put('\"');
+        for (; *str; ++str) {
+            uint8_t c = (uint8_t)(*str);
+            switch (c) {
+                case '\"':
+                    this->write("\\\"");
+                    break;
+                case '\\':
+                    this->write("\\\\");
+                    break;
+                case '\b':
+                    this->write("\\b");
+                    break;
+                case '\f':
+                    this->write("\\f");
+                    break;
+                case '\n':
+                    this->write("\\n");
+                    break;
+                case '\r':
+                    this->write("\\r");
+                    break;
+                case '\t':
+                    this->write("\\t");
+                    break;
+                default:
+                    if (c < 32) {
+                        this->write("\\u00");
+                        this->put(hex[c >> 4]);
+                        this->put(hex[c & 0x0F]);
+                    }
+                    else {
+                        this->put((char)c);
+                    }
+                    break;
+            }
+        }
+        this->put('\"');
+    }
+
+    void write(const char* str) {
+        size_t len = strlen(str);
+        if (!this->reserve(len)) {
+            return;
+        }
+        memcpy(this->buffer + this->pos, str, len);
+        this->pos += len;
+        this->terminate();
+    }
+
+    void put(char c) {
+        if (!this->reserve(1)) {
+            return;
+        }
+        this->buffer[this->pos++] = c;
+        this->terminate();
+    }
+
+    void terminate() {
+        if ((this->buffer != nullptr) && (this->pos < this->size)) {
+            this->buffer[this->pos] = '\0';
+        }
+    }
+
+    bool reserve(size_t len) {
+        if (this->overflow) {
+            return false;
+        }
+        if ((this->pos + len) < this->size) {
+            return true;
+        }
+        if (!this->grow) {
+            this->overflow = true;
+            return false;
+        }
+        size_t newSize = ERaMax((this->size * 2), (this->pos + len + 1));
+        char* newBuffer = nullptr;
+        if (this->heap) {
+            newBuffer = (char*)ERA_REALLOC(this->buffer, newSize);
+        }
+        else {
+            newBuffer = (char*)ERA_MALLOC(newSize);
+            if ((newBuffer != nullptr) && this->pos) {
+                memcpy(newBuffer, this->buffer, this->pos);
+            }
+        }
+        if (newBuffer == nullptr) {
+            this->overflow = true;
+            return false;
+        }
+        this->buffer = newBuffer;
+        this->size = newSize;
+        this->heap = true;
+        return true;
+    }
+
+    char* buffer;
+    size_t size;
+    size_t pos;
+    uint8_t depth;
+    uint64_t first;
+    bool grow;
+    bool heap;
+    bool overflow;
+};
+
+#endif /* INC_ERA_JSON_WRITER_HPP_ */
@@ -0,0 +1,200 @@
+#ifndef INC_ERA_SCHEDULER_HPP_
+#define INC_ERA_SCHEDULER_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <ERa/ERaDefine.hpp>
+#include <Utility/ERaLoc.hpp>
+#include <Utility/ERaUtility.hpp>
+
+/* Deadlines further away are clamped, entries are re-checked when they wake up */
+#define ERA_SCHEDULER_MAX_DELAY     0x3FFFFFFFUL
+#define ERA_SCHEDULER_MIN_SIZE      8
+
+/* Binary min-heap of entries ordered by deadline.
+ * T keeps its own position: 'unsigned long schedMillis' and 'size_t schedIndex'
+ * (0 when the entry is not scheduled).
+ */
+template <class T>
+class ERaScheduler
+{
+public:
+    ERaScheduler()
+        : heap(nullptr)
+        , count(0)
+        , capacity(0)
+    {}
+    ~ERaScheduler()
+    {
+        ERA_FREE(this->heap);
+        this->heap = nullptr;
+    }
+
+    /* Insert the entry or move it to the new deadline */
+    bool schedule(T* item, unsigned long deadline) {
+        if (item == nullptr) {
+            return false;
+        }
+        if (item->schedIndex) {
+            if (item->schedMillis == deadline) {
+                return true;
+            }
+            bool earlier = ERaScheduler::before(deadline, item->schedMillis);
+            item->schedMillis = deadline;
+            if (earlier) {
+                this->siftUp(item->schedIndex - 1);
+            }
+            else {
+                this->siftDown(item->schedIndex - 1);
+            }
+            return true;
+        }
+        if (!this->reserve(this->count + 1)) {
+            return false;
+        }
+        item->schedMillis = deadline;
+        this->heap[this->count] = item;
+        item->schedIndex = ++this->count;
+        this->siftUp(this->count - 1);
+        return true;
+    }
+
+    bool scheduleIn(T* item, unsigned long currentMillis, unsigned long delay) {
+        if (delay > ERA_SCHEDULER_MAX_DELAY) {
+            delay = ERA_SCHEDULER_MAX_DELAY;
+        }
+        return this->schedule(item, currentMillis + delay);
+    }
+
+    void cancel(T* item) {
+        if ((item == nullptr) || !item->schedIndex) {
+            return;
+        }
+        size_t index = item->schedIndex - 1;
+        item->schedIndex = 0;
+        if (index == --this->count) {
+            return;
+        }
+        T* last = this->heap[this->count];
+        this->heap[index] = last;
+        last->schedIndex = index + 1;
+        if ((index > 0) && ERaScheduler::before(last->schedMillis, this->heap[(index - 1) / 2]->schedMillis)) {
+            this->siftUp(index);
+        }
+        else {
+            this->siftDown(index);
+        }
+    }
+
+    /* Remove and return the earliest entry if it is due */
+    T* pop(unsigned long currentMillis) {
+        if (!this->count) {
+            return nullptr;
+        }
+        T* item = this->heap[0];
+        if (ERaScheduler::before(currentMillis, item->schedMillis)) {
+            return nullptr;
+        }
+        this->cancel(item);
+        return item;
+    }
+
+    /* Milliseconds until the earliest deadline, capped to maxDelay */
+    unsigned long remaining(unsigned long currentMillis, unsigned long maxDelay) const {
+        if (!this->count) {
+            return maxDelay;
+        }
+        unsigned long deadline = this->heap[0]->schedMillis;
+        if (!ERaScheduler::before(currentMillis, deadline)) {
+            return 0;
+        }
+        return ERaMin(deadline - currentMillis, maxDelay);
+    }
+
+    size_t size() const {
+        return this->count;
+    }
+
+    T* at(size_t index) const {
+        if (index >= this->count) {
+            return nullptr;
+        }
+        return this->heap[index];
+    }
+
+    void clear() {
+        for (size_t i = 0; i < this->count; ++i) {
+            this->heap[i]->schedIndex = 0;
+        }
+        this->count = 0;
+    }
+
+protected:
+private:
+    ERaScheduler(const ERaScheduler&);
+    ERaScheduler& operator = (const ERaScheduler&);
+
+    /* Wrap-safe, valid while deadlines stay within half the millis range */
+    static bool before(unsigned long a, unsigned long b) {
+        return ((long)(a - b) < 0);
+    }
+
+    bool reserve(size_t size) {
+        if (size <= this->capacity) {
+            return true;
+        }
+        size_t newCapacity = ERaMax(this->capacity * 2, (size_t)ERA_SCHEDULER_MIN_SIZE);
+        T** newHeap = (T**)ERA_REALLOC(this->heap, newCapacity * sizeof(T*));
+        if (newHeap == nullptr) {
+            return false;
+        }
+        this->heap = newHeap;
+        this->capacity = newCapacity;
+        return true;
+    }
+
+    void place(size_t index, T* item) {
+        this->heap[index] = item;
+        item->schedIndex = index + 1;
+    }
+
+    void siftUp(size_t index) {
+        T* item = this->heap[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!ERaScheduler::before(item->schedMillis, this->heap[parent]->schedMillis)) {
+                break;
+            }
+            this->place(index, this->heap[parent]);
+            index = parent;
+        }
+        this->place(index, item);
+    }
+
+    void siftDown(size_t index) {
+        T* item = this->heap[index];
+        for (;;) {
+            size_t child = (index * 2) + 1;
+            if (child >= this->count) {
+                break;
+            }
+            if (((child + 1) < this->count) &&
+                ERaScheduler::before(this->heap[child + 1]->schedMillis, this->heap[child]->schedMillis)) {
+                child++;
+            }
+            if (!ERaScheduler::before(this->heap[child]->schedMillis, item->schedMillis)) {
+                break;
+            }
+            this->place(index, this->heap[child]);
+            index = child;
+        }
+        this->place(index, item);
+    }
+
+    T** heap;
+    size_t count;
+    size_t capacity;
+};
+
+#endif /* INC_ERA_SCHEDULER_HPP_ */
@@ -1,6 +1,7 @@
 #include <new>
 #include <math.h>
 #include <float.h>
+#include <stdlib.h>
 #include <Utility/ERaUtility.hpp>
 
 #if defined(ARDUINO) && defined(__AVR__)
@@ -1207,6 +1208,248 @@ char* ERaDtostrf(double number, int decimal, char* str) {
     return str;
 }
 
+static const char ERaDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+size_t ERaUtoa(unsigned long long value, char* str) {
+    char buf[20];
+    char* ptr = buf + sizeof(buf);
+    /* Two digits per division, 32-bit math once the value fits */
+    while (value > 0xFFFFFFFFULL) {
+        unsigned int index = (unsigned int)(value % 100) * 2;
+        value /= 100;
+        *--ptr = ERaDigitPairs[index + 1];
+        *--ptr = ERaDigitPairs[index];
+    }
+    uint32_t small = (uint32_t)value;
+    while (small >= 100) {
+        unsigned int index = (small % 100) * 2;
+        small /= 100;
+        *--ptr = ERaDigitPairs[index + 1];
+        *--ptr = ERaDigitPairs[index];
+    }
+    if (small >= 10) {
+        *--ptr = ERaDigitPairs[small * 2 + 1];
+        *--ptr = ERaDigitPairs[small * 2];
+    }
+    else {
+        *--ptr = (char)('0' + small);
+    }
+    size_t len = (size_t)(buf + sizeof(buf) - ptr);
+    memcpy(str, ptr, len);
+    str[len] = '\0';
+    return len;
+}
+
+size_t ERaLltoa(long long value, char* str) {
+    if (value >= 0) {
+        return ERaUtoa((unsigned long long)value, str);
+    }
+    *str = '-';
+    return (ERaUtoa((0ULL - (unsigned long long)value), str + 1) + 1);
+}
+
+static size_t ERaCopyFormat(char* str, size_t size, const char* buf, size_t len) {
+    if ((str == nullptr) || !size) {
+        return len;
+    }
+    size_t copy = ERaMin(len, size - 1);
+    memcpy(str, buf, copy);
+    str[copy] = '\0';
+    return copy;
+}
+
+/* The fast paths need IEEE doubles evaluated without extra precision */
+#if (DBL_MANT_DIG == 53) && defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+    #define ERA_FAST_FORMAT
+#endif
+
+#if defined(ERA_FAST_FORMAT)
+
+static const double ERaPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+    1e21, 1e22
+};
+
+/* Round number * 10^exp10 to an integer the way printf does:
+ * on the exact product, ties to even. Fails above 2^53.
+ */
+static bool ERaScaleRound(double number, int exp10, uint64_t& result) {
+    if ((exp10 < 0) || (exp10 > 22)) {
+        return false;
+    }
+    double scale = ERaPow10[exp10];
+    double product = number * scale;
+    if (!(product < 9007199254740992.0)) {
+        return false;
+    }
+
+    /* Dekker's product, error is the exact remainder of the rounded product */
+    double split = 134217729.0 * number;
+    double numberHigh = split - (split - number);
+    double numberLow = number - numberHigh;
+    split = 134217729.0 * scale;
+    double scaleHigh = split - (split - scale);
+    double scaleLow = scale - scaleHigh;
+    double error = ((((numberHigh * scaleHigh) - product) + (numberHigh * scaleLow)) +
+                    (numberLow * scaleHigh)) + (numberLow * scaleLow);
+
+    double integer = floor(product);
+    double diff = (product - integer) - 0.5;
+    result = (uint64_t)integer;
+    if ((diff > 0.0) ||
+        ((diff == 0.0) && ((error > 0.0) || ((error == 0.0) && (result & 1))))) {
+        result++;
+    }
+    return true;
+}
+
+#endif
+
+/* Same output as "%.*f" */
+size_t ERaFormatFixed(char* str, size_t size, double number, int decimal) {
+#if defined(ERA_FAST_FORMAT)
+    uint64_t value {0};
+    if (!isnan(number) && !isinf(number) && (decimal >= 0) && (decimal <= 17) &&
+        ERaScaleRound(fabs(number), decimal, value)) {
+        char digits[21] {0};
+        char buf[40] {0};
+        size_t pos {0};
+        size_t count = ERaUtoa(value, digits);
+        if (signbit(number)) {
+            buf[pos++] = '-';
+        }
+        if (count <= (size_t)decimal) {
+            buf[pos++] = '0';
+        }
+        else {
+            memcpy(buf + pos, digits, count - decimal);
+            pos += (count - decimal);
+        }
+        if (decimal > 0) {
+            buf[pos++] = '.';
+            for (size_t i = count; i < (size_t)decimal; ++i) {
+                buf[pos++] = '0';
+            }
+            size_t fraction = ERaMin(count, (size_t)decimal);
+            memcpy(buf + pos, digits + count - fraction, fraction);
+            pos += fraction;
+        }
+        return ERaCopyFormat(str, size, buf, pos);
+    }
+#endif
+    int len = snprintf(str, size, "%.*f", decimal, number);
+    if (len < 0) {
+        return 0;
+    }
+    return ((str != nullptr) && size) ? ERaMin((size_t)len, size - 1) : (size_t)len;
+}
+
+/* Same output as "%.*g", parsed receives the value strtod reads back */
+size_t ERaFormatGeneral(char* str, size_t size, double number, int precision, double* parsed) {
+    if (!precision) {
+        precision = 1;
+    }
+#if defined(ERA_FAST_FORMAT)
+    if (!isnan(number) && !isinf(number) && (number != 0.0) &&
+        (precision > 0) && (precision <= 15)) {
+        double absolute = fabs(number);
+        int exp10 = (int)floor(log10(absolute));
+        uint64_t value {0};
+        uint64_t lower = (uint64_t)ERaPow10[precision - 1];
+        uint64_t upper = (uint64_t)ERaPow10[precision];
+        bool valid {false};
+        /* log10 may be off by one next to powers of ten */
+        for (int i = 0; i < 3; ++i) {
+            if (!ERaScaleRound(absolute, (precision - 1 - exp10), value)) {
+                break;
+            }
+            if (value >= upper) {
+                exp10++;
+            }
+            else if (value < lower) {
+                exp10--;
+            }
+            else {
+                valid = true;
+                break;
+            }
+        }
+        if (valid) {
+            char digits[21] {0};
+            char buf[40] {0};
+            size_t pos {0};
+            ERaUtoa(value, digits);
+            size_t count = (size_t)precision;
+            while ((count > 1) && (digits[count - 1] == '0')) {
+                count--;
+            }
+            if (signbit(number)) {
+                buf[pos++] = '-';
+            }
+            if ((exp10 < -4) || (exp10 >= precision)) {
+                buf[pos++] = digits[0];
+                if (count > 1) {
+                    buf[pos++] = '.';
+                    memcpy(buf + pos, digits + 1, count - 1);
+                    pos += (count - 1);
+                }
+                buf[pos++] = 'e';
+                buf[pos++] = ((exp10 < 0) ? '-' : '+');
+                unsigned int exponent = (unsigned int)((exp10 < 0) ? -exp10 : exp10);
+                if (exponent < 10) {
+                    buf[pos++] = '0';
+                }
+                pos += ERaUtoa(exponent, buf + pos);
+            }
+            else if (exp10 >= 0) {
+                size_t integer = (size_t)exp10 + 1;
+                memcpy(buf + pos, digits, integer);
+                pos += integer;
+                if (count > integer) {
+                    buf[pos++] = '.';
+                    memcpy(buf + pos, digits + integer, count - integer);
+                    pos += (count - integer);
+                }
+            }
+            else {
+                buf[pos++] = '0';
+                buf[pos++] = '.';
+                for (int i = -1; i > exp10; --i) {
+                    buf[pos++] = '0';
+                }
+                memcpy(buf + pos, digits, count);
+                pos += count;
+            }
+            if (parsed != nullptr) {
+                /* Exact operands, one rounding: same as strtod */
+                double result = (double)value / ERaPow10[precision - 1 - exp10];
+                *parsed = (signbit(number) ? -result : result);
+            }
+            return ERaCopyFormat(str, size, buf, pos);
+        }
+    }
+#endif
+    int len = snprintf(str, size, "%.*g", precision, number);
+    if (len < 0) {
+        return 0;
+    }
+    if ((parsed != nullptr) && (str != nullptr)) {
+        *parsed = strtod(str, nullptr);
+    }
+    return ((str != nullptr) && size) ? ERaMin((size_t)len, size - 1) : (size_t)len;
+}
+
 bool ERaFloatCompare(float a, float b) {
     float maxVal = (fabs(a) > fabs(b)) ? fabs(a) : fabs(b);
     return (fabs(a - b) <= (maxVal * FLT_EPSILON));
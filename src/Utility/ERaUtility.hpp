@@ -63,6 +63,10 @@ uint8_t SignalToPercentage(int16_t value);
 
 long long ERaAtoll(const char* str);
 char* ERaDtostrf(double number, int decimal, char* str);
+size_t ERaUtoa(unsigned long long value, char* str);
+size_t ERaLltoa(long long value, char* str);
+size_t ERaFormatFixed(char* str, size_t size, double number, int decimal);
+size_t ERaFormatGeneral(char* str, size_t size, double number, int precision, double* parsed = nullptr);
 
 template <typename T>
 inline
@@ -1,4 +1,6 @@
 #include <math.h>
+#include <float.h>
+#include <limits.h>
 #include <ctype.h>
 #include <Utility/ERacJSON.hpp>
 #include <Utility/ERaUtility.hpp>
@@ -131,13 +133,42 @@ CJSON_PUBLIC(cJSON*) cJSON_ParseWithLimit(const char* value, size_t limit) {
     return root;
 }
 
-CJSON_PUBLIC(cJSON*) cJSON_AddNumberWithDecimalToObject(cJSON* const object, const char* const name, const double number, int decimal) {
-    if (round(number) == number || decimal <= 0) {
-        return cJSON_AddNumberToObject(object, name, number);
+CJSON_PUBLIC(size_t) cJSON_PrintNumber(char* buffer, size_t size, const double number) {
+    int length {0};
+    char number_buffer[26] {0};
+    double test {0.0};
+
+    /* Same output as print_number */
+    if (isnan(number) || isinf(number)) {
+        length = snprintf(number_buffer, sizeof(number_buffer), "null");
+    }
+    else if ((number >= INT_MIN) && (number <= INT_MAX) &&
+            (number == (double)(int)number)) {
+        length = (int)ERaLltoa((int)number, number_buffer);
+    }
+    else {
+        length = (int)ERaFormatGeneral(number_buffer, sizeof(number_buffer), number, 15, &test);
+        if (!length ||
+            (fabs(test - number) > (ERaMax(fabs(test), fabs(number)) * DBL_EPSILON))) {
+            length = (int)ERaFormatGeneral(number_buffer, sizeof(number_buffer), number, 17);
+        }
+    }
+    if ((length < 0) || (length >= (int)sizeof(number_buffer))) {
+        return 0;
+    }
+    if ((buffer != NULL) && size) {
+        snprintf(buffer, size, "%s", number_buffer);
+    }
+    return (size_t)length;
+}
+
+CJSON_PUBLIC(size_t) cJSON_PrintNumberWithDecimal(char* buffer, size_t size, const double number, int decimal) {
+    if (isnan(number) || isinf(number) ||
+        round(number) == number || decimal <= 0) {
+        return cJSON_PrintNumber(buffer, size, number);
     }
 
     char number_buffer[26] {0};
-    char number_format[10] {0};
     unsigned int number_length {0};
     double n = number;
     long long d = (long long)number;
@@ -151,33 +182,32 @@ CJSON_PUBLIC(cJSON*) cJSON_AddNumberWithDecimalToObject(cJSON* const object, con
         n *= 10;
     }
 
-    snprintf(number_format, sizeof(number_format), "%%.%dg", decimal + number_length);
-    snprintf(number_buffer, sizeof(number_buffer), number_format, number);
-    return cJSON_AddRawNumberToObject(object, name, number_buffer);
+    size_t length = ERaFormatGeneral(number_buffer, sizeof(number_buffer), number, decimal + number_length);
+    if ((buffer != NULL) && size) {
+        snprintf(buffer, size, "%s", number_buffer);
+    }
+    return length;
 }
 
-CJSON_PUBLIC(cJSON*) cJSON_CreateNumberWithDecimalToObject(const double number, int decimal) {
-    if (round(number) == number || decimal <= 0) {
-        return cJSON_CreateNumber(number);
+CJSON_PUBLIC(cJSON*) cJSON_AddNumberWithDecimalToObject(cJSON* const object, const char* const name, const double number, int decimal) {
+    if (isnan(number) || isinf(number) ||
+        round(number) == number || decimal <= 0) {
+        return cJSON_AddNumberToObject(object, name, number);
     }
 
     char number_buffer[26] {0};
-    char number_format[10] {0};
-    unsigned int number_length {0};
-    double n = number;
-    long long d = (long long)number;
-
-    do {
-        ++number_length;
-        d /= 10;
-    } while (d);
+    cJSON_PrintNumberWithDecimal(number_buffer, sizeof(number_buffer), number, decimal);
+    return cJSON_AddRawNumberToObject(object, name, number_buffer);
+}
 
-    while (abs(n) < 1.f && --decimal) {
-        n *= 10;
+CJSON_PUBLIC(cJSON*) cJSON_CreateNumberWithDecimalToObject(const double number, int decimal) {
+    if (isnan(number) || isinf(number) ||
+        round(number) == number || decimal <= 0) {
+        return cJSON_CreateNumber(number);
     }
 
-    snprintf(number_format, sizeof(number_format), "%%.%dg", decimal + number_length);
-    snprintf(number_buffer, sizeof(number_buffer), number_format, number);
+    char number_buffer[26] {0};
+    cJSON_PrintNumberWithDecimal(number_buffer, sizeof(number_buffer), number, decimal);
     return cJSON_CreateRawNumber(number_buffer);
 }
 
@@ -17,6 +17,9 @@ CJSON_PUBLIC(cJSON*) cJSONUtils_GetPointer(cJSON* const object, const char* poin
 CJSON_PUBLIC(cJSON*) cJSONUtils_GetPointerCaseSensitive(cJSON* const object, const char* pointer);
 
 CJSON_PUBLIC(cJSON*) cJSON_ParseWithLimit(const char* value, size_t limit = MAX_CJSON_PARSE);
+/* Format a number as cJSON prints it, returns the length (buffer may be NULL) */
+CJSON_PUBLIC(size_t) cJSON_PrintNumber(char* buffer, size_t size, const double number);
+CJSON_PUBLIC(size_t) cJSON_PrintNumberWithDecimal(char* buffer, size_t size, const double number, int decimal);
 CJSON_PUBLIC(cJSON*) cJSON_AddNumberWithDecimalToObject(cJSON* const object, const char* const name, const double number, int decimal);
 CJSON_PUBLIC(cJSON*) cJSON_CreateNumberWithDecimalToObject(const double number, int decimal);
 CJSON_PUBLIC(cJSON*) cJSON_CreateUint8Array(const uint8_t* numbers, int count);
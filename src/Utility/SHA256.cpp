@@ -0,0 +1,122 @@
+#include <Utility/SHA256.hpp>
+
+#define SHA256_ROTR(x, n)   (((x) >> (n)) | ((x) << (32 - (n))))
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+void SHA256::begin() {
+    this->hash[0] = 0x6a09e667;
+    this->hash[1] = 0xbb67ae85;
+    this->hash[2] = 0x3c6ef372;
+    this->hash[3] = 0xa54ff53a;
+    this->hash[4] = 0x510e527f;
+    this->hash[5] = 0x9b05688c;
+    this->hash[6] = 0x1f83d9ab;
+    this->hash[7] = 0x5be0cd19;
+    this->length = 0;
+    this->used = 0;
+}
+
+void SHA256::update(const void* data, size_t size) {
+    const uint8_t* ptr = (const uint8_t*)data;
+    this->length += size;
+    if (this->used) {
+        size_t toCopy = (64 - this->used);
+        if (toCopy > size) {
+            toCopy = size;
+        }
+        memcpy(this->block + this->used, ptr, toCopy);
+        this->used += toCopy;
+        ptr += toCopy;
+        size -= toCopy;
+        if (this->used < 64) {
+            return;
+        }
+        this->transform(this->block);
+        this->used = 0;
+    }
+    while (size >= 64) {
+        this->transform(ptr);
+        ptr += 64;
+        size -= 64;
+    }
+    if (size) {
+        memcpy(this->block, ptr, size);
+        this->used = size;
+    }
+}
+
+char* SHA256::finalize() {
+    uint64_t bits = (this->length * 8);
+    uint8_t pad[72] {0};
+    size_t padLen = ((this->used < 56) ? (56 - this->used) : (120 - this->used));
+    pad[0] = 0x80;
+    for (int i = 0; i < 8; ++i) {
+        pad[padLen + i] = (uint8_t)(bits >> (56 - (i * 8)));
+    }
+    this->update(pad, padLen + 8);
+
+    static const char hexits[17] = "0123456789abcdef";
+    for (int i = 0; i < 32; ++i) {
+        uint8_t value = (uint8_t)(this->hash[i / 4] >> (24 - ((i % 4) * 8)));
+        this->state[i * 2] = hexits[value >> 4];
+        this->state[(i * 2) + 1] = hexits[value & 0x0F];
+    }
+    this->state[64] = '\0';
+    return this->state;
+}
+
+void SHA256::transform(const uint8_t* data) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = ((uint32_t)data[i * 4] << 24) | ((uint32_t)data[(i * 4) + 1] << 16) |
+               ((uint32_t)data[(i * 4) + 2] << 8) | (uint32_t)data[(i * 4) + 3];
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = SHA256_ROTR(w[i - 15], 7) ^ SHA256_ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = SHA256_ROTR(w[i - 2], 17) ^ SHA256_ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = this->hash[0];
+    uint32_t b = this->hash[1];
+    uint32_t c = this->hash[2];
+    uint32_t d = this->hash[3];
+    uint32_t e = this->hash[4];
+    uint32_t f = this->hash[5];
+    uint32_t g = this->hash[6];
+    uint32_t h = this->hash[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t s1 = SHA256_ROTR(e, 6) ^ SHA256_ROTR(e, 11) ^ SHA256_ROTR(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + sha256_k[i] + w[i];
+        uint32_t s0 = SHA256_ROTR(a, 2) ^ SHA256_ROTR(a, 13) ^ SHA256_ROTR(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    this->hash[0] += a;
+    this->hash[1] += b;
+    this->hash[2] += c;
+    this->hash[3] += d;
+    this->hash[4] += e;
+    this->hash[5] += f;
+    this->hash[6] += g;
+    this->hash[7] += h;
+}
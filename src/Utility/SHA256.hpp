@@ -0,0 +1,40 @@
+#ifndef INC_SHA256_HPP_
+#define INC_SHA256_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/* FIPS 180-4 SHA-256, hex digest like MD5 */
+class SHA256
+{
+public:
+    SHA256()
+        : length(0)
+        , used(0)
+    {
+        this->begin();
+    }
+    ~SHA256()
+    {}
+
+    void begin();
+    void update(const void* data, size_t size);
+
+    void update(const char* data) {
+        this->update(data, strlen(data));
+    }
+
+    char* finalize();
+
+private:
+    void transform(const uint8_t* block);
+
+    uint32_t hash[8];
+    uint64_t length;
+    uint8_t block[64];
+    size_t used;
+    char state[65];
+};
+
+#endif /* INC_SHA256_HPP_ */
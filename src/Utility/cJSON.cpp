@@ -58,6 +58,7 @@
 
 #include <ERa/ERaDefine.hpp>
 #include <Utility/cJSON.hpp>
+#include <Utility/ERaUtility.hpp>
 
 /* define our own boolean type */
 #ifdef true
@@ -794,18 +795,18 @@ static cJSON_bool print_number(const cJSON * const item, printbuffer * const out
     }
     else if(d == (double)item->valueint)
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        length = (int)ERaLltoa(item->valueint, (char*)number_buffer);
     }
     else
     {
         /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
+        length = (int)ERaFormatGeneral((char*)number_buffer, sizeof(number_buffer), d, 15, &test);
 
         /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        if ((length == 0) || !compare_double((double)test, d))
         {
             /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
+            length = (int)ERaFormatGeneral((char*)number_buffer, sizeof(number_buffer), d, 17);
         }
     }
 
@@ -45,12 +45,12 @@ private:
 
 template <class Zigbee>
 void ERaDBZigbee<Zigbee>::parseDevice(const cJSON* const root) {
-    if (this->coordinator->deviceCount >= MAX_DEVICE_ZIGBEE) {
+    IdentDeviceAddr_t* entry = this->coordinator->deviceIdent.add();
+    if (entry == nullptr) {
         return;
     }
 
-    IdentDeviceAddr_t& deviceInfo = coordinator->deviceIdent[coordinator->deviceCount++];
-
+    IdentDeviceAddr_t& deviceInfo = *entry;
     deviceInfo.isConnected = true;
     cJSON* typeItem = cJSON_GetObjectItem(root, "type");
     if (cJSON_IsNumber(typeItem)) {
@@ -58,11 +58,13 @@ void ERaDBZigbee<Zigbee>::parseDevice(const cJSON* const root) {
     }
     cJSON* nwkItem = cJSON_GetObjectItem(root, "nwk_addr");
     if (cJSON_IsNumber(nwkItem)) {
-        deviceInfo.address.addr.nwkAddr = nwkItem->valueint;
+        this->coordinator->deviceIdent.setNwkAddr(entry, nwkItem->valueint);
     }
     cJSON* ieeeItem = cJSON_GetObjectItem(root, "ieee_addr");
     if (cJSON_IsString(ieeeItem)) {
-        StringToIEEE(ieeeItem->valuestring, deviceInfo.address.addr.ieeeAddr);
+        uint8_t ieeeAddr[LENGTH_EXTADDR_IEEE] {0};
+        StringToIEEE(ieeeItem->valuestring, ieeeAddr);
+        this->coordinator->deviceIdent.setIEEEAddr(entry, ieeeAddr);
     }
     cJSON* appVerItem = cJSON_GetObjectItem(root, "app_ver");
     if (cJSON_IsNumber(appVerItem)) {
@@ -126,7 +128,7 @@ void ERaDBZigbee<Zigbee>::storeZigbeeDevice() {
     cJSON* item = nullptr;
     // Begin write to flash
     this->thisZigbee().beginWriteToFlash(FILENAME_DEVICES);
-    for (size_t i = 0; i < this->coordinator->deviceCount; ++i) {
+    for (size_t i = 0; i < this->coordinator->deviceIdent.size(); ++i) {
         item = this->createDevice(this->coordinator->deviceIdent[i]);
         ptr = cJSON_PrintUnformatted(item);
         cJSON_Delete(item);
@@ -144,9 +146,7 @@ void ERaDBZigbee<Zigbee>::storeZigbeeDevice() {
 
 template <class Zigbee>
 IdentDeviceAddr_t* ERaDBZigbee<Zigbee>::getDeviceFromCoordinator() {
-    IdentDeviceAddr_t* deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                    find_deviceWithIEEEAddr_t(this->device->address.addr.ieeeAddr));
-    return ((deviceInfo != std::end(this->coordinator->deviceIdent)) ? deviceInfo : nullptr);
+    return this->coordinator->deviceIdent.findIEEEAddr(this->device->address.addr.ieeeAddr);
 }
 
 template <class Zigbee>
@@ -156,19 +156,21 @@ IdentDeviceAddr_t* ERaDBZigbee<Zigbee>::setDeviceToCoordinator(bool final) {
     }
     IdentDeviceAddr_t* deviceInfo = this->getDeviceFromCoordinator();
     if (deviceInfo != nullptr) {
-        deviceInfo->address.addr.nwkAddr = this->device->address.addr.nwkAddr;
+        this->coordinator->deviceIdent.setNwkAddr(deviceInfo, this->device->address.addr.nwkAddr);
         if (!final) {
             return deviceInfo;
         }
     }
     else {
-        if ((this->coordinator->deviceCount >= MAX_DEVICE_ZIGBEE) ||
-            !strlen(this->device->modelName)) {
+        if (!strlen(this->device->modelName)) {
+            return nullptr;
+        }
+        deviceInfo = this->coordinator->deviceIdent.add();
+        if (deviceInfo == nullptr) {
             return nullptr;
         }
-        deviceInfo = &this->coordinator->deviceIdent[this->coordinator->deviceCount++];
-        deviceInfo->address.addr.nwkAddr = this->device->address.addr.nwkAddr;
-        CopyArray(this->device->address.addr.ieeeAddr, deviceInfo->address.addr.ieeeAddr);
+        this->coordinator->deviceIdent.setNwkAddr(deviceInfo, this->device->address.addr.nwkAddr);
+        this->coordinator->deviceIdent.setIEEEAddr(deviceInfo, this->device->address.addr.ieeeAddr);
     }
     deviceInfo->typeDevice = this->device->typeDevice;
     deviceInfo->appVer = this->device->appVer;
@@ -184,14 +186,10 @@ IdentDeviceAddr_t* ERaDBZigbee<Zigbee>::setDeviceToCoordinator(bool final) {
 
 template <class Zigbee>
 void ERaDBZigbee<Zigbee>::checkDevice() {
-    if (!this->coordinator->deviceCount) {
-        return;
-    }
-    for (int i = this->coordinator->deviceCount - 1; i >= 0; --i) {
+    for (size_t i = this->coordinator->deviceIdent.size(); i-- > 0;) {
         if (IsZeroArray(this->coordinator->deviceIdent[i].address.addr.ieeeAddr) ||
             !strlen(this->coordinator->deviceIdent[i].modelName)) {
-            std::move(std::begin(this->coordinator->deviceIdent) + i + 1, std::end(this->coordinator->deviceIdent), std::begin(this->coordinator->deviceIdent) + i);
-            this->coordinator->deviceCount--;
+            this->coordinator->deviceIdent.remove(i);
         }
     }
 }
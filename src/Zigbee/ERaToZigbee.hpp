@@ -6,6 +6,7 @@
 #include <Utility/ERaUtility.hpp>
 #include <Zigbee/ERaCommandZigbee.hpp>
 #include "definition/ERaDefineZigbee.hpp"
+#include "utility/ERaZnpRing.hpp"
 
 template <class Zigbee>
 class ERaToZigbee
@@ -96,9 +97,16 @@ private:
                                 bool force = false);
     uint8_t createFrameControl(HeaderZclFrame_t& zclHeader);
     void createZclHeader(vector<uint8_t>& payload, HeaderZclFrame_t& zclHeader, uint8_t _transIdZcl, uint8_t cmdId);
-    uint8_t getCheckSumCommand(const vector<uint8_t>& data);
     void sendByte(uint8_t byte);
-    void sendCommand(const vector<uint8_t>& data);
+    void sendCommand(const uint8_t* data, size_t size);
+
+#if defined(ERA_ZIGBEE_ASYNC_REQUEST)
+    /* Set by the caller's thread while its requests may complete later */
+    static bool& asyncRequest() {
+        static thread_local bool _asyncRequest {false};
+        return _asyncRequest;
+    }
+#endif
 
     inline
     const Zigbee& thisZigbee() const {
@@ -142,6 +150,9 @@ bool ERaToZigbee<Zigbee>::toZigbee(const cJSON* const root, AFAddrType_t& dstAdd
 
     cJSON* current = nullptr;
 
+#if defined(ERA_ZIGBEE_ASYNC_REQUEST)
+    ERaToZigbee::asyncRequest() = true;
+#endif
     for (current = root->child; current != nullptr && current->string != nullptr; current = current->next) {
         if (this->stateToZigbee(root, current, dstAddr, type)) {
             continue;
@@ -150,6 +161,9 @@ bool ERaToZigbee<Zigbee>::toZigbee(const cJSON* const root, AFAddrType_t& dstAdd
             continue;
         }
     }
+#if defined(ERA_ZIGBEE_ASYNC_REQUEST)
+    ERaToZigbee::asyncRequest() = false;
+#endif
 
     item = nullptr;
     current = nullptr;
@@ -187,20 +201,22 @@ bool ERaToZigbee<Zigbee>::findDeviceInfoWithIEEEAddr(AFAddrType_t& dstAddr) {
     if (CompareArray(dstAddr.addr.ieeeAddr, this->coordinator->address.addr.ieeeAddr)) {
         return false;
     }
-    IdentDeviceAddr_t* deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent), find_deviceWithIEEEAddr_t(dstAddr.addr.ieeeAddr));
-    if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
-        deviceInfo = &this->coordinator->deviceIdent[this->coordinator->deviceCount];
-        CopyArray(dstAddr.addr.ieeeAddr, deviceInfo->address.addr.ieeeAddr);
+    IdentDeviceAddr_t* deviceInfo = this->coordinator->deviceIdent.findIEEEAddr(dstAddr.addr.ieeeAddr);
+    if (deviceInfo == nullptr) {
+        deviceInfo = this->coordinator->deviceIdent.add();
+        if (deviceInfo == nullptr) {
+            return false;
+        }
+        this->coordinator->deviceIdent.setIEEEAddr(deviceInfo, dstAddr.addr.ieeeAddr);
         if (CommandZigbee::requestNwkAddrZstack(dstAddr, 0, 0) != ResultT::RESULT_SUCCESSFUL) {
-            ClearMem(deviceInfo, sizeof(IdentDeviceAddr_t));
+            this->coordinator->deviceIdent.remove(deviceInfo);
             return false;
         }
         if (!deviceInfo->address.addr.nwkAddr) {
-            ClearMem(deviceInfo, sizeof(IdentDeviceAddr_t));
+            this->coordinator->deviceIdent.remove(deviceInfo);
             return false;
         }
         /* Request model name */
-        this->coordinator->deviceCount++;
         /* Store */
     }
     dstAddr.addrMode = AddressModeT::ADDR_16BIT;
@@ -223,21 +239,41 @@ ResultT ERaToZigbee<Zigbee>::createCommandBuffer(const vector<uint8_t>& payload,
                                                 ClusterIDT zclId,
                                                 uint8_t* _transId,
                                                 uint8_t* _transIdZcl) {
-    vector<uint8_t> command;
-    uint8_t fcs {0};
+    if (payload.size() > ZNP_FRAME_MAX_DATA) {
+        return ResultT::RESULT_FAIL;
+    }
+
+    uint8_t command[ZNP_FRAME_MAX_LENGTH] {0};
+    size_t length {0};
     ResultT status {ResultT::RESULT_SUCCESSFUL};
-    command.push_back(this->thisZigbee().SOF);
-    command.push_back(payload.size());
-    command.push_back(((type << 5) & 0xE0) | (sub & 0x1F));
-    command.push_back(cmd);
-    command.insert(command.end(), payload.begin(), payload.end());
-    fcs = getCheckSumCommand(command);
-    command.push_back(fcs);
-
-    this->sendCommand(command);
-    status = this->waitResponse({nwkAddr, typeWait, (subWait == SubsystemT::RESERVED_INTER) ? sub : subWait,
-                                cmdWait, zclId, static_cast<uint8_t>(_transId != nullptr ? *_transId : 0x00),
-                                static_cast<uint8_t>(_transIdZcl != nullptr ? *_transIdZcl : 0x00), ZnpCommandStatusT::INVALID_PARAM, timeout}, value);
+    command[length++] = this->thisZigbee().SOF;
+    command[length++] = payload.size();
+    command[length++] = ((type << 5) & 0xE0) | (sub & 0x1F);
+    command[length++] = cmd;
+    if (!payload.empty()) {
+        memcpy(command + length, payload.data(), payload.size());
+        length += payload.size();
+    }
+    command[length] = ERaZnpChecksum(command, length + 1);
+    length++;
+
+    Response_t rspWait {nwkAddr, typeWait, (subWait == SubsystemT::RESERVED_INTER) ? sub : subWait,
+                        cmdWait, zclId, static_cast<uint8_t>(_transId != nullptr ? *_transId : 0x00),
+                        static_cast<uint8_t>(_transIdZcl != nullptr ? *_transIdZcl : 0x00), ZnpCommandStatusT::INVALID_PARAM, timeout};
+
+#if defined(ERA_ZIGBEE_ASYNC_REQUEST)
+    /* Registered before sending so a fast response cannot be missed.
+     * The final status is reported later to onRequestComplete.
+     */
+    if (ERaToZigbee::asyncRequest() && (value == nullptr) &&
+        this->thisZigbee().requests.add(rspWait, Zigbee::onRequestComplete, &this->thisZigbee())) {
+        this->sendCommand(command, length);
+        return ResultT::RESULT_PENDING;
+    }
+#endif
+
+    this->sendCommand(command, length);
+    status = this->waitResponse(rspWait, value);
 
     ERA_ZIGBEE_YIELD();
     return status;
@@ -374,15 +410,6 @@ void ERaToZigbee<Zigbee>::createZclHeader(vector<uint8_t>& payload, HeaderZclFra
     payload.push_back(cmdId);
 }
 
-template <class Zigbee>
-uint8_t ERaToZigbee<Zigbee>::getCheckSumCommand(const vector<uint8_t>& data) {
-    uint8_t crc {0};
-    for (auto i = data.begin() + 1; i != data.end(); ++i) {
-        crc = crc ^ *i;
-    }
-    return crc;
-}
-
 #include "toZigbee/ERaToBridge.hpp"
 #include "toZigbee/ERaToOnOff.hpp"
 #include "toZigbee/ERaToLevel.hpp"
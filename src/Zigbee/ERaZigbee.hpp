@@ -14,6 +14,8 @@
 #include <Zigbee/ERaFromZigbee.hpp>
 #include <Zigbee/ERaDBZigbee.hpp>
 #include "utility/ERaUtilityZigbee.hpp"
+#include "utility/ERaZnpRing.hpp"
+#include "utility/ERaZigbeeRequest.hpp"
 
 using namespace std;
 
@@ -83,6 +85,15 @@ public:
         this->stream = &_stream;
     }
 
+    /* Maximum number of devices kept by the coordinator */
+    bool setZigbeeDeviceLimit(size_t limit) {
+        InfoCoordinator_t* coord = InfoCoordinator_t::getInstance();
+        if (coord == nullptr) {
+            return false;
+        }
+        return coord->deviceIdent.setLimit(limit);
+    }
+
 protected:
     void begin() { 
         this->configZigbee();
@@ -159,6 +170,9 @@ protected:
 
     void runControl(bool forever = true) {
         for (;;) {
+#if defined(ERA_ZIGBEE_ASYNC_REQUEST)
+            this->requests.expire();
+#endif
             switch (ZigbeeState::get()) {
                 case ZigbeeStateT::STATE_ZB_DEVICE_INTERVIEWING:
                     this->timer.run();
@@ -222,6 +236,7 @@ private:
     void factoryResetZigbee();
     void handleZigbeeData();
     void handleDefaultResponse();
+    static void onRequestComplete(void* args, const Response_t& request, ResultT status);
     bool processZigbee(uint8_t* buffer,
                         int length,
                         int maxLength,
@@ -231,6 +246,13 @@ private:
                         uint8_t* cmdStatus = nullptr,
                         Response_t* rspWait = nullptr,
                         void* value = nullptr);
+    bool processZigbeeFrame(uint8_t* frame,
+                            uint8_t* cmdStatus = nullptr,
+                            Response_t* rspWait = nullptr,
+                            void* value = nullptr);
+#if defined(LINUX)
+    bool readZigbeeFrame(uint8_t(&frame)[ZNP_FRAME_MAX_LENGTH]);
+#endif
     bool interviewDevice();
     void removeDevice(const cJSON* const root, AFAddrType_t& dstAddr);
     void removeDeviceWithAddr(AFAddrType_t& dstAddr);
@@ -339,6 +361,9 @@ private:
 
     ERaQueue<ZigbeeAction_t, 20> queue;
     ERaQueue<Response_t, 20> queueRsp;
+#if defined(ERA_ZIGBEE_ASYNC_REQUEST)
+    ERaZigbeeRequest<ZIGBEE_MAX_PENDING_REQUEST> requests;
+#endif
     ERaQueue<DefaultRsp_t, 20> queueDefaultRsp;
     QueueMessage_t messageHandle;
     bool initialized;
@@ -352,6 +377,9 @@ private:
     InfoCoordinator_t*& coordinator;
     Stream* stream;
     ERaMutex_t mutexData;
+#if defined(LINUX)
+    ERaZnpRing<ZIGBEE_BUFFER_SIZE> rxRing;
+#endif
     TaskHandle_t _zigbeeTask;
     TaskHandle_t _controlZigbeeTask;
     TaskHandle_t _responseZigbeeTask;
@@ -405,6 +433,16 @@ void ERaZigbee<Api>::handleDefaultResponse() {
     }
 }
 
+template <class Api>
+void ERaZigbee<Api>::onRequestComplete(void* args, const Response_t& request, ResultT status) {
+    ERaZigbee* zigbee = static_cast<ERaZigbee*>(args);
+    if ((zigbee == nullptr) || (status == ResultT::RESULT_SUCCESSFUL)) {
+        return;
+    }
+    ERA_LOG(zigbee->TAG, ERA_PSTR("Request %d/%d to %d failed (%d)"), request.subSystem, request.command,
+                                                            request.nwkAddr, status);
+}
+
 template <class Api>
 bool ERaZigbee<Api>::processZigbee(uint8_t* buffer,
                                     int length,
@@ -418,7 +456,6 @@ bool ERaZigbee<Api>::processZigbee(uint8_t* buffer,
     if (!length) {
         return false;
     }
-    Response_t rsp {0};
     for (int i = 0; i < length; ++i) {
         uint8_t b = buffer[i];
 
@@ -442,33 +479,9 @@ bool ERaZigbee<Api>::processZigbee(uint8_t* buffer,
             continue;
         }
         if (index == zStackLength + this->MinMessageLength) {
-            if (payload[this->PositionSOF] == this->SOF) {
-                ERaLogHex("ZB <<", payload, index);
-                rsp = FromZigbee::fromZigbee(payload, value);
-                if (rsp.type != TypeT::ERR) {
-                    if (rspWait == nullptr) {
-                        // sync
-                        if (this->queueRsp.writeable()) {
-                            this->queueRsp += rsp;
-                        }
-                    }
-                    else {
-                        if (cmdStatus != nullptr) {
-                            if (CheckAFdata_t(rsp, *rspWait)) {
-                                *cmdStatus = rsp.cmdStatus;
-                            }
-                            if (CompareRsp_t(rsp, *rspWait)) {
-                                return true;
-                            }
-                            if (CheckRsp_t(rsp, *rspWait)) {
-                                // sync
-                                if (this->queueRsp.writeable()) {
-                                    this->queueRsp += rsp;
-                                }
-                            }
-                        }
-                    }
-                }
+            if ((payload[this->PositionSOF] == this->SOF) &&
+                this->processZigbeeFrame(payload, cmdStatus, rspWait, value)) {
+                return true;
             }
             index = 0;
             zStackLength = 0;
@@ -481,6 +494,44 @@ bool ERaZigbee<Api>::processZigbee(uint8_t* buffer,
     return false;
 }
 
+template <class Api>
+bool ERaZigbee<Api>::processZigbeeFrame(uint8_t* frame,
+                                        uint8_t* cmdStatus,
+                                        Response_t* rspWait,
+                                        void* value) {
+    ERaLogHex("ZB <<", frame, frame[this->PositionDataLength] + this->MinMessageLength);
+    Response_t rsp = FromZigbee::fromZigbee(frame, value);
+    if (rsp.type == TypeT::ERR) {
+        return false;
+    }
+#if defined(ERA_ZIGBEE_ASYNC_REQUEST)
+    if (this->requests.complete(rsp)) {
+        return false;
+    }
+#endif
+    if (rspWait == nullptr) {
+        // sync
+        if (this->queueRsp.writeable()) {
+            this->queueRsp += rsp;
+        }
+    }
+    else if (cmdStatus != nullptr) {
+        if (CheckAFdata_t(rsp, *rspWait)) {
+            *cmdStatus = rsp.cmdStatus;
+        }
+        if (CompareRsp_t(rsp, *rspWait)) {
+            return true;
+        }
+        if (CheckRsp_t(rsp, *rspWait)) {
+            // sync
+            if (this->queueRsp.writeable()) {
+                this->queueRsp += rsp;
+            }
+        }
+    }
+    return false;
+}
+
 template <class Api>
 cJSON* ERaZigbee<Api>::findDevicePayload(const char* topic) {
     if (topic == nullptr) {
@@ -489,9 +540,8 @@ cJSON* ERaZigbee<Api>::findDevicePayload(const char* topic) {
     if (this->coordinator == nullptr) {
         return nullptr;
     }
-    IdentDeviceAddr_t* deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                                find_devicePayloadWithTopic_t(topic));
-    if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+    IdentDeviceAddr_t* deviceInfo = this->coordinator->deviceIdent.find(find_devicePayloadWithTopic_t(topic));
+    if (deviceInfo == nullptr) {
         return nullptr;
     }
     return deviceInfo->data.payload;
@@ -499,8 +549,7 @@ cJSON* ERaZigbee<Api>::findDevicePayload(const char* topic) {
 
 template <class Api>
 void ERaZigbee<Api>::publishZigbeeData(const IdentDeviceAddr_t* deviceInfo, bool specific, bool retained) {
-    if ((deviceInfo == nullptr) ||
-        (deviceInfo == std::end(this->coordinator->deviceIdent))) {
+    if (deviceInfo == nullptr) {
         return;
     }
     if ((deviceInfo->data.topic == nullptr) ||
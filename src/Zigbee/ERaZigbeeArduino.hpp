@@ -177,14 +177,14 @@ void ERaToZigbee<Zigbee>::sendByte(uint8_t byte) {
 }
 
 template <class Zigbee>
-void ERaToZigbee<Zigbee>::sendCommand(const vector<uint8_t>& data) {
+void ERaToZigbee<Zigbee>::sendCommand(const uint8_t* data, size_t size) {
     if (this->thisZigbee().stream == NULL) {
         return;
     }
 
     ERaGuardLock(this->mutex);
-    ERaLogHex("ZB >>", data.data(), data.size());
-    this->thisZigbee().stream->write(data.data(), data.size());
+    ERaLogHex("ZB >>", data, size);
+    this->thisZigbee().stream->write(data, size);
     ERaGuardUnlock(this->mutex);
 }
 
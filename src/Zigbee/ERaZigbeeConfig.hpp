@@ -43,6 +43,16 @@
 
 #define ZIGBEE_BUFFER_SIZE      1024
 
+/* Control actions complete through the request table instead of blocking */
+#if !defined(ERA_ZIGBEE_NO_ASYNC_REQUEST) && \
+    (defined(LINUX) || defined(ESP32))
+    #define ERA_ZIGBEE_ASYNC_REQUEST
+#endif
+
+#if !defined(ZIGBEE_MAX_PENDING_REQUEST)
+    #define ZIGBEE_MAX_PENDING_REQUEST  16
+#endif
+
 #if !defined(ERA_ZIGBEE_YIELD)
     #if !defined(ERA_ZIGBEE_YIELD_MS)
         #define ERA_ZIGBEE_YIELD_MS 10
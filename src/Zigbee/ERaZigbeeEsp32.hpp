@@ -166,10 +166,10 @@ void ERaToZigbee<Zigbee>::sendByte(uint8_t byte) {
 }
 
 template <class Zigbee>
-void ERaToZigbee<Zigbee>::sendCommand(const vector<uint8_t>& data) {
+void ERaToZigbee<Zigbee>::sendCommand(const uint8_t* data, size_t size) {
     ERaGuardLock(this->mutex);
-    ERaLogHex("ZB >>", data.data(), data.size());
-    SEND_UART(UART_ZIGBEE, const_cast<uint8_t*>(data.data()), data.size());
+    ERaLogHex("ZB >>", data, size);
+    SEND_UART(UART_ZIGBEE, const_cast<uint8_t*>(data), size);
     WAIT_SEND_UART_DONE(UART_ZIGBEE);
     ERaGuardUnlock(this->mutex);
 }
@@ -289,7 +289,7 @@ void ERaZigbee<Api>::createInfoCoordinator() {
     cJSON_AddItemToObject(root, "network", netItem);
     cJSON_AddNumberToObject(root, "transmit_power", this->coordinator->transmitPower);
     cJSON_AddBoolToObject(root, "permit_join", this->coordinator->permitJoin.enable);
-    cJSON_AddNumberToObject(root, "device_count", this->coordinator->deviceCount);
+    cJSON_AddNumberToObject(root, "device_count", this->coordinator->deviceIdent.size());
 
     this->publishZigbeeData(TOPIC_ZIGBEE_BRIDGE_INFO, root);
 
@@ -179,31 +179,26 @@ void ERaZigbee<Api>::removeDeviceWithAddr(AFAddrType_t& dstAddr) {
     if (!dstAddr.addr.nwkAddr && IsZeroArray(dstAddr.addr.ieeeAddr)) {
         return;
     }
-    bool hasRemove {false};
-    IdentDeviceAddr_t* element = std::begin(this->coordinator->deviceIdent);
-    while (element != std::end(this->coordinator->deviceIdent)) {
-        if (!IsZeroArray(dstAddr.addr.ieeeAddr)) {
-            element = std::find_if(element, std::end(this->coordinator->deviceIdent), find_deviceWithIEEEAddr_t(dstAddr.addr.ieeeAddr));
-        }
-        else {
-            element = std::find_if(element, std::end(this->coordinator->deviceIdent), find_deviceWithNwkAddr_t(dstAddr.addr.nwkAddr));
-        }
-        if (element == std::end(this->coordinator->deviceIdent)) {
-            break;
-        }
-        hasRemove = true;
-        if (element->data.topic != nullptr) {
-            free(element->data.topic);
-            element->data.topic = nullptr;
-        }
-        if (element->data.payload != nullptr) {
-            free(element->data.payload);
-            element->data.payload = nullptr;
-        }
+    IdentDeviceAddr_t* element {nullptr};
+    if (!IsZeroArray(dstAddr.addr.ieeeAddr)) {
+        element = this->coordinator->deviceIdent.findIEEEAddr(dstAddr.addr.ieeeAddr);
+    }
+    else {
+        element = this->coordinator->deviceIdent.findNwkAddr(dstAddr.addr.nwkAddr);
+    }
+    if (element == nullptr) {
+        return;
+    }
+    if (element->data.topic != nullptr) {
+        free(element->data.topic);
+        element->data.topic = nullptr;
     }
-    if (hasRemove) {
-        DBZigbee::storeZigbeeDevice();
+    if (element->data.payload != nullptr) {
+        cJSON_Delete(element->data.payload);
+        element->data.payload = nullptr;
     }
+    this->coordinator->deviceIdent.remove(element);
+    DBZigbee::storeZigbeeDevice();
 }
 
 template <class Api>
@@ -364,7 +364,7 @@ void ERaCommandZigbee<ToZigbee>::removeAllDevice(bool rejoin, bool removeChildre
     option |= (removeChildren ? 0b10 : 0x00);
 
     vector<uint8_t> payload;
-    for (size_t i = 0; i < this->coordinator->deviceCount; ++i) {
+    for (size_t i = 0; i < this->coordinator->deviceIdent.size(); ++i) {
         if (!this->coordinator->deviceIdent[i].address.addr.nwkAddr) {
             continue;
         }
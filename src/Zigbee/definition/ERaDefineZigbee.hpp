@@ -22,10 +22,7 @@
 #include "define/utilZigbee.hpp"
 #include "define/zbZigbee.hpp"
 #include "define/zdoZigbee.hpp"
-
-#if !defined(MAX_DEVICE_ZIGBEE)
-    #define MAX_DEVICE_ZIGBEE           20
-#endif
+#include <Zigbee/utility/ERaDeviceTableZigbee.hpp>
 
 #if !defined(DISABLE_SCALE_ZIGBEE_DATA)
     #define ENABLE_SCALE_ZIGBEE_DATA
@@ -451,12 +448,15 @@ namespace ZigbeeNamespace {
             return __InfoCoordinator_t::instance();
         }
         void reset(__InfoCoordinator_t*& _instance = __InfoCoordinator_t::instance()) {
+            size_t limit = _instance->deviceIdent.getLimit();
             _instance->freeAllDevice();
+            _instance->deviceIdent.release();
             memset((void*)_instance, 0, sizeof(__InfoCoordinator_t));
             new(_instance) __InfoCoordinator_t();
+            _instance->deviceIdent.setLimit(limit);
         }
         void freeAllDevice() {
-            for (size_t i = 0; i < this->deviceCount; ++i) {
+            for (size_t i = 0; i < this->deviceIdent.size(); ++i) {
                 if (this->deviceIdent[i].data.topic != nullptr) {
                     free(this->deviceIdent[i].data.topic);
                     this->deviceIdent[i].data.topic = nullptr;
@@ -469,8 +469,7 @@ namespace ZigbeeNamespace {
         }
         void clearAllDevice() {
             this->freeAllDevice();
-            this->deviceCount = 0;
-            memset(this->deviceIdent, 0, sizeof(this->deviceIdent));
+            this->deviceIdent.clear();
         }
 
         bool lock;
@@ -493,8 +492,7 @@ namespace ZigbeeNamespace {
         uint8_t epTick;
         InfoEndpoint_t epList[20];
         uint16_t extGroup;
-        uint8_t deviceCount;
-        IdentDeviceAddr_t deviceIdent[MAX_DEVICE_ZIGBEE];
+        ERaDeviceTableZigbee<IdentDeviceAddr_t> deviceIdent;
         NwkKeyDesc_t activeKeyDesc;
         NwkKeyDesc_t alternKeyDesc;
         uint8_t apsExtPanId[LENGTH_EXTADDR_IEEE];
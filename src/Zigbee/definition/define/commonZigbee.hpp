@@ -173,7 +173,8 @@ namespace ZigbeeNamespace {
         RESULT_SUCCESSFUL = 0x00,
         RESULT_FAIL = 0x01,
         RESULT_TIMEOUT = 0x03,
-        RESULT_READ_DONE = 0x04
+        RESULT_READ_DONE = 0x04,
+        RESULT_PENDING = 0x05
     };
 
     enum ZnpCommandStatusT {
@@ -6,33 +6,30 @@
 template <class Zigbee>
 IdentDeviceAddr_t* ERaFromZigbee<Zigbee>::createDataGlobal(const DataAFMsg_t& afMsg, uint16_t attribute, uint8_t type, uint64_t& value) {
     bool defined {false};
-    IdentDeviceAddr_t* deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                                find_deviceWithNwkAddr_t(afMsg.srcAddr.addr.nwkAddr));
-    if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+    IdentDeviceAddr_t* deviceInfo = this->coordinator->deviceIdent.findNwkAddr(afMsg.srcAddr.addr.nwkAddr);
+    if (deviceInfo == nullptr) {
         if (ZigbeeState::is(ZigbeeStateT::STATE_ZB_INIT_MAX)) {
             return nullptr;
         }
         if (ZigbeeState::is(ZigbeeStateT::STATE_ZB_DEVICE_JOINED) ||
             ZigbeeState::is(ZigbeeStateT::STATE_ZB_DEVICE_INTERVIEWING)) {
             if (afMsg.srcAddr.addr.nwkAddr == this->device->address.addr.nwkAddr) {
-                deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                            find_deviceWithIEEEAddr_t(this->device->address.addr.ieeeAddr));
+                deviceInfo = this->coordinator->deviceIdent.findIEEEAddr(this->device->address.addr.ieeeAddr);
             }
-            if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+            if (deviceInfo == nullptr) {
                 return nullptr;
             }
         }
     }
-    if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+    if (deviceInfo == nullptr) {
         if (afMsg.zclId == ClusterIDT::ZCL_CLUSTER_GREEN_POWER) {
             return nullptr;
         }
         if (this->thisZigbee().Zigbee::ToZigbee::CommandZigbee::requestIEEEAddrZstack(const_cast<DataAFMsg_t&>(afMsg).srcAddr, 0, 0) != ResultT::RESULT_SUCCESSFUL) {
             return nullptr;
         }
-        deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                            find_deviceWithNwkAddr_t(afMsg.srcAddr.addr.nwkAddr));
-        if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+        deviceInfo = this->coordinator->deviceIdent.findNwkAddr(afMsg.srcAddr.addr.nwkAddr);
+        if (deviceInfo == nullptr) {
             return nullptr;
         }
     }
@@ -124,33 +121,30 @@ IdentDeviceAddr_t* ERaFromZigbee<Zigbee>::createDataGlobal(const DataAFMsg_t& af
 template <class Zigbee>
 IdentDeviceAddr_t* ERaFromZigbee<Zigbee>::createDataSpecific(const DataAFMsg_t& afMsg, DefaultRsp_t& defaultRsp) {
     bool defined {false};
-    IdentDeviceAddr_t* deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                                find_deviceWithNwkAddr_t(afMsg.srcAddr.addr.nwkAddr));
-    if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+    IdentDeviceAddr_t* deviceInfo = this->coordinator->deviceIdent.findNwkAddr(afMsg.srcAddr.addr.nwkAddr);
+    if (deviceInfo == nullptr) {
         if (ZigbeeState::is(ZigbeeStateT::STATE_ZB_INIT_MAX)) {
             return nullptr;
         }
         if (ZigbeeState::is(ZigbeeStateT::STATE_ZB_DEVICE_JOINED) ||
             ZigbeeState::is(ZigbeeStateT::STATE_ZB_DEVICE_INTERVIEWING)) {
             if (afMsg.srcAddr.addr.nwkAddr == this->device->address.addr.nwkAddr) {
-                deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                            find_deviceWithIEEEAddr_t(this->device->address.addr.ieeeAddr));
+                deviceInfo = this->coordinator->deviceIdent.findIEEEAddr(this->device->address.addr.ieeeAddr);
             }
-            if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+            if (deviceInfo == nullptr) {
                 return nullptr;
             }
         }
     }
-    if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+    if (deviceInfo == nullptr) {
         if (afMsg.zclId == ClusterIDT::ZCL_CLUSTER_GREEN_POWER) {
             return nullptr;
         }
         if (this->thisZigbee().Zigbee::ToZigbee::CommandZigbee::requestIEEEAddrZstack(const_cast<DataAFMsg_t&>(afMsg).srcAddr, 0, 0) != ResultT::RESULT_SUCCESSFUL) {
             return nullptr;
         }
-        deviceInfo = std::find_if(std::begin(this->coordinator->deviceIdent), std::end(this->coordinator->deviceIdent),
-                                            find_deviceWithNwkAddr_t(afMsg.srcAddr.addr.nwkAddr));
-        if (deviceInfo == std::end(this->coordinator->deviceIdent)) {
+        deviceInfo = this->coordinator->deviceIdent.findNwkAddr(afMsg.srcAddr.addr.nwkAddr);
+        if (deviceInfo == nullptr) {
             return nullptr;
         }
     }
@@ -227,6 +227,13 @@ void ERaFromZigbee<Zigbee>::processDeviceAnnounce(vector<uint8_t>& data, void* v
     this->device->annceDevice.type = static_cast<TypeAnnceDeviceT>((data.at(12) >> 1) & 0x01);
     this->device->annceDevice.power = static_cast<PowerSourceT>((data.at(12) >> 2) & 0x01);
     this->device->annceDevice.isIdle = static_cast<bool>((data.at(12) >> 3) & 0x01);
+    /* Rejoined with a new network address */
+    IdentDeviceAddr_t* deviceInfo = this->coordinator->deviceIdent.findIEEEAddr(this->device->annceDevice.dstAddr.addr.ieeeAddr);
+    if ((deviceInfo != nullptr) &&
+        (deviceInfo->address.addr.nwkAddr != this->device->annceDevice.dstAddr.addr.nwkAddr)) {
+        this->coordinator->deviceIdent.setNwkAddr(deviceInfo, this->device->annceDevice.dstAddr.addr.nwkAddr);
+        this->thisZigbee().Zigbee::DBZigbee::storeZigbeeDevice();
+    }
     if (this->device->annceDevice.type == TypeAnnceDeviceT::ANNCE_ENDDEVICE) {
         this->thisZigbee().Zigbee::ToZigbee::CommandZigbee::extRouterDiscovery(this->device->address,
                                     this->thisZigbee().Options, this->thisZigbee().Radius);
@@ -451,9 +458,8 @@ void ERaFromZigbee<Zigbee>::processDeviceInfo(vector<uint8_t>& data, void* value
             this->coordinator->address.endpoint = EndpointListT::ENDPOINT1;
             this->coordinator->deviceType = data.at(11);
             this->coordinator->states = static_cast<DevStatesT>(data.at(12));
-            this->coordinator->deviceCount = data.at(13);
-            for (int i = 0; i < this->coordinator->deviceCount; ++i) {
-                this->coordinator->deviceIdent[i].address.addr.nwkAddr = BUILD_UINT16(data.at(14 + 2*i));
+            for (size_t i = 0; (i < data.at(13)) && (i < this->coordinator->deviceIdent.size()); ++i) {
+                this->coordinator->deviceIdent.setNwkAddr(&this->coordinator->deviceIdent[i], BUILD_UINT16(data.at(14 + 2*i)));
             }
             break;
         default:
@@ -0,0 +1,231 @@
+#ifndef INC_ERA_DEVICE_TABLE_ZIGBEE_HPP_
+#define INC_ERA_DEVICE_TABLE_ZIGBEE_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <ERa/ERaDefine.hpp>
+#include <Utility/ERaHashIndex.hpp>
+
+#if !defined(MAX_DEVICE_ZIGBEE)
+    #define MAX_DEVICE_ZIGBEE           20
+#endif
+
+#if !defined(ZIGBEE_DEVICE_BLOCK_SIZE)
+    #define ZIGBEE_DEVICE_BLOCK_SIZE    16
+#endif
+
+/* Device table indexed by IEEE and network address.
+ * Entries live in fixed blocks allocated on demand, so they keep their
+ * address while the table grows. Addresses must be changed through
+ * setIEEEAddr()/setNwkAddr() to keep the indexes in sync.
+ */
+template <class T>
+class ERaDeviceTableZigbee
+{
+    const static size_t BlockSize = ZIGBEE_DEVICE_BLOCK_SIZE;
+    const static size_t IEEESize = 8;
+
+public:
+    ERaDeviceTableZigbee()
+        : blocks(nullptr)
+        , numBlocks(0)
+        , count(0)
+        , limit(MAX_DEVICE_ZIGBEE)
+    {}
+    ~ERaDeviceTableZigbee()
+    {
+        this->release();
+    }
+
+    T& operator [] (size_t index) {
+        return this->blocks[index / BlockSize][index % BlockSize];
+    }
+
+    const T& operator [] (size_t index) const {
+        return this->blocks[index / BlockSize][index % BlockSize];
+    }
+
+    size_t size() const {
+        return this->count;
+    }
+
+    size_t getLimit() const {
+        return this->limit;
+    }
+
+    /* Cannot shrink below the number of devices */
+    bool setLimit(size_t _limit) {
+        if (!_limit || (_limit < this->count)) {
+            return false;
+        }
+        size_t newBlocks = ((_limit + BlockSize - 1) / BlockSize);
+        if (newBlocks > this->numBlocks) {
+            T** ptr = (T**)ERA_REALLOC(this->blocks, newBlocks * sizeof(T*));
+            if (ptr == nullptr) {
+                return false;
+            }
+            memset((void*)(ptr + this->numBlocks), 0, (newBlocks - this->numBlocks) * sizeof(T*));
+            this->blocks = ptr;
+            this->numBlocks = newBlocks;
+        }
+        this->limit = _limit;
+        return true;
+    }
+
+    bool isFull() const {
+        return (this->count >= this->limit);
+    }
+
+    /* New zeroed entry, nullptr if the table is full */
+    T* add() {
+        if (this->isFull()) {
+            return nullptr;
+        }
+        if (!this->numBlocks && !this->setLimit(this->limit)) {
+            return nullptr;
+        }
+        size_t block = (this->count / BlockSize);
+        if (this->blocks[block] == nullptr) {
+            this->blocks[block] = (T*)ERA_CALLOC(BlockSize, sizeof(T));
+            if (this->blocks[block] == nullptr) {
+                return nullptr;
+            }
+        }
+        T* entry = &(*this)[this->count++];
+        memset((void*)entry, 0, sizeof(T));
+        return entry;
+    }
+
+    T* findIEEEAddr(const uint8_t* ieeeAddr) const {
+        uint64_t key = ERaDeviceTableZigbee::keyOf(ieeeAddr);
+        if (!key) {
+            return nullptr;
+        }
+        return this->ieeeIndex.get(key);
+    }
+
+    T* findNwkAddr(uint16_t nwkAddr) const {
+        if (!nwkAddr) {
+            return nullptr;
+        }
+        return this->nwkIndex.get(nwkAddr);
+    }
+
+    template <typename Predicate>
+    T* find(Predicate predicate) {
+        for (size_t i = 0; i < this->count; ++i) {
+            T& entry = (*this)[i];
+            if (predicate(entry)) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void setIEEEAddr(T* entry, const uint8_t* ieeeAddr) {
+        uint64_t key = ERaDeviceTableZigbee::keyOf(entry->address.addr.ieeeAddr);
+        if (key) {
+            this->ieeeIndex.remove(key, entry);
+        }
+        memcpy(entry->address.addr.ieeeAddr, ieeeAddr, IEEESize);
+        this->indexOf(entry);
+    }
+
+    void setNwkAddr(T* entry, uint16_t nwkAddr) {
+        if (entry->address.addr.nwkAddr == nwkAddr) {
+            return;
+        }
+        if (entry->address.addr.nwkAddr) {
+            this->nwkIndex.remove(entry->address.addr.nwkAddr, entry);
+        }
+        entry->address.addr.nwkAddr = nwkAddr;
+        this->indexOf(entry);
+    }
+
+    /* The last entry moves into the freed slot */
+    void remove(T* entry) {
+        for (size_t i = 0; i < this->count; ++i) {
+            if (&(*this)[i] == entry) {
+                this->remove(i);
+                return;
+            }
+        }
+    }
+
+    void remove(size_t index) {
+        if (index >= this->count) {
+            return;
+        }
+        T* entry = &(*this)[index];
+        this->unindexOf(entry);
+        T* last = &(*this)[--this->count];
+        if (last != entry) {
+            this->unindexOf(last);
+            memcpy((void*)entry, (const void*)last, sizeof(T));
+            this->indexOf(entry);
+        }
+        memset((void*)last, 0, sizeof(T));
+    }
+
+    void clear() {
+        for (size_t i = 0; i < this->count; ++i) {
+            memset((void*)&(*this)[i], 0, sizeof(T));
+        }
+        this->count = 0;
+        this->ieeeIndex.clear();
+        this->nwkIndex.clear();
+    }
+
+    void release() {
+        for (size_t i = 0; i < this->numBlocks; ++i) {
+            ERA_FREE(this->blocks[i]);
+        }
+        ERA_FREE(this->blocks);
+        this->blocks = nullptr;
+        this->numBlocks = 0;
+        this->count = 0;
+        this->ieeeIndex.release();
+        this->nwkIndex.release();
+    }
+
+protected:
+private:
+    ERaDeviceTableZigbee(const ERaDeviceTableZigbee&);
+    ERaDeviceTableZigbee& operator = (const ERaDeviceTableZigbee&);
+
+    static uint64_t keyOf(const uint8_t* ieeeAddr) {
+        uint64_t key {0};
+        memcpy(&key, ieeeAddr, IEEESize);
+        return key;
+    }
+
+    void indexOf(T* entry) {
+        uint64_t key = ERaDeviceTableZigbee::keyOf(entry->address.addr.ieeeAddr);
+        if (key) {
+            this->ieeeIndex.put(key, entry);
+        }
+        if (entry->address.addr.nwkAddr) {
+            this->nwkIndex.put(entry->address.addr.nwkAddr, entry);
+        }
+    }
+
+    void unindexOf(T* entry) {
+        uint64_t key = ERaDeviceTableZigbee::keyOf(entry->address.addr.ieeeAddr);
+        if (key) {
+            this->ieeeIndex.remove(key, entry);
+        }
+        if (entry->address.addr.nwkAddr) {
+            this->nwkIndex.remove(entry->address.addr.nwkAddr, entry);
+        }
+    }
+
+    T** blocks;
+    size_t numBlocks;
+    size_t count;
+    size_t limit;
+    ERaHashIndex<uint64_t, T> ieeeIndex;
+    ERaHashIndex<uint32_t, T> nwkIndex;
+};
+
+#endif /* INC_ERA_DEVICE_TABLE_ZIGBEE_HPP_ */
@@ -0,0 +1,151 @@
+#ifndef INC_ERA_ZIGBEE_REQUEST_HPP_
+#define INC_ERA_ZIGBEE_REQUEST_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Utility/ERaUtility.hpp>
+#include <Zigbee/definition/ERaDefineZigbee.hpp>
+
+/* Outstanding ZNP requests, matched by subsystem/command, transaction
+ * sequence number and network address (see CompareRsp_t).
+ * Completion callbacks run outside the lock, on the thread that received
+ * the response or swept the deadline.
+ */
+template <size_t N>
+class ERaZigbeeRequest
+{
+public:
+    typedef void (*RequestCallback_t)(void* args, const Response_t& request, ResultT status);
+
+private:
+    typedef struct __Request_t {
+        Response_t wait;
+        MillisTime_t startMillis;
+        RequestCallback_t callback;
+        void* args;
+        bool used;
+    } Request_t;
+
+public:
+    ERaZigbeeRequest()
+        : request {}
+        , count(0)
+        , mutex(NULL)
+    {}
+    ~ERaZigbeeRequest()
+    {}
+
+    /* Returns false when the table is full */
+    bool add(const Response_t& wait, RequestCallback_t callback, void* args) {
+        bool added {false};
+        ERaGuardLock(this->mutex);
+        for (size_t i = 0; i < N; ++i) {
+            Request_t& req = this->request[i];
+            if (req.used) {
+                continue;
+            }
+            req.wait = wait;
+            req.wait.cmdStatus = ZnpCommandStatusT::INVALID_PARAM;
+            if (!req.wait.timeout || (req.wait.timeout > MAX_TIMEOUT)) {
+                req.wait.timeout = MAX_TIMEOUT;
+            }
+            req.startMillis = ERaMillis();
+            req.callback = callback;
+            req.args = args;
+            req.used = true;
+            this->count++;
+            added = true;
+            break;
+        }
+        ERaGuardUnlock(this->mutex);
+        return added;
+    }
+
+    /* Returns true if rsp belongs to an outstanding request */
+    bool complete(const Response_t& rsp) {
+        if (!this->count) {
+            return false;
+        }
+        bool matched {false};
+        Request_t done {};
+        ERaGuardLock(this->mutex);
+        for (size_t i = 0; i < N; ++i) {
+            Request_t& req = this->request[i];
+            if (!req.used) {
+                continue;
+            }
+            if (CheckAFdata_t(rsp, req.wait)) {
+                req.wait.cmdStatus = rsp.cmdStatus;
+                matched = true;
+            }
+            if (CompareRsp_t(rsp, req.wait)) {
+                done = req;
+                this->release(req);
+                matched = true;
+                break;
+            }
+            if (matched) {
+                break;
+            }
+        }
+        ERaGuardUnlock(this->mutex);
+        if (done.used) {
+            this->notify(done, ResultT::RESULT_SUCCESSFUL);
+        }
+        return matched;
+    }
+
+    /* Time out requests past their deadline */
+    void expire() {
+        if (!this->count) {
+            return;
+        }
+        for (;;) {
+            Request_t done {};
+            ERaGuardLock(this->mutex);
+            for (size_t i = 0; i < N; ++i) {
+                Request_t& req = this->request[i];
+                if (!req.used) {
+                    continue;
+                }
+                if (ERaRemainingTime(req.startMillis, req.wait.timeout)) {
+                    continue;
+                }
+                done = req;
+                this->release(req);
+                break;
+            }
+            ERaGuardUnlock(this->mutex);
+            if (!done.used) {
+                break;
+            }
+            this->notify(done, ResultT::RESULT_TIMEOUT);
+        }
+    }
+
+    size_t size() const {
+        return this->count;
+    }
+
+protected:
+private:
+    void release(Request_t& req) {
+        req.used = false;
+        this->count--;
+    }
+
+    void notify(const Request_t& req, ResultT status) {
+        if (req.wait.cmdStatus != ZnpCommandStatusT::INVALID_PARAM) {
+            status = static_cast<ResultT>(req.wait.cmdStatus);
+        }
+        if (req.callback != nullptr) {
+            req.callback(req.args, req.wait, status);
+        }
+    }
+
+    Request_t request[N];
+    volatile size_t count;
+    ERaMutex_t mutex;
+};
+
+#endif /* INC_ERA_ZIGBEE_REQUEST_HPP_ */
@@ -0,0 +1,143 @@
+#ifndef INC_ERA_ZNP_RING_HPP_
+#define INC_ERA_ZNP_RING_HPP_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define ZNP_FRAME_SOF           0xFE
+#define ZNP_FRAME_OVERHEAD      5
+#define ZNP_FRAME_MAX_DATA      250
+#define ZNP_FRAME_MAX_LENGTH    (ZNP_FRAME_MAX_DATA + ZNP_FRAME_OVERHEAD)
+
+/* FCS of a whole frame: XOR of length, cmd0, cmd1 and data */
+inline
+uint8_t ERaZnpChecksum(const uint8_t* frame, size_t length) {
+    uint8_t fcs {0};
+    for (size_t i = 1; (i + 1) < length; ++i) {
+        fcs ^= frame[i];
+    }
+    return fcs;
+}
+
+/* Receive buffer for ZNP frames: bulk reads are appended and frames
+ * (SOF, length, cmd0, cmd1, data, FCS) are located and checked in place.
+ * Consumed bytes are reclaimed by moving the pending tail to the front.
+ */
+template <size_t N>
+class ERaZnpRing
+{
+    static_assert(N >= (2 * ZNP_FRAME_MAX_LENGTH), "Buffer must hold two frames");
+
+public:
+    ERaZnpRing()
+        : head(0)
+        , tail(0)
+        , dropped(0)
+    {}
+    ~ERaZnpRing()
+    {}
+
+    /* Append what the stream has without blocking, returns bytes read */
+    template <class S>
+    size_t fill(S& stream) {
+        int available = stream.available();
+        if (available <= 0) {
+            return 0;
+        }
+        if ((this->tail == N) || ((N - this->tail) < (size_t)available)) {
+            this->compact();
+        }
+        size_t size = N - this->tail;
+        if ((size_t)available < size) {
+            size = (size_t)available;
+        }
+        if (!size) {
+            return 0;
+        }
+        size = stream.readBytes(this->buffer + this->tail, size);
+        this->tail += size;
+        return size;
+    }
+
+    /* Next complete frame, skipping garbage and frames with a bad FCS.
+     * The view stays valid until the next fill().
+     */
+    bool next(const uint8_t*& frame, size_t& length) {
+        while (this->tail > this->head) {
+            const uint8_t* start = this->buffer + this->head;
+            size_t pending = this->tail - this->head;
+            const uint8_t* sof = (const uint8_t*)memchr(start, ZNP_FRAME_SOF, pending);
+            if (sof == nullptr) {
+                this->drop(pending);
+                break;
+            }
+            if (sof != start) {
+                this->drop(sof - start);
+                continue;
+            }
+            if (pending < 2) {
+                break;
+            }
+            uint8_t dataLength = start[1];
+            if (dataLength > ZNP_FRAME_MAX_DATA) {
+                this->drop(1);
+                continue;
+            }
+            size_t frameLength = dataLength + ZNP_FRAME_OVERHEAD;
+            if (pending < frameLength) {
+                break;
+            }
+            if (ERaZnpChecksum(start, frameLength) != start[frameLength - 1]) {
+                this->drop(1);
+                continue;
+            }
+            frame = start;
+            length = frameLength;
+            this->head += frameLength;
+            this->reset();
+            return true;
+        }
+        this->reset();
+        return false;
+    }
+
+    /* A frame has started but is not complete yet */
+    bool isPartial() const {
+        return (this->tail > this->head);
+    }
+
+    size_t getDropped() const {
+        return this->dropped;
+    }
+
+protected:
+private:
+    void drop(size_t size) {
+        this->head += size;
+        this->dropped += size;
+    }
+
+    void reset() {
+        if (this->head == this->tail) {
+            this->head = 0;
+            this->tail = 0;
+        }
+    }
+
+    void compact() {
+        if (!this->head) {
+            return;
+        }
+        memmove(this->buffer, this->buffer + this->head, this->tail - this->head);
+        this->tail -= this->head;
+        this->head = 0;
+    }
+
+    uint8_t buffer[N];
+    size_t head;
+    size_t tail;
+    size_t dropped;
+};
+
+#endif /* INC_ERA_ZNP_RING_HPP_ */